@@ -0,0 +1,227 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief
+ * 实现了SocketMessage缓存池。缓存按容量分为若干级，释放的缓存挂回所属级别的空闲链表，
+ * 再次申请时直接复用，避免每条消息都malloc与清零。缓存池申请的每块缓存都登记在按地址分片的集合中，
+ * 归还时先查集合判断归属，不会读取外来指针之前的内存。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "buffer_pool.hpp"
+
+#include <stdint.h>
+
+#include <mutex>
+#include <unordered_set>
+
+#define LARGE_BUFFER_CLASS -1    // 超过最大一级的缓存直接malloc/free
+#define POOL_OWNER_SHARD_NUM 16  // 登记缓存地址的集合分片数，减少归还时的锁争用
+
+// 每块缓存前的头部，空闲时通过next串成链表
+typedef struct PoolBufferHeader {
+    struct PoolBufferHeader *next;
+    int32_t size_class;
+} PoolBufferHeader;
+
+// 缓存池申请、尚未还给系统的缓存地址(含空闲链表中的缓存)
+typedef struct PoolOwnerShard {
+    std::mutex lock;
+    std::unordered_set<const char *> bufs;
+} PoolOwnerShard;
+
+typedef struct PoolSizeClass {
+    std::mutex lock;
+    PoolBufferHeader *free_list;
+    size_t free_num;
+} PoolSizeClass;
+
+static PoolSizeClass pool_size_class_list[POOL_SIZE_CLASS_NUM];
+static PoolOwnerShard pool_owner_shard_list[POOL_OWNER_SHARD_NUM];
+
+/**
+ * @brief 获取缓存地址所属的分片
+ * @param  buf              缓存地址
+ * @return PoolOwnerShard& 所属的分片
+ */
+static PoolOwnerShard &owner_shard(const char *buf) {
+    // malloc返回的地址低位总是对齐的，先移去再取模
+    return pool_owner_shard_list[((uintptr_t)buf >> 4) % POOL_OWNER_SHARD_NUM];
+}
+
+/**
+ * @brief 缓存的数据区地址
+ * @param  header           缓存头部
+ * @return char* 数据区地址
+ */
+static char *buffer_data(PoolBufferHeader *header) {
+    return (char *)(header + 1);
+}
+
+/**
+ * @brief 计算某一级缓存的容量
+ * @param  size_class       缓存级别
+ * @return size_t 该级缓存的容量
+ */
+static size_t class_capacity(const int size_class) {
+    return (size_t)MIN_POOL_BUFFER_SIZE << (2 * size_class);
+}
+
+/**
+ * @brief 查找能容纳len字节的最小缓存级别
+ * @param  len              需要的容量
+ * @return int 缓存级别;如果超过最大一级，返回LARGE_BUFFER_CLASS
+ */
+static int find_size_class(const size_t len) {
+    for (int i = 0; i < POOL_SIZE_CLASS_NUM; ++i) {
+        if (len <= class_capacity(i)) return i;
+    }
+    return LARGE_BUFFER_CLASS;
+}
+
+/**
+ * @brief 从系统申请一块新的缓存
+ * @param  size_class       缓存级别
+ * @param  len              缓存容量
+ * @return PoolBufferHeader* 缓存头部;如果申请失败，返回NULL
+ */
+static PoolBufferHeader *alloc_buffer(const int size_class, const size_t len) {
+    PoolBufferHeader *header =
+        (PoolBufferHeader *)malloc(sizeof(PoolBufferHeader) + len);
+    if (header == NULL) return NULL;
+
+    header->next = NULL;
+    header->size_class = size_class;
+
+    PoolOwnerShard &shard = owner_shard(buffer_data(header));
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.bufs.insert(buffer_data(header));
+
+    return header;
+}
+
+/**
+ * @brief 将一块缓存还给系统，并取消登记
+ * @param  header           缓存头部
+ */
+static void free_buffer(PoolBufferHeader *header) {
+    PoolOwnerShard &shard = owner_shard(buffer_data(header));
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.bufs.erase(buffer_data(header));
+    }
+    free(header);
+}
+
+/**
+ * @brief 从缓存池申请一块缓存，缓存内容不做清零
+ * @param  msg              申请到的缓存，msg->len为该级缓存的实际容量(不小于len)
+ * @param  len              需要的容量
+ * @return int 如果申请成功，返回1;如果申请失败，返回-1
+ */
+int acquire_socket_message(SocketMessage *msg, const size_t len) {
+    int size_class = find_size_class(len);
+    size_t capacity = size_class == LARGE_BUFFER_CLASS
+                          ? len
+                          : class_capacity(size_class);
+    PoolBufferHeader *header = NULL;
+
+    if (size_class != LARGE_BUFFER_CLASS) {
+        PoolSizeClass &pool = pool_size_class_list[size_class];
+        std::lock_guard<std::mutex> guard(pool.lock);
+        header = pool.free_list;
+        if (header != NULL) {
+            pool.free_list = header->next;
+            --pool.free_num;
+        }
+    }
+
+    if (header == NULL) header = alloc_buffer(size_class, capacity);
+    if (header == NULL) return -1;
+
+    msg->buf = buffer_data(header);
+    msg->len = capacity;
+
+    return 1;
+}
+
+/**
+ * @brief 将缓存归还缓存池，空闲缓存过多时直接释放
+ * @param  msg              由acquire_socket_message申请的缓存，归还后被置空
+ * @return int 如果归还成功，返回1;如果该缓存不是由缓存池申请的，返回-1
+ */
+int release_socket_message(SocketMessage *msg) {
+    PoolBufferHeader *header = NULL;
+
+    if (msg->buf == NULL) return -1;
+    {
+        PoolOwnerShard &shard = owner_shard(msg->buf);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (shard.bufs.count(msg->buf) == 0) return -1;
+    }
+    header = (PoolBufferHeader *)msg->buf - 1;
+
+    msg->buf = NULL;
+    msg->len = 0;
+
+    if (header->size_class != LARGE_BUFFER_CLASS) {
+        PoolSizeClass &pool = pool_size_class_list[header->size_class];
+        std::lock_guard<std::mutex> guard(pool.lock);
+        if (pool.free_num * class_capacity(header->size_class) <
+            MAX_POOL_CACHED_BYTES) {
+            header->next = pool.free_list;
+            pool.free_list = header;
+            ++pool.free_num;
+            return 1;
+        }
+    }
+
+    free_buffer(header);
+
+    return 1;
+}
+
+/**
+ * @brief 预先向缓存池填充num块容量为len的缓存，避免运行时首次申请的开销
+ * @param  len              缓存容量
+ * @param  num              缓存数量
+ * @return int 如果填充成功，返回1;如果容量超过最大一级或申请失败，返回-1
+ */
+int reserve_socket_message_pool(const size_t len, const size_t num) {
+    int size_class = find_size_class(len);
+    if (size_class == LARGE_BUFFER_CLASS) return -1;
+
+    PoolSizeClass &pool = pool_size_class_list[size_class];
+    for (size_t i = 0; i < num; ++i) {
+        PoolBufferHeader *header =
+            alloc_buffer(size_class, class_capacity(size_class));
+        if (header == NULL) return -1;
+
+        std::lock_guard<std::mutex> guard(pool.lock);
+        header->next = pool.free_list;
+        pool.free_list = header;
+        ++pool.free_num;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 释放缓存池中所有空闲的缓存
+ * @return int 释放成功，返回1
+ */
+int clear_socket_message_pool() {
+    for (int i = 0; i < POOL_SIZE_CLASS_NUM; ++i) {
+        PoolSizeClass &pool = pool_size_class_list[i];
+        std::lock_guard<std::mutex> guard(pool.lock);
+        while (pool.free_list != NULL) {
+            PoolBufferHeader *header = pool.free_list;
+            pool.free_list = header->next;
+            free_buffer(header);
+        }
+        pool.free_num = 0;
+    }
+
+    return 1;
+}
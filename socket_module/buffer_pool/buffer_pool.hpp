@@ -0,0 +1,23 @@
+/**
+ * @file buffer_pool.hpp
+ * @brief 声名了按固定尺寸分级复用SocketMessage缓存的缓存池
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef BUFFER_POOL_HPP_
+#define BUFFER_POOL_HPP_
+
+#include "../socket_message.hpp"
+
+#define MIN_POOL_BUFFER_SIZE 64              // 最小一级缓存的容量
+#define POOL_SIZE_CLASS_NUM 8                // 64B,256B,...,1MB，每级扩大4倍
+#define MAX_POOL_CACHED_BYTES (4 * 1024 * 1024)  // 每一级最多缓存的空闲字节数
+
+int acquire_socket_message(SocketMessage *msg, const size_t len);
+int release_socket_message(SocketMessage *msg);
+int reserve_socket_message_pool(const size_t len, const size_t num);
+int clear_socket_message_pool();
+
+#endif  // BUFFER_POOL_HPP_
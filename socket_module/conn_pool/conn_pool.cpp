@@ -0,0 +1,502 @@
+/**
+ * @file conn_pool.cpp
+ * @brief
+ * 实现了tcp客户端连接池。连接池以ip地址与端口或域套接字地址为键，每个连接池的后台线程负责建立连接、
+ * 检查空闲连接并按指数退避重连，发送路径上只从池中取出已建立的连接，不再等待握手。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "conn_pool.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../socket_log/socket_log.hpp"
+#include "../socket_transport/socket_address.hpp"
+
+typedef std::chrono::steady_clock ConnPoolClock;
+
+typedef struct ConnPool {
+    std::string key;
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+    size_t conn_num;           // 期望保持的连接数
+    size_t live_num;           // 空闲、借出与正在建立的连接总数
+    std::deque<int> idle_fds;  // 空闲连接，最近归还的在队头
+    int backoff_ms;            // 下一次重连失败后的等待时间
+    ConnPoolClock::time_point next_retry;
+    std::thread worker;                      // 负责检查与重连的后台线程
+    std::condition_variable reconnect_cond;  // 有连接需要补齐或关闭时通知
+    bool closing;
+    bool worker_stopped;  // 后台线程已被回收，此后才能释放连接池
+} ConnPool;
+
+// 未关闭的连接池在进程退出时后台线程仍在运行，它用到的锁与条件变量不参与静态析构
+static std::mutex &conn_pool_lock = *new std::mutex;
+static std::condition_variable &conn_ready_cond =
+    *new std::condition_variable;  // 有连接归还或建立时通知
+static std::map<std::string, ConnPool *> conn_pool_list;
+static std::map<int, ConnPool *> leased_conn_list;
+
+/**
+ * @brief 生成ip连接池的键
+ * @param  ip_addr          服务端ip地址
+ * @param  port             服务端端口
+ * @return std::string 连接池的键
+ */
+static std::string make_ip_key(const char *const ip_addr, const uint port) {
+    return std::string("ip:") + ip_addr + ":" + std::to_string(port);
+}
+
+/**
+ * @brief 生成域套接字连接池的键
+ * @param  socket_addr      域套接字地址
+ * @return std::string 连接池的键
+ */
+static std::string make_domain_key(const char *const socket_addr) {
+    return std::string("unix:") + socket_addr;
+}
+
+/**
+ * @brief 以非阻塞方式建立一个连接，超时后放弃，避免不可达的地址阻塞后台线程
+ * @param  addr             服务端地址
+ * @param  addr_len         服务端地址长度
+ * @return int 如果连接成功，返回阻塞模式的socket_fd;如果连接失败，返回-1
+ */
+static int connect_pool_conn(const struct sockaddr_storage *addr,
+                             const socklen_t addr_len) {
+    int on = 1;
+    int err = 0;
+    socklen_t err_len = sizeof(err);
+    struct pollfd pfd;
+    int socket_fd =
+        socket(addr->ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socket_fd < 0) return -1;
+
+    // 由内核探测长时间空闲的连接是否仍然可用
+    setsockopt(socket_fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+    if (addr->ss_family == AF_INET) {
+        setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+
+    if (connect(socket_fd, (const struct sockaddr *)addr, addr_len) < 0) {
+        if (errno != EINPROGRESS) {
+            close(socket_fd);
+            return -1;
+        }
+
+        pfd.fd = socket_fd;
+        pfd.events = POLLOUT;
+        if (poll(&pfd, 1, CONN_POOL_CONNECT_TIMEOUT_MS) <= 0 ||
+            getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &err, &err_len) < 0 ||
+            err != 0) {
+            close(socket_fd);
+            return -1;
+        }
+    }
+
+    fcntl(socket_fd, F_SETFL, fcntl(socket_fd, F_GETFL) & ~O_NONBLOCK);
+
+    return socket_fd;
+}
+
+/**
+ * @brief 检查连接是否仍然可用，只窥探不取走数据
+ * @param  socket_fd        需要检查的连接
+ * @return bool 如果连接可用，返回true;如果对端已关闭或连接出错，返回false
+ */
+static bool check_pool_conn(const int socket_fd) {
+    char c = 0;
+    ssize_t ret = recv(socket_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (ret == 0) return false;
+    if (ret < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    return true;
+}
+
+/**
+ * @brief 释放已关闭且不再有连接的连接池，需要持有conn_pool_lock
+ * @param  pool             连接池
+ */
+static void free_pool_if_idle(ConnPool *pool) {
+    if (pool->closing && pool->worker_stopped && pool->live_num == 0) {
+        delete pool;
+    }
+}
+
+/**
+ * @brief 丢弃连接池中的一个连接，需要持有conn_pool_lock
+ * @param  pool             连接所属的连接池，关闭中且不再有连接时被释放
+ * @param  socket_fd        需要关闭的连接;为-1时只减少计数
+ */
+static void drop_pool_conn(ConnPool *pool, const int socket_fd) {
+    if (socket_fd >= 0) close(socket_fd);
+    --pool->live_num;
+
+    if (pool->closing) {
+        free_pool_if_idle(pool);
+    } else {
+        pool->reconnect_cond.notify_one();
+    }
+}
+
+/**
+ * @brief 将新建立的连接放入连接池，需要持有conn_pool_lock
+ * @param  pool             连接池
+ * @param  socket_fd        新建立的连接;为-1时表示连接失败，推迟下一次重连
+ * @return int 如果放入成功，返回1;如果连接失败或连接池已关闭，返回-1
+ */
+static int add_pool_conn(ConnPool *pool, const int socket_fd) {
+    if (socket_fd < 0) {
+        pool->next_retry = ConnPoolClock::now() +
+                           std::chrono::milliseconds(pool->backoff_ms);
+        pool->backoff_ms *= 2;
+        if (pool->backoff_ms > MAX_RECONNECT_BACKOFF_MS) {
+            pool->backoff_ms = MAX_RECONNECT_BACKOFF_MS;
+        }
+        drop_pool_conn(pool, -1);
+        return -1;
+    }
+
+    if (pool->closing) {
+        drop_pool_conn(pool, socket_fd);
+        return -1;
+    }
+
+    pool->backoff_ms = MIN_RECONNECT_BACKOFF_MS;
+    pool->idle_fds.push_front(socket_fd);
+    conn_ready_cond.notify_all();
+
+    return 1;
+}
+
+/**
+ * @brief 检查连接池的空闲连接，丢弃已失效的连接，需要持有conn_pool_lock
+ * @param  pool             连接池
+ */
+static void check_idle_conns(ConnPool *pool) {
+    std::deque<int>::iterator fd_it = pool->idle_fds.begin();
+    while (fd_it != pool->idle_fds.end()) {
+        if (check_pool_conn(*fd_it)) {
+            ++fd_it;
+            continue;
+        }
+        SOCKET_LOG_WARN("Pool connection %s lost!", pool->key.c_str());
+        int socket_fd = *fd_it;
+        fd_it = pool->idle_fds.erase(fd_it);
+        drop_pool_conn(pool, socket_fd);
+    }
+}
+
+/**
+ * @brief 后台线程的入口，周期性检查空闲连接，并在连接数不足时补齐，连接池关闭后退出
+ * @param  pool             所属的连接池，在该线程被回收前不会被释放
+ */
+static void run_reconnect_worker(ConnPool *pool) {
+    std::unique_lock<std::mutex> guard(conn_pool_lock);
+    ConnPoolClock::time_point next_check =
+        ConnPoolClock::now() +
+        std::chrono::milliseconds(CONN_POOL_CHECK_INTERVAL_MS);
+
+    while (!pool->closing) {
+        ConnPoolClock::time_point now = ConnPoolClock::now();
+        ConnPoolClock::time_point deadline = next_check;
+
+        if (now >= next_check) {
+            check_idle_conns(pool);
+            next_check =
+                now + std::chrono::milliseconds(CONN_POOL_CHECK_INTERVAL_MS);
+            deadline = next_check;
+        }
+
+        if (pool->live_num >= pool->conn_num || pool->next_retry > now) {
+            if (pool->live_num < pool->conn_num &&
+                pool->next_retry < deadline) {
+                deadline = pool->next_retry;
+            }
+            pool->reconnect_cond.wait_until(guard, deadline);
+            continue;
+        }
+
+        // 建立连接时不持有锁，计数先加一，避免重复补齐
+        struct sockaddr_storage addr = pool->addr;
+        socklen_t addr_len = pool->addr_len;
+        ++pool->live_num;
+        guard.unlock();
+        int socket_fd = connect_pool_conn(&addr, addr_len);
+        guard.lock();
+
+        if (socket_fd < 0) {
+            SOCKET_LOG_WARN("Pool connect %s...failed!", pool->key.c_str());
+        } else {
+            SOCKET_LOG_INFO("Pool connect %s...success!", pool->key.c_str());
+        }
+        add_pool_conn(pool, socket_fd);
+    }
+}
+
+/**
+ * @brief 创建一个连接池，并同步建立第一批连接，失败的部分交由后台线程重连
+ * @param  key              连接池的键
+ * @param  addr             服务端地址
+ * @param  addr_len         服务端地址长度
+ * @param  conn_num         期望保持的连接数
+ * @return int 如果创建成功，返回已建立的连接数;如果连接池已存在或参数错误，返回-1
+ */
+static int init_conn_pool(const std::string &key,
+                          const struct sockaddr_storage *addr,
+                          const socklen_t addr_len, const size_t conn_num) {
+    std::unique_lock<std::mutex> guard(conn_pool_lock);
+    int ready_num = 0;
+
+    if (conn_num == 0 || conn_pool_list.count(key) > 0) return -1;
+
+    ConnPool *pool = new ConnPool;
+    pool->key = key;
+    pool->addr = *addr;
+    pool->addr_len = addr_len;
+    pool->conn_num = conn_num;
+    pool->live_num = 0;
+    pool->backoff_ms = MIN_RECONNECT_BACKOFF_MS;
+    pool->next_retry = ConnPoolClock::now();
+    pool->closing = false;
+    pool->worker_stopped = false;
+    conn_pool_list[key] = pool;
+    pool->worker = std::thread(run_reconnect_worker, pool);
+
+    // 后台线程可能同时在补齐连接，以live_num为准
+    while (pool->live_num < pool->conn_num) {
+        ++pool->live_num;
+        guard.unlock();
+        int socket_fd = connect_pool_conn(addr, addr_len);
+        guard.lock();
+
+        // 连接池关闭后可能在add_pool_conn中被释放，之后不再访问pool
+        bool closing = pool->closing;
+        if (add_pool_conn(pool, socket_fd) < 0) {
+            if (closing) ready_num = -1;
+            break;
+        }
+        ++ready_num;
+    }
+    SOCKET_LOG_INFO("Pool connect %s...%d/%zu ready!", key.c_str(), ready_num,
+                    conn_num);
+    if (ready_num >= 0) pool->reconnect_cond.notify_one();
+
+    return ready_num;
+}
+
+/**
+ * @brief 从连接池中取出一个可用的连接，不会在调用线程中建立连接
+ * @param  key              连接池的键
+ * @param  timeout_ms       没有空闲连接时的最长等待时间;小于0时一直等待
+ * @return int 如果取出成功，返回连接的socket_fd;如果连接池不存在或等待超时，返回-1
+ */
+static int acquire_conn(const std::string &key, const int timeout_ms) {
+    std::unique_lock<std::mutex> guard(conn_pool_lock);
+    ConnPoolClock::time_point deadline =
+        ConnPoolClock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (1) {
+        // 等待期间连接池可能被关闭，每次都重新查找
+        std::map<std::string, ConnPool *>::iterator it =
+            conn_pool_list.find(key);
+        if (it == conn_pool_list.end()) return -1;
+        ConnPool *pool = it->second;
+
+        while (!pool->idle_fds.empty()) {
+            int socket_fd = pool->idle_fds.front();
+            pool->idle_fds.pop_front();
+            if (check_pool_conn(socket_fd)) {
+                leased_conn_list[socket_fd] = pool;
+                return socket_fd;
+            }
+            drop_pool_conn(pool, socket_fd);
+        }
+
+        if (timeout_ms < 0) {
+            conn_ready_cond.wait(guard);
+        } else if (conn_ready_cond.wait_until(guard, deadline) ==
+                   std::cv_status::timeout) {
+            return -1;
+        }
+    }
+}
+
+/**
+ * @brief 关闭一个连接池并回收其后台线程，借出的连接在归还时关闭
+ * @param  key              连接池的键
+ * @return int 如果关闭成功，返回1;如果连接池不存在，返回-1
+ */
+static int close_conn_pool(const std::string &key) {
+    std::unique_lock<std::mutex> guard(conn_pool_lock);
+    std::map<std::string, ConnPool *>::iterator it = conn_pool_list.find(key);
+    if (it == conn_pool_list.end()) return -1;
+
+    ConnPool *pool = it->second;
+    conn_pool_list.erase(it);
+    pool->closing = true;
+    while (!pool->idle_fds.empty()) {
+        close(pool->idle_fds.front());
+        pool->idle_fds.pop_front();
+        --pool->live_num;
+    }
+    pool->reconnect_cond.notify_all();
+    conn_ready_cond.notify_all();
+
+    // 后台线程可能正在建立连接，回收时不持有锁
+    std::thread worker = std::move(pool->worker);
+    guard.unlock();
+    worker.join();
+    guard.lock();
+
+    pool->worker_stopped = true;
+    free_pool_if_idle(pool);
+
+    return 1;
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 初始化一个tcp ip连接池
+ * @param  ip_addr          服务端ip地址
+ * @param  port             服务端端口
+ * @param  conn_num         期望保持的连接数
+ * @return int 如果初始化成功，返回已建立的连接数(其余由后台重连);如果初始化失败，返回-1
+ */
+int init_tcp_ip_conn_pool(const char *const ip_addr, const uint port,
+                          const size_t conn_num) {
+    struct sockaddr_storage addr;
+    struct sockaddr_in *server_addr = (struct sockaddr_in *)&addr;
+
+    bzero(&addr, sizeof(addr));
+    server_addr->sin_family = AF_INET;
+    server_addr->sin_port = htons(port);
+    if (inet_pton(AF_INET, ip_addr, &server_addr->sin_addr) != 1) return -1;
+
+    return init_conn_pool(make_ip_key(ip_addr, port), &addr,
+                          sizeof(struct sockaddr_in), conn_num);
+}
+
+/**
+ * @brief 初始化一个tcp域套接字连接池
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
+ * @param  conn_num         期望保持的连接数
+ * @return int 如果初始化成功，返回已建立的连接数(其余由后台重连);如果初始化失败，返回-1
+ */
+int init_tcp_domain_conn_pool(const char *const socket_addr,
+                              const size_t conn_num) {
+    struct sockaddr_storage addr;
+    socklen_t addr_len = SocketAddressTraits<AF_UNIX>::fill(
+        (struct sockaddr_un *)&addr, socket_addr, 0);
+
+    if (addr_len == 0) return -1;
+
+    return init_conn_pool(make_domain_key(socket_addr), &addr, addr_len,
+                          conn_num);
+}
+
+/**
+ * @brief 从tcp ip连接池中取出一个连接，用完后需要调用release_pooled_conn归还
+ * @param  ip_addr          服务端ip地址
+ * @param  port             服务端端口
+ * @param  timeout_ms       没有空闲连接时的最长等待时间;小于0时一直等待
+ * @return int 如果取出成功，返回连接的socket_fd;如果取出失败，返回-1
+ */
+int acquire_tcp_ip_conn(const char *const ip_addr, const uint port,
+                        const int timeout_ms) {
+    return acquire_conn(make_ip_key(ip_addr, port), timeout_ms);
+}
+
+/**
+ * @brief 从tcp域套接字连接池中取出一个连接，用完后需要调用release_pooled_conn归还
+ * @param  socket_addr      域套接字地址
+ * @param  timeout_ms       没有空闲连接时的最长等待时间;小于0时一直等待
+ * @return int 如果取出成功，返回连接的socket_fd;如果取出失败，返回-1
+ */
+int acquire_tcp_domain_conn(const char *const socket_addr,
+                            const int timeout_ms) {
+    return acquire_conn(make_domain_key(socket_addr), timeout_ms);
+}
+
+/**
+ * @brief 归还一个连接
+ * @param  socket_fd        由acquire_*_conn取出的连接
+ * @param  broken
+ * 连接是否已经失效(如发送失败);失效的连接被关闭，并由后台线程重新补齐
+ * @return int 如果归还成功，返回1;如果该连接不是由连接池取出的，返回-1
+ */
+int release_pooled_conn(const int socket_fd, const bool broken) {
+    std::lock_guard<std::mutex> guard(conn_pool_lock);
+    std::map<int, ConnPool *>::iterator it = leased_conn_list.find(socket_fd);
+    if (it == leased_conn_list.end()) return -1;
+
+    ConnPool *pool = it->second;
+    leased_conn_list.erase(it);
+    if (broken || pool->closing) {
+        drop_pool_conn(pool, socket_fd);
+    } else {
+        pool->idle_fds.push_front(socket_fd);
+        conn_ready_cond.notify_all();
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 关闭一个tcp ip连接池
+ * @param  ip_addr          服务端ip地址
+ * @param  port             服务端端口
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_tcp_ip_conn_pool(const char *const ip_addr, const uint port) {
+    return close_conn_pool(make_ip_key(ip_addr, port));
+}
+
+/**
+ * @brief 关闭一个tcp域套接字连接池
+ * @param  socket_addr      域套接字地址
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_tcp_domain_conn_pool(const char *const socket_addr) {
+    return close_conn_pool(make_domain_key(socket_addr));
+}
+
+/**
+ * @brief 关闭所有连接池，并回收它们的后台线程
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_all_conn_pool() {
+    std::map<std::string, ConnPool *> pools;
+    {
+        std::lock_guard<std::mutex> guard(conn_pool_lock);
+        pools = conn_pool_list;
+    }
+
+    std::map<std::string, ConnPool *>::iterator it;
+    for (it = pools.begin(); it != pools.end(); ++it) {
+        close_conn_pool(it->first);
+    }
+
+    return 1;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file conn_pool.hpp
+ * @brief 声名了按地址复用的tcp客户端连接池，连接由后台线程建立、检查与重连
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef CONN_POOL_HPP_
+#define CONN_POOL_HPP_
+
+#include <sys/types.h>
+
+#include <cstddef>
+
+#define DEFAULT_CONN_POOL_SIZE 4
+#define DEFAULT_CONN_ACQUIRE_TIMEOUT_MS 1000
+#define CONN_POOL_CONNECT_TIMEOUT_MS 1000
+#define CONN_POOL_CHECK_INTERVAL_MS 1000  // 空闲连接的检查周期
+#define MIN_RECONNECT_BACKOFF_MS 10
+#define MAX_RECONNECT_BACKOFF_MS 5000
+
+int init_tcp_ip_conn_pool(const char *const ip_addr, const uint port,
+                          const size_t conn_num = DEFAULT_CONN_POOL_SIZE);
+int init_tcp_domain_conn_pool(const char *const socket_addr,
+                              const size_t conn_num = DEFAULT_CONN_POOL_SIZE);
+int acquire_tcp_ip_conn(
+    const char *const ip_addr, const uint port,
+    const int timeout_ms = DEFAULT_CONN_ACQUIRE_TIMEOUT_MS);
+int acquire_tcp_domain_conn(
+    const char *const socket_addr,
+    const int timeout_ms = DEFAULT_CONN_ACQUIRE_TIMEOUT_MS);
+int release_pooled_conn(const int socket_fd, const bool broken = false);
+int close_tcp_ip_conn_pool(const char *const ip_addr, const uint port);
+int close_tcp_domain_conn_pool(const char *const socket_addr);
+int close_all_conn_pool();
+
+#endif  // CONN_POOL_HPP_
@@ -0,0 +1,365 @@
+/**
+ * @file coro_socket.cpp
+ * @brief
+ * 实现了基于C++20协程的异步套接字。收发先以MSG_DONTWAIT尝试，遇到EAGAIN时以EPOLLONESHOT注册并挂起协程，
+ * 事件到达后由取得该事件的reactor线程恢复协程，多个线程运行同一个reactor时每个事件只会被一个线程处理。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "coro_socket.hpp"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_log/socket_log.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+
+/**
+ * @brief 判断收发失败是否只是暂时没有数据或缓存空间
+ * @return bool 如果应当挂起等待，返回true
+ */
+static bool should_wait() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 登记等待的协程并向epoll注册对应方向的事件
+ * @param  handle           需要挂起的协程
+ * @return bool
+ * 如果注册成功，返回true并挂起协程;如果套接字已关闭或注册失败，返回false并立即恢复协程
+ */
+bool CoroSocket::WaitAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    State *state = socket->state_.get();
+    if (state == NULL) {
+        errno = EBADF;
+        ret = -1;
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(state->lock);
+
+    this->handle = handle;
+    if (events & EPOLLIN) {
+        state->reader = this;
+    } else {
+        state->writer = this;
+    }
+    ret = update_state(state);
+    if (ret > 0) return true;
+
+    if (events & EPOLLIN) {
+        state->reader = nullptr;
+    } else {
+        state->writer = nullptr;
+    }
+    return false;
+}
+
+CoroSocket::CoroSocket() : state_(), close_func_(::close) {}
+
+/**
+ * @brief 接管一个套接字并设为非阻塞模式
+ * @param  reactor          恢复协程的reactor
+ * @param  socket_fd        套接字的socket_fd，小于0时得到一个空套接字
+ * @param  close_func       关闭套接字的函数，由init_*创建的套接字应传入对应的close_*函数
+ */
+CoroSocket::CoroSocket(CoroReactor *reactor, const int socket_fd,
+                       CloseFunc close_func)
+    : state_(), close_func_(close_func) {
+    if (socket_fd < 0) return;
+
+    set_socket_nonblocking(socket_fd, true);
+    state_.reset(new State());
+    state_->reactor = reactor;
+    state_->socket_fd = socket_fd;
+    state_->added = false;
+    state_->closed = false;
+    state_->reader = NULL;
+    state_->writer = NULL;
+}
+
+CoroSocket::CoroSocket(CoroSocket &&other) noexcept
+    : state_(std::move(other.state_)), close_func_(other.close_func_) {}
+
+CoroSocket &CoroSocket::operator=(CoroSocket &&other) noexcept {
+    if (this != &other) {
+        close();
+        state_ = std::move(other.state_);
+        close_func_ = other.close_func_;
+    }
+    return *this;
+}
+
+CoroSocket::~CoroSocket() { close(); }
+
+int CoroSocket::get() const { return state_ ? state_->socket_fd : -1; }
+
+CoroReactor *CoroSocket::reactor() const {
+    return state_ ? state_->reactor : NULL;
+}
+
+CoroSocket::operator bool() const { return state_ != nullptr; }
+
+/**
+ * @brief 从epoll注销并关闭套接字，仍在等待的协程在调用线程上以-1恢复，errno为ECANCELED
+ * @return int 如果关闭成功，返回1;如果是空套接字或关闭失败，返回-1
+ */
+int CoroSocket::close() {
+    if (!state_) return -1;
+
+    std::shared_ptr<State> state = std::move(state_);
+    WaitAwaiter *reader = NULL, *writer = NULL;
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (state->added) {
+            epoll_ctl(state->reactor->epoll_fd(), EPOLL_CTL_DEL,
+                      state->socket_fd, NULL);
+        }
+        state->closed = true;
+        reader = std::exchange(state->reader, nullptr);
+        writer = std::exchange(state->writer, nullptr);
+    }
+    int ret = close_func_(state->socket_fd);
+    int err = errno;
+
+    if (reader) cancel_waiter(reader);
+    if (writer) cancel_waiter(writer);
+    errno = err;
+
+    return ret < 0 ? -1 : 1;
+}
+
+CoroSocket::WaitAwaiter CoroSocket::readable() {
+    return WaitAwaiter{this, EPOLLIN, 1};
+}
+
+CoroSocket::WaitAwaiter CoroSocket::writable() {
+    return WaitAwaiter{this, EPOLLOUT, 1};
+}
+
+/**
+ * @brief 按仍在等待的方向重新注册事件，调用时需持有state->lock
+ * @param  state            套接字的等待状态
+ * @return int 如果注册成功，返回1;如果注册失败，返回-1
+ */
+int CoroSocket::update_state(State *state) {
+    struct epoll_event event;
+    event.events = EPOLLONESHOT;
+    if (state->reader) event.events |= EPOLLIN | EPOLLRDHUP;
+    if (state->writer) event.events |= EPOLLOUT;
+    event.data.ptr = state;
+
+    int op = state->added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(state->reactor->epoll_fd(), op, state->socket_fd, &event) <
+        0) {
+        SOCKET_LOG_ERROR("Register coroutine socket %d...failed!",
+                         state->socket_fd);
+        return -1;
+    }
+    state->added = true;
+
+    return 1;
+}
+
+/**
+ * @brief 以-1恢复一个因套接字关闭而不会再收到事件的协程
+ * @param  waiter           等待中的协程
+ */
+void CoroSocket::cancel_waiter(WaitAwaiter *waiter) {
+    waiter->ret = -1;
+    errno = ECANCELED;
+    waiter->handle.resume();
+}
+
+/**
+ * @brief 取出就绪方向上等待的协程并恢复，另一方向仍在等待时重新注册
+ * @param  state            套接字的等待状态
+ * @param  events           epoll返回的事件
+ */
+void CoroSocket::dispatch_state(State *state, const uint32_t events) {
+    // 读协程恢复后可能关闭套接字，持有一份引用使state在本次分发中保持有效
+    std::shared_ptr<State> keep = state->shared_from_this();
+    WaitAwaiter *reader = NULL, *writer = NULL;
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (events & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP)) {
+            reader = std::exchange(state->reader, nullptr);
+        }
+        if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+            writer = std::exchange(state->writer, nullptr);
+        }
+        // EPOLLONESHOT触发后事件已被禁用
+        if (state->reader || state->writer) update_state(state);
+    }
+
+    if (reader) reader->handle.resume();
+    if (writer == NULL) return;
+
+    // 写协程已被取出，关闭时取消不到它，在这里按取消恢复
+    bool closed = false;
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        closed = state->closed;
+    }
+    if (closed) {
+        cancel_waiter(writer);
+    } else {
+        writer->handle.resume();
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+
+CoroReactor::CoroReactor() : epoll_fd_(-1), wake_fd_(-1), running_(true) {
+    struct epoll_event event;
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        SOCKET_LOG_ERROR("Create coroutine reactor...failed!");
+        return;
+    }
+
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+}
+
+CoroReactor::~CoroReactor() {
+    if (wake_fd_ >= 0) ::close(wake_fd_);
+    if (epoll_fd_ >= 0) ::close(epoll_fd_);
+}
+
+/**
+ * @brief 在调用线程上处理事件并恢复协程，直到stop被调用;多个线程可以同时调用
+ * @return int 如果正常退出，返回1;如果epoll_wait失败，返回-1
+ */
+int CoroReactor::run() {
+    struct epoll_event events[MAX_CORO_EVENT_NUM];
+
+    if (epoll_fd_ < 0) return -1;
+
+    while (running_.load(std::memory_order_acquire)) {
+        int num = epoll_wait(epoll_fd_, events, MAX_CORO_EVENT_NUM, -1);
+        if (num < 0) {
+            if (errno == EINTR) continue;
+            SOCKET_LOG_ERROR("Coroutine reactor epoll_wait...failed!");
+            return -1;
+        }
+
+        for (int i = 0; i < num; ++i) {
+            if (events[i].data.ptr == NULL) continue;
+            CoroSocket::dispatch_state(
+                (CoroSocket::State *)events[i].data.ptr, events[i].events);
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 通知所有运行run的线程退出，仍在等待的协程不会被恢复
+ * @return int 如果通知成功，返回1;如果通知失败，返回-1
+ */
+int CoroReactor::stop() {
+    uint64_t one = 1;
+
+    running_.store(false, std::memory_order_release);
+    // eventfd保持可读，所有阻塞在epoll_wait中的线程都会被唤醒
+    return write(wake_fd_, &one, sizeof(one)) == sizeof(one) ? 1 : -1;
+}
+
+///////////////////////////////////////////////////////////////////
+
+// 立即开始执行、结束时自行销毁的协程，用于启动顶层任务
+struct CoroDetached {
+    struct promise_type {
+        CoroDetached get_return_object() { return CoroDetached(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static CoroDetached run_detached(CoroTask<void> task) { co_await task; }
+
+/**
+ * @brief 在调用线程上启动一个顶层协程，协程挂起后由reactor的线程继续执行
+ * @param  task             需要启动的协程任务，结束后自动释放
+ */
+void spawn_coro_task(CoroTask<void> task) { run_detached(std::move(task)); }
+
+/**
+ * @brief 异步接受一个新连接
+ * @param  listener         监听套接字
+ * @return CoroTask<CoroSocket>
+ * 如果接受成功，返回新连接(与监听套接字使用同一个reactor);如果接受失败，返回空套接字
+ */
+CoroTask<CoroSocket> async_accept(CoroSocket &listener) {
+    while (1) {
+        int accept_fd = accept4(listener.get(), NULL, NULL,
+                                SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (accept_fd >= 0) {
+            co_return CoroSocket(listener.reactor(), accept_fd);
+        }
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (!should_wait() || co_await listener.readable() < 0) {
+            co_return CoroSocket();
+        }
+    }
+}
+
+/**
+ * @brief 异步接收数据，没有数据时挂起而不阻塞线程
+ * @param  socket           已连接的流式套接字
+ * @param  msg              数据缓存的指针
+ * @return CoroTask<int>
+ * 如果接收成功，返回接收的字节数;如果对端关闭，返回0;如果接收失败，返回-1
+ */
+CoroTask<int> async_recv(CoroSocket &socket, const SocketMessage *msg) {
+    uint64_t start_ns = start_socket_metrics_clock();
+
+    while (1) {
+        ssize_t ret = recv(socket.get(), msg->buf, msg->len, MSG_DONTWAIT);
+        record_socket_syscall(socket.get(), SOCKET_METRICS_RECV, ret,
+                              msg->len);
+        if (ret > 0) {
+            record_socket_msg(socket.get(), SOCKET_METRICS_RECV, 1, start_ns);
+        }
+        if (ret >= 0) co_return (int)ret;
+        if (errno == EINTR) continue;
+        if (!should_wait() || co_await socket.readable() < 0) co_return -1;
+    }
+}
+
+/**
+ * @brief 异步发出全部数据，发送缓存已满时挂起而不阻塞线程
+ * @param  socket           已连接的流式套接字
+ * @param  msg              需要发送数据的指针
+ * @return CoroTask<int> 如果全部发出，返回发送的字节数;如果发送失败，返回-1
+ */
+CoroTask<int> async_send(CoroSocket &socket, const SocketMessage *msg) {
+    uint64_t start_ns = start_socket_metrics_clock();
+    size_t sent = 0;
+
+    while (sent < msg->len) {
+        ssize_t ret = send(socket.get(), msg->buf + sent, msg->len - sent,
+                           MSG_DONTWAIT | MSG_NOSIGNAL);
+        record_socket_syscall(socket.get(), SOCKET_METRICS_SEND, ret,
+                              msg->len - sent);
+        if (ret >= 0) {
+            sent += ret;
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (!should_wait() || co_await socket.writable() < 0) co_return -1;
+    }
+    record_socket_msg(socket.get(), SOCKET_METRICS_SEND, 1, start_ns);
+
+    co_return (int)sent;
+}
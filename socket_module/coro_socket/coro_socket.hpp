@@ -0,0 +1,227 @@
+/**
+ * @file coro_socket.hpp
+ * @brief 声名了基于C++20协程的异步套接字接口，连接处理函数可以写成顺序执行的协程
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef CORO_SOCKET_HPP_
+#define CORO_SOCKET_HPP_
+
+#include <unistd.h>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "../socket_message.hpp"
+
+#define MAX_CORO_EVENT_NUM 256  // 单次epoll_wait最多处理的事件数量
+
+class CoroReactor;
+
+///////////////////////////////////////////////////////////////////
+
+namespace coro_detail {
+
+// 协程结束时切换回等待它的协程，没有等待者时直接返回
+struct FinalAwaiter {
+    bool await_ready() noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<Promise> handle) noexcept {
+        std::coroutine_handle<> next = handle.promise().continuation;
+        return next ? next : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { std::terminate(); }
+};
+
+}  // namespace coro_detail
+
+/**
+ * @brief 惰性启动的协程任务，被co_await时才开始执行，结束后切换回等待者
+ * @tparam T 协程的返回值类型
+ */
+template <typename T>
+class CoroTask {
+   public:
+    struct promise_type : coro_detail::PromiseBase {
+        std::optional<T> value;
+
+        CoroTask get_return_object() {
+            return CoroTask(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        void return_value(T v) { value.emplace(std::move(v)); }
+    };
+
+    CoroTask(CoroTask &&other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoroTask &operator=(CoroTask &&other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    CoroTask(const CoroTask &) = delete;
+    CoroTask &operator=(const CoroTask &) = delete;
+    ~CoroTask() {
+        if (handle_) handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) {
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+    T await_resume() { return std::move(*handle_.promise().value); }
+
+   private:
+    explicit CoroTask(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <>
+class CoroTask<void> {
+   public:
+    struct promise_type : coro_detail::PromiseBase {
+        CoroTask get_return_object() {
+            return CoroTask(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        void return_void() {}
+    };
+
+    CoroTask(CoroTask &&other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoroTask &operator=(CoroTask &&other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    CoroTask(const CoroTask &) = delete;
+    CoroTask &operator=(const CoroTask &) = delete;
+    ~CoroTask() {
+        if (handle_) handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) {
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+    void await_resume() {}
+
+   private:
+    explicit CoroTask(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 交由协程使用的套接字，构造时设为非阻塞，析构时从reactor注销并关闭。
+ * 同一时刻每个方向最多只能有一个协程在等待，关闭时仍在等待的协程以-1恢复
+ */
+class CoroSocket {
+   public:
+    typedef int (*CloseFunc)(int);
+
+    // 等待套接字可读或可写，co_await的结果为1;如果注册失败或套接字被关闭，结果为-1
+    struct WaitAwaiter {
+        CoroSocket *socket;
+        uint32_t events;
+        int ret;
+        std::coroutine_handle<> handle;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        int await_resume() const noexcept { return ret; }
+    };
+
+    CoroSocket();
+    CoroSocket(CoroReactor *reactor, const int socket_fd,
+               CloseFunc close_func = ::close);
+    CoroSocket(CoroSocket &&other) noexcept;
+    CoroSocket &operator=(CoroSocket &&other) noexcept;
+    CoroSocket(const CoroSocket &) = delete;
+    CoroSocket &operator=(const CoroSocket &) = delete;
+    ~CoroSocket();
+
+    int get() const;
+    CoroReactor *reactor() const;
+    explicit operator bool() const;
+    int close();
+
+    WaitAwaiter readable();
+    WaitAwaiter writable();
+
+   private:
+    friend class CoroReactor;
+
+    // 与epoll事件绑定的等待状态，地址在套接字移动后保持不变;
+    // 分发事件时另持一份引用，恢复的协程关闭套接字后仍可安全访问
+    struct State : std::enable_shared_from_this<State> {
+        std::mutex lock;
+        CoroReactor *reactor;
+        int socket_fd;
+        bool added;
+        bool closed;
+        WaitAwaiter *reader;
+        WaitAwaiter *writer;
+    };
+
+    static int update_state(State *state);
+    static void dispatch_state(State *state, const uint32_t events);
+    static void cancel_waiter(WaitAwaiter *waiter);
+
+    std::shared_ptr<State> state_;
+    CloseFunc close_func_;
+};
+
+/**
+ * @brief epoll驱动的协程调度器，可由一个或多个线程同时调用run
+ */
+class CoroReactor {
+   public:
+    CoroReactor();
+    ~CoroReactor();
+    CoroReactor(const CoroReactor &) = delete;
+    CoroReactor &operator=(const CoroReactor &) = delete;
+
+    int run();
+    int stop();
+    int epoll_fd() const { return epoll_fd_; }
+
+   private:
+    int epoll_fd_;
+    int wake_fd_;
+    std::atomic<bool> running_;
+};
+
+void spawn_coro_task(CoroTask<void> task);
+CoroTask<CoroSocket> async_accept(CoroSocket &listener);
+CoroTask<int> async_recv(CoroSocket &socket, const SocketMessage *msg);
+CoroTask<int> async_send(CoroSocket &socket, const SocketMessage *msg);
+
+#endif  // CORO_SOCKET_HPP_
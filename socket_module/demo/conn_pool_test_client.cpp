@@ -0,0 +1,49 @@
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../conn_pool/conn_pool.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1234
+#define BUFFER_SIZE_ 10240
+#define POOL_SIZE_ 2
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    int ret = 0;
+    int conn_fd = 0;
+    int send_num = argc > 1 ? atoi(argv[1]) : 10;
+    SocketMessage msg;
+    acquire_socket_message(&msg, BUFFER_SIZE_);
+
+    cout << "TCP IP Connection Pool Test." << endl;
+    ret = init_tcp_ip_conn_pool(SERVER_ADDR_, SERVER_PORT_, POOL_SIZE_);
+    cout << "(" << ret << ")" << endl;
+
+    for (int i = 0; i < send_num; i++) {
+        conn_fd = acquire_tcp_ip_conn(SERVER_ADDR_, SERVER_PORT_);
+        if (conn_fd < 0) {
+            cout << "(" << conn_fd << ")No connection available." << endl;
+            continue;
+        }
+
+        snprintf(msg.buf, msg.len, "pooled message %d", i);
+        SocketMessage payload = {msg.buf, strlen(msg.buf)};
+        ret = send_tcp_ip_msg(conn_fd, &payload);
+        cout << "[" << conn_fd << "](" << ret << ")" << msg.buf << endl;
+
+        // 发送失败的连接交还给后台线程重连
+        release_pooled_conn(conn_fd, ret < 0);
+        sleep(1);
+    }
+
+    ret = close_all_conn_pool();
+    cout << "(" << ret << ")" << endl;
+    release_socket_message(&msg);
+    return 0;
+}
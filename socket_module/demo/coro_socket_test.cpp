@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../coro_socket/coro_socket.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1248
+#define CONN_NUM_ 400
+#define ROUND_NUM_ 100
+#define MSG_SIZE_ 64
+#define THREAD_NUM_ 2
+
+using namespace std;
+
+static atomic<int> finished_num(0);
+static atomic<int> failed_num(0);
+
+// 每个连接一个回显协程，直到对端关闭
+CoroTask<void> echo_conn(CoroSocket conn) {
+    char buf[MSG_SIZE_];
+    SocketMessage msg = {buf, sizeof(buf)};
+
+    while (1) {
+        int ret = co_await async_recv(conn, &msg);
+        if (ret <= 0) break;
+        SocketMessage reply = {buf, (size_t)ret};
+        if (co_await async_send(conn, &reply) < 0) break;
+    }
+}
+
+CoroTask<void> accept_conns(CoroSocket* listener) {
+    for (int i = 0; i < CONN_NUM_; i++) {
+        CoroSocket conn = co_await async_accept(*listener);
+        if (!conn) break;
+        spawn_coro_task(echo_conn(std::move(conn)));
+    }
+}
+
+// 客户端协程依次发送ROUND_NUM_条消息并等待完整的回显
+CoroTask<void> run_client(CoroReactor* reactor) {
+    char send_buf[MSG_SIZE_], recv_buf[MSG_SIZE_];
+    SocketMessage msg = {send_buf, sizeof(send_buf)};
+    bool ok = true;
+
+    memset(send_buf, 'x', sizeof(send_buf));
+    CoroSocket conn(reactor, init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_),
+                    close_tcp_ip_client);
+
+    for (int i = 0; conn && ok && i < ROUND_NUM_; i++) {
+        ok = co_await async_send(conn, &msg) == MSG_SIZE_;
+        size_t received = 0;
+        while (ok && received < MSG_SIZE_) {
+            SocketMessage part = {recv_buf + received, MSG_SIZE_ - received};
+            int ret = co_await async_recv(conn, &part);
+            ok = ret > 0;
+            if (ok) received += ret;
+        }
+    }
+
+    if (!conn || !ok) failed_num++;
+    if (++finished_num == CONN_NUM_) reactor->stop();
+}
+
+int main() {
+    CoroReactor reactor;
+    vector<thread> workers;
+
+    cout << "Coroutine Socket Test." << endl;
+    CoroSocket listener(&reactor, init_tcp_ip_server(SERVER_PORT_, CONN_NUM_),
+                        close_tcp_ip_server);
+    if (!listener) return -1;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    spawn_coro_task(accept_conns(&listener));
+    for (int i = 0; i < CONN_NUM_; i++) spawn_coro_task(run_client(&reactor));
+
+    for (int i = 0; i < THREAD_NUM_; i++) {
+        workers.push_back(thread([&reactor]() { reactor.run(); }));
+    }
+    for (int i = 0; i < THREAD_NUM_; i++) workers[i].join();
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() -
+                                              start)
+                         .count();
+    cout << CONN_NUM_ << " connections x " << ROUND_NUM_ << " round trips on "
+         << THREAD_NUM_ << " threads: " << failed_num << " failed, "
+         << elapsed << " s" << endl;
+
+    return failed_num == 0 ? 0 : -1;
+}
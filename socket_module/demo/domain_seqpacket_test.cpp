@@ -0,0 +1,99 @@
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "../domain_socket/domain_socket.hpp"
+
+#define ABSTRACT_ADDR_ "@socket_module_seqpacket_test"
+#define PATH_ADDR_ "/tmp/socket_module_seqpacket_test"
+#define MSG_NUM_ 64
+#define MAX_MSG_SIZE_ 4096
+
+using namespace std;
+
+// 发送不同长度的记录，检查每次接收恰好得到一条完整记录
+int check_boundaries(const char *socket_addr) {
+    static char send_buf[MAX_MSG_SIZE_], recv_buf[MAX_MSG_SIZE_ + 1];
+    SocketMessage msg = {send_buf, 0};
+    SocketMessage recv_msg = {recv_buf, sizeof(recv_buf)};
+    int failed_num = 0;
+
+    int server_fd = init_seqpacket_domain_server(socket_addr);
+    int client_fd = init_seqpacket_domain_client(socket_addr);
+    int accept_fd = accept(server_fd, NULL, NULL);
+    if (server_fd < 0 || client_fd < 0 || accept_fd < 0) return -1;
+
+    // 所有记录先写入再读出，边界不依赖收发的节奏
+    for (int i = 0; i < MSG_NUM_; i++) {
+        msg.len = 1 + (i * 97) % MAX_MSG_SIZE_;
+        memset(send_buf, 'a' + i % 26, msg.len);
+        if (send_seqpacket_domain_msg(client_fd, &msg) != (int)msg.len) {
+            failed_num++;
+        }
+    }
+    for (int i = 0; i < MSG_NUM_; i++) {
+        size_t len = 1 + (i * 97) % MAX_MSG_SIZE_;
+        recv_msg.len = sizeof(recv_buf);
+        int ret = recv_seqpacket_domain_msg(accept_fd, &recv_msg);
+        if (ret != (int)len || recv_buf[0] != 'a' + i % 26 ||
+            recv_buf[len - 1] != 'a' + i % 26) {
+            failed_num++;
+        }
+    }
+
+    // 超过缓存的记录被截断，并且不会污染下一条记录
+    msg.len = 128;
+    memset(send_buf, 'x', msg.len);
+    send_seqpacket_domain_msg(client_fd, &msg);
+    msg.len = 3;
+    memcpy(send_buf, "end", msg.len);
+    send_seqpacket_domain_msg(client_fd, &msg);
+    recv_msg.len = 16;
+    bool truncated = recv_seqpacket_domain_msg(accept_fd, &recv_msg) < 0 &&
+                     errno == EMSGSIZE;
+    recv_msg.len = sizeof(recv_buf);
+    bool next_intact = recv_seqpacket_domain_msg(accept_fd, &recv_msg) == 3 &&
+                       memcmp(recv_buf, "end", 3) == 0;
+
+    // 对端关闭后返回0
+    close_seqpacket_domain_client(client_fd);
+    bool closed = recv_seqpacket_domain_msg(accept_fd, &recv_msg) == 0;
+    close(accept_fd);
+    close_seqpacket_domain_server(server_fd);
+
+    cout << socket_addr << ": " << MSG_NUM_ - failed_num << " of " << MSG_NUM_
+         << " records intact, truncation " << (truncated ? "reported" : "lost")
+         << ", next record " << (next_intact ? "intact" : "corrupted")
+         << ", peer close " << (closed ? "seen" : "missed") << endl;
+
+    return failed_num == 0 && truncated && next_intact && closed ? 0 : -1;
+}
+
+int main() {
+    struct stat st;
+    int failed_num = 0;
+
+    cout << "Domain Seqpacket Test." << endl;
+    if (check_boundaries(ABSTRACT_ADDR_) < 0) failed_num++;
+
+    // 抽象地址不创建文件，关闭后可以立即在同一地址上重新启动
+    bool no_inode = stat(ABSTRACT_ADDR_ + 1, &st) < 0;
+    int server_fd = init_seqpacket_domain_server(ABSTRACT_ADDR_);
+    bool restarted = server_fd >= 0;
+    int busy_fd = init_seqpacket_domain_server(ABSTRACT_ADDR_);
+    bool in_use = busy_fd < 0 && errno == EADDRINUSE;
+    close_seqpacket_domain_server(server_fd);
+    cout << "abstract address: inode " << (no_inode ? "absent" : "present")
+         << ", restart " << (restarted ? "ok" : "failed")
+         << ", second bind " << (in_use ? "rejected" : "accepted") << endl;
+    if (!no_inode || !restarted || !in_use) failed_num++;
+
+    if (check_boundaries(PATH_ADDR_) < 0) failed_num++;
+    unlink(PATH_ADDR_);
+
+    return failed_num == 0 ? 0 : -1;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "../domain_socket/domain_socket.hpp"
+
+#define SOCKET_ADDR_ "./test_shared_msg_socket"
+#define FRAME_SIZE_ (8 * 1024 * 1024)  // 模拟一帧8MB的点云
+#define FRAME_NUM_ 10
+
+using namespace std;
+
+void consumer(int server_socket_fd) {
+    SharedMessage msg;
+    int accept_fd = accept(server_socket_fd, NULL, NULL);
+    for (int i = 0; i < FRAME_NUM_; ++i) {
+        int ret = recv_domain_shared_msg(accept_fd, &msg);
+        if (ret <= 0) break;
+        cout << "(" << ret << "):Received frame " << (int)msg.buf[0]
+             << " from remote" << endl;
+        release_domain_shared_msg(&msg);
+    }
+    close(accept_fd);
+}
+
+int main() {
+    int ret = 0;
+    int server_socket_fd = 0, client_socket_fd = 0;
+    SharedMessage msg;
+
+    cout << "Domain Socket Shared Message Test." << endl;
+    server_socket_fd = init_tcp_domain_server(SOCKET_ADDR_);
+    thread server(consumer, server_socket_fd);
+    client_socket_fd = init_tcp_domain_client(SOCKET_ADDR_);
+
+    for (int i = 0; i < FRAME_NUM_; ++i) {
+        alloc_domain_shared_msg(&msg, FRAME_SIZE_);
+        memset(msg.buf, i, msg.len);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ret = send_domain_shared_msg(client_socket_fd, &msg);
+        chrono::duration<double, micro> cost =
+            chrono::steady_clock::now() - start;
+        cout << "(" << ret << ")Send frame " << i << " in " << cost.count()
+             << " us" << endl;
+    }
+
+    server.join();
+    ret = close_tcp_domain_client(client_socket_fd);
+    ret = close_tcp_domain_server(server_socket_fd);
+    cout << "(" << ret << ")" << endl;
+    remove(SOCKET_ADDR_);
+
+    return 0;
+}
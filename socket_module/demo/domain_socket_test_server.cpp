@@ -1,7 +1,6 @@
-#include <malloc.h>
-
 #include <iostream>
 
+#include "../buffer_pool/buffer_pool.hpp"
 #include "../domain_socket/domain_socket.hpp"
 
 #define SOCKET_ADDR_ "./test_domain_socket"
@@ -13,8 +12,7 @@ int main() {
     int ret = 0;
     int server_socket_fd = 0, server_accept_fd = 0;
     SocketMessage msg;
-    msg.len = BUFFER_SIZE_;
-    msg.buf = (char*)malloc(msg.len);
+    acquire_socket_message(&msg, BUFFER_SIZE_);
 
     cout << "TCP Domain Socket Test." << endl;
     server_socket_fd = init_tcp_domain_server(SOCKET_ADDR_);
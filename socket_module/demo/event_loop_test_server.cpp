@@ -0,0 +1,57 @@
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../domain_socket/domain_socket.hpp"
+#include "../event_loop/event_loop.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_PORT_ 1234
+#define SOCKET_ADDR_ "./test_domain_socket"
+#define BUFFER_SIZE_ 10240
+
+using namespace std;
+
+int print_msg(const int accept_fd, const SocketMessage* msg,
+              void* /*user_data*/) {
+    if (msg->len == 0) {
+        cout << "[" << accept_fd << "] request has been released!" << endl;
+        return 0;
+    }
+    cout << "[" << accept_fd << "](" << msg->len
+         << "):Received messege from remote: ";
+    cout.write(msg->buf, msg->len) << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int ret = 0;
+    int server_socket_fd = 0;
+    bool use_domain = argc > 1 && string(argv[1]) == "domain";
+    SocketEventLoop loop;
+    SocketMessage msg;
+    acquire_socket_message(&msg, BUFFER_SIZE_);
+
+    if (use_domain) {
+        cout << "TCP Domain Socket Event Loop Test." << endl;
+        server_socket_fd = init_tcp_domain_server(SOCKET_ADDR_);
+    } else {
+        cout << "TCP IP Socket Event Loop Test." << endl;
+        server_socket_fd = init_tcp_ip_server(SERVER_PORT_);
+    }
+    if (server_socket_fd < 0) return -1;
+
+    init_socket_event_loop(&loop, server_socket_fd, print_msg, NULL);
+    ret = run_socket_event_loop(&loop, &msg);
+    cout << "(" << ret << ")" << endl;
+
+    close_socket_event_loop(&loop);
+    if (use_domain) {
+        ret = close_tcp_domain_server(server_socket_fd);
+    } else {
+        ret = close_tcp_ip_server(server_socket_fd);
+    }
+    cout << "(" << ret << ")" << endl;
+
+    release_socket_message(&msg);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <endian.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include <iostream>
+
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1234
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    ssize_t ret = 0;
+    int client_socket_fd = 0;
+    struct stat file_stat;
+    SocketMessage msg;
+    uint64_t file_size = 0;
+
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <file>" << endl;
+        return -1;
+    }
+
+    int file_fd = open(argv[1], O_RDONLY);
+    if (file_fd < 0 || fstat(file_fd, &file_stat) < 0) return -1;
+
+    cout << "TCP IP Socket File Transfer Test." << endl;
+    client_socket_fd = init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+
+    file_size = htobe64(file_stat.st_size);
+    msg.buf = (char*)&file_size;
+    msg.len = sizeof(file_size);
+    send_tcp_ip_msg(client_socket_fd, &msg);
+
+    ret = send_tcp_ip_file(client_socket_fd, file_fd, 0, file_stat.st_size);
+    cout << "(" << ret << ")" << argv[1] << endl;
+
+    close(file_fd);
+    ret = close_tcp_ip_client(client_socket_fd);
+    cout << "(" << ret << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <endian.h>
+#include <fcntl.h>
+#include <stdint.h>
+
+#include <iostream>
+
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_PORT_ 1234
+#define OUTPUT_FILE_ "./received_file"
+
+using namespace std;
+
+int main() {
+    ssize_t ret = 0;
+    int server_socket_fd = 0, server_accept_fd = 0;
+    uint64_t file_size = 0;
+
+    cout << "TCP IP Socket File Transfer Test." << endl;
+    server_socket_fd = init_tcp_ip_server(SERVER_PORT_);
+    server_accept_fd = accept(server_socket_fd, NULL, NULL);
+
+    // 先接收8字节的文件长度，再将文件内容直接splice到文件
+    if (recv(server_accept_fd, &file_size, sizeof(file_size), MSG_WAITALL) ==
+        sizeof(file_size)) {
+        file_size = be64toh(file_size);
+        int file_fd = open(OUTPUT_FILE_, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ret = recv_tcp_ip_file(server_accept_fd, file_fd, 0, file_size);
+        close(file_fd);
+        cout << "(" << ret << "/" << file_size << ")"
+             << ":Received file from remote: " << OUTPUT_FILE_ << endl;
+    }
+
+    close(server_accept_fd);
+    ret = close_tcp_ip_server(server_socket_fd);
+    cout << "(" << ret << ")" << endl;
+
+    return 0;
+}
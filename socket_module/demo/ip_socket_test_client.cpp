@@ -1,7 +1,6 @@
-#include <malloc.h>
-
 #include <iostream>
 
+#include "../buffer_pool/buffer_pool.hpp"
 #include "../ip_socket/ip_socket.hpp"
 
 #define SERVER_ADDR_ "127.0.0.1"
@@ -14,8 +13,7 @@ int main() {
     int ret = 0;
     int client_socket_fd = 0;
     SocketMessage msg;
-    msg.len = BUFFER_SIZE_;
-    msg.buf = (char*)malloc(msg.len);
+    acquire_socket_message(&msg, BUFFER_SIZE_);
 
     cout << "TCP Domain Socket Test." << endl;
     client_socket_fd = init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
@@ -0,0 +1,102 @@
+#include <stdint.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../pubsub_broker/pubsub_broker.hpp"
+
+#define SOCKET_ADDR_ "./pubsub_test_socket"
+#define TOPIC_ "vehicle/state"
+#define MSG_NUM_ 10000
+#define MSG_SIZE_ 256
+#define SLOW_DELAY_US_ 1000
+
+using namespace std;
+
+typedef struct SubscriberResult {
+    int received;
+    uint32_t last_seq;
+} SubscriberResult;
+
+// 接收消息直到收到最后一条，慢订阅者每条消息处理SLOW_DELAY_US_微秒
+void run_subscriber(const int socket_fd, const int delay_us,
+                    SubscriberResult* result) {
+    vector<char> buf(2 * (MAX_PUBSUB_MSG_LEN + SOCKET_FRAME_HEADER_SIZE));
+    SocketMessage buffer = {buf.data(), buf.size()};
+    SocketFrameDecoder decoder;
+    PubSubMessage msg;
+    uint32_t seq = 0;
+
+    init_socket_frame_decoder(&decoder, &buffer);
+    result->received = 0;
+    result->last_seq = 0;
+    while (recv_pubsub_msg(socket_fd, &decoder, &msg) > 0) {
+        memcpy(&seq, msg.data.buf, sizeof(seq));
+        result->received++;
+        result->last_seq = seq;
+        if (seq == MSG_NUM_ - 1) break;
+        if (delay_us > 0) {
+            this_thread::sleep_for(chrono::microseconds(delay_us));
+        }
+    }
+}
+
+int main() {
+    PubSubBroker broker;
+    SubscriberResult fast_result, slow_result;
+    char data[MSG_SIZE_];
+    SocketMessage msg = {data, sizeof(data)};
+
+    cout << "Pub/Sub Broker Test." << endl;
+    if (init_pubsub_broker(&broker, SOCKET_ADDR_) < 0) return -1;
+    thread broker_thread([&broker]() { run_pubsub_broker(&broker); });
+
+    int fast_fd = init_pubsub_client(SOCKET_ADDR_);
+    int slow_fd = init_pubsub_client(SOCKET_ADDR_);
+    int pub_fd = init_pubsub_client(SOCKET_ADDR_);
+    if (fast_fd < 0 || slow_fd < 0 || pub_fd < 0) return -1;
+    subscribe_pubsub_topic(fast_fd, TOPIC_, PUBSUB_DROP_OLDEST);
+    subscribe_pubsub_topic(slow_fd, TOPIC_, PUBSUB_CONFLATE);
+    // 订阅与发布走不同的连接，等待代理先处理订阅
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    thread fast_thread(run_subscriber, fast_fd, 0, &fast_result);
+    thread slow_thread(run_subscriber, slow_fd, SLOW_DELAY_US_, &slow_result);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    memset(data, 'x', sizeof(data));
+    for (uint32_t seq = 0; seq < MSG_NUM_; seq++) {
+        memcpy(data, &seq, sizeof(seq));
+        if (publish_pubsub_msg(pub_fd, TOPIC_, &msg) < 0) return -1;
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() -
+                                              start)
+                         .count();
+
+    fast_thread.join();
+    slow_thread.join();
+    stop_pubsub_broker(&broker);
+    broker_thread.join();
+
+    cout << "published " << MSG_NUM_ << " messages in " << elapsed << " s"
+         << endl;
+    cout << "fast subscriber (drop oldest): " << fast_result.received
+         << " received, last seq " << fast_result.last_seq << endl;
+    cout << "slow subscriber (conflate): " << slow_result.received
+         << " received, last seq " << slow_result.last_seq << endl;
+    cout << "broker published " << broker.published_num << ", dropped "
+         << broker.dropped_num << endl;
+
+    close_pubsub_client(fast_fd);
+    close_pubsub_client(slow_fd);
+    close_pubsub_client(pub_fd);
+    close_pubsub_broker(&broker);
+
+    return fast_result.last_seq == MSG_NUM_ - 1 &&
+                   slow_result.last_seq == MSG_NUM_ - 1
+               ? 0
+               : -1;
+}
@@ -0,0 +1,180 @@
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../ip_socket/ip_socket.hpp"
+#include "../reliable_udp/reliable_udp.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1254
+#define PROXY_PORT_ 1255
+#define ROUND_NUM_ 5000
+#define STREAM_NUM_ 4
+#define CONTROL_STREAM_ 15
+#define MSG_SIZE_ 64
+
+using namespace std;
+
+typedef chrono::steady_clock ProxyClock;
+
+static atomic<bool> proxy_running(true);
+
+// 本地代理:按loss的概率丢弃报文，其余报文延迟delay_us后转发，两个方向相同
+void run_proxy(const double loss, const int delay_us) {
+    struct sockaddr_in server_addr, client_addr, addr;
+    multimap<ProxyClock::time_point,
+             pair<struct sockaddr_in, vector<char> > >
+        queue;
+    mt19937 rng(12345);
+    uniform_real_distribution<double> dist(0.0, 1.0);
+    char buf[2048];
+    bool has_client = false;
+
+    int proxy_fd = init_udp_ip_server(PROXY_PORT_);
+    memset(&server_addr, 0, sizeof(server_addr));
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons(SERVER_PORT_);
+    server_addr.sin_addr.s_addr = inet_addr(SERVER_ADDR_);
+
+    while (proxy_running) {
+        int wait_ms = 10;
+        if (!queue.empty()) {
+            wait_ms = (int)chrono::duration_cast<chrono::milliseconds>(
+                          queue.begin()->first - ProxyClock::now())
+                          .count();
+            wait_ms = max(0, min(wait_ms, 10));
+        }
+        struct pollfd pfd = {proxy_fd, POLLIN, 0};
+        poll(&pfd, 1, wait_ms);
+
+        while (1) {
+            socklen_t addr_len = sizeof(addr);
+            ssize_t ret = recvfrom(proxy_fd, buf, sizeof(buf), MSG_DONTWAIT,
+                                   (struct sockaddr*)&addr, &addr_len);
+            if (ret < 0) break;
+            bool from_server = addr.sin_port == server_addr.sin_port;
+            if (!from_server) {
+                client_addr = addr;
+                has_client = true;
+            }
+            if (dist(rng) < loss || (from_server && !has_client)) continue;
+            queue.insert(make_pair(
+                ProxyClock::now() + chrono::microseconds(delay_us),
+                make_pair(from_server ? client_addr : server_addr,
+                          vector<char>(buf, buf + ret))));
+        }
+
+        ProxyClock::time_point now = ProxyClock::now();
+        while (!queue.empty() && queue.begin()->first <= now) {
+            const vector<char>& data = queue.begin()->second.second;
+            sendto(proxy_fd, data.data(), data.size(), 0,
+                   (struct sockaddr*)&queue.begin()->second.first,
+                   sizeof(struct sockaddr_in));
+            queue.erase(queue.begin());
+        }
+    }
+
+    close_udp_ip_server(proxy_fd);
+}
+
+// 回显服务端，收到控制流上的消息后退出
+void run_server(RudpConn* conn) {
+    char buf[MSG_SIZE_];
+    SocketMessage msg = {buf, sizeof(buf)};
+    uint16_t stream = 0;
+
+    while (1) {
+        int ret = recv_rudp_msg(conn, &stream, &msg, 5000);
+        if (ret < 0 || stream == CONTROL_STREAM_) break;
+        SocketMessage reply = {buf, (size_t)ret};
+        send_rudp_msg(conn, stream, &reply, true);
+    }
+    flush_rudp_conn(conn, 1000);
+}
+
+uint64_t percentile(const vector<uint64_t>& sorted, const double p) {
+    return sorted[min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+}
+
+int main(int argc, char* argv[]) {
+    double loss = argc > 1 ? atof(argv[1]) / 100 : 0.02;
+    int delay_us = argc > 2 ? atoi(argv[2]) : 200;
+    RudpConn server_conn, client_conn;
+    char send_buf[MSG_SIZE_], recv_buf[MSG_SIZE_];
+    SocketMessage msg = {send_buf, sizeof(send_buf)};
+    SocketMessage recv_msg = {recv_buf, sizeof(recv_buf)};
+    vector<uint64_t> rtts;
+    int failed_num = 0;
+
+    cout << "Reliable UDP Test: loss " << loss * 100 << "%, delay "
+         << delay_us << " us each way." << endl;
+    int server_fd = init_udp_ip_server(SERVER_PORT_);
+    int client_fd = init_udp_ip_client(SERVER_ADDR_, PROXY_PORT_);
+    if (server_fd < 0 || client_fd < 0) return -1;
+    init_rudp_conn(&server_conn, server_fd);
+    init_rudp_conn(&client_conn, client_fd);
+
+    thread proxy(run_proxy, loss, delay_us);
+    thread server(run_server, &server_conn);
+
+    // 每轮在一个流上发出带序号的消息并等待回显，记录往返时延
+    memset(send_buf, 'x', sizeof(send_buf));
+    for (uint32_t seq = 0; seq < ROUND_NUM_; seq++) {
+        memcpy(send_buf, &seq, sizeof(seq));
+        ProxyClock::time_point start = ProxyClock::now();
+        send_rudp_msg(&client_conn, seq % STREAM_NUM_, &msg, true);
+
+        uint32_t echo = ~seq;
+        while (echo != seq) {
+            if (recv_rudp_msg(&client_conn, NULL, &recv_msg, 5000) < 0) break;
+            memcpy(&echo, recv_buf, sizeof(echo));
+        }
+        if (echo != seq) {
+            failed_num++;
+            break;
+        }
+        rtts.push_back(chrono::duration_cast<chrono::microseconds>(
+                           ProxyClock::now() - start)
+                           .count());
+    }
+
+    msg.len = 1;
+    send_rudp_msg(&client_conn, CONTROL_STREAM_, &msg, true);
+    flush_rudp_conn(&client_conn, 1000);
+    server.join();
+    proxy_running = false;
+    proxy.join();
+
+    sort(rtts.begin(), rtts.end());
+    if (!rtts.empty()) {
+        cout << rtts.size() << " round trips, rtt us: p50 "
+             << percentile(rtts, 0.5) << ", p99 " << percentile(rtts, 0.99)
+             << ", p999 " << percentile(rtts, 0.999) << ", max "
+             << rtts.back() << endl;
+    }
+    cout << "client sent " << client_conn.sent_num << ", retransmitted "
+         << client_conn.retransmit_num << ", srtt " << client_conn.srtt_us
+         << " us, rto " << client_conn.rto_us << " us" << endl;
+    cout << "server sent " << server_conn.sent_num << ", retransmitted "
+         << server_conn.retransmit_num << endl;
+
+    close_rudp_conn(&client_conn);
+    close_rudp_conn(&server_conn);
+    close_udp_ip_client(client_fd);
+    close_udp_ip_server(server_fd);
+
+    return failed_num == 0 ? 0 : -1;
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+#include <mutex>
+
+#include "../sharded_server/sharded_server.hpp"
+
+#define SERVER_PORT_ 1234
+#define BUFFER_SIZE_ 10240
+#define WORKER_NUM_ 0    // 0表示每个核心一个工作线程
+#define BACKLOG_NUM_ 1024
+
+using namespace std;
+
+mutex cout_mutex;
+
+int print_msg(const int accept_fd, const SocketMessage* msg,
+              void* /*user_data*/) {
+    lock_guard<mutex> guard(cout_mutex);
+    if (msg->len == 0) {
+        cout << "[" << this_thread::get_id() << "][" << accept_fd
+             << "] request has been released!" << endl;
+        return 0;
+    }
+    cout << "[" << this_thread::get_id() << "][" << accept_fd << "]("
+         << msg->len << "):Received messege from remote: ";
+    cout.write(msg->buf, msg->len) << endl;
+    return 0;
+}
+
+int main() {
+    int ret = 0;
+    ShardedServer server;
+
+    cout << "TCP IP Socket Sharded Server Test." << endl;
+    ret = init_tcp_ip_sharded_server(&server, SERVER_PORT_, WORKER_NUM_,
+                                     BACKLOG_NUM_, print_msg, NULL,
+                                     BUFFER_SIZE_);
+    cout << "(" << ret << ") workers started, press enter to stop." << endl;
+    if (ret < 0) return -1;
+
+    cin.get();
+    ret = close_tcp_ip_sharded_server(&server);
+    cout << "(" << ret << ")" << endl;
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../shm_ring/shm_ring.hpp"
+
+#define SOCKET_ADDR_ "./test_domain_socket"
+#define BUFFER_SIZE_ 4000
+
+using namespace std;
+
+int main() {
+    int ret = 0;
+    int client_ring_fd = 0;
+    SocketMessage msg, input;
+    acquire_socket_message(&input, BUFFER_SIZE_);
+
+    cout << "Shared Memory Ring Test." << endl;
+    client_ring_fd = init_shm_ring_client(SOCKET_ADDR_);
+    for (size_t i = 0; i < 10; i++) {
+        std::cout << "Input messege>>> ";
+        if (fgets(input.buf, BUFFER_SIZE_, stdin) == NULL) break;
+        // 槽位容量有限，只发送实际输入的内容
+        msg.buf = input.buf;
+        msg.len = strlen(input.buf) + 1;
+        ret = send_shm_ring_msg(client_ring_fd, &msg);
+        cout << "(" << ret << ")" << msg.buf << endl;
+    }
+
+    ret = close_shm_ring_client(client_ring_fd);
+    cout << "(" << ret << ")" << endl;
+    release_socket_message(&input);
+    return 0;
+}
@@ -0,0 +1,28 @@
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../shm_ring/shm_ring.hpp"
+
+#define SOCKET_ADDR_ "./test_domain_socket"
+#define BUFFER_SIZE_ 10240
+
+using namespace std;
+
+int main() {
+    int ret = 0;
+    int server_ring_fd = 0;
+    SocketMessage msg;
+    acquire_socket_message(&msg, BUFFER_SIZE_);
+
+    cout << "Shared Memory Ring Test." << endl;
+    server_ring_fd = init_shm_ring_server(SOCKET_ADDR_);
+    while (1) {
+        ret = recv_shm_ring_msg(server_ring_fd, &msg);
+        cout << "(" << ret << ")"
+             << ":Received messege from remote: " << msg.buf << endl;
+    }
+    ret = close_shm_ring_server(server_ring_fd);
+    cout << "(" << ret << ")" << endl;
+
+    return 0;
+}
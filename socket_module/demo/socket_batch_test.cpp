@@ -0,0 +1,114 @@
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "../ip_socket/ip_socket.hpp"
+#include "../socket_batch/socket_batch.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1250
+#define MSG_NUM_ 100000
+#define MSG_SIZE_ 64
+#define SPARSE_NUM_ 100
+#define DELAY_US_ 500
+
+using namespace std;
+
+static SocketMetricsSnapshot snapshot;
+
+uint64_t send_syscalls(const int socket_fd) {
+    get_socket_metrics(socket_fd, &snapshot);
+    return snapshot.counters[SOCKET_METRICS_SEND].syscalls;
+}
+
+void report(const char* name, const int msg_num, const int socket_fd,
+            const chrono::steady_clock::time_point start) {
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() -
+                                              start)
+                         .count();
+    cout << name << ": " << msg_num << " messages, "
+         << send_syscalls(socket_fd) << " send syscalls, " << elapsed << " s"
+         << endl;
+    reset_socket_metrics(socket_fd);
+}
+
+int main() {
+    char data[MSG_SIZE_];
+    SocketMessage msg = {data, sizeof(data)};
+    SocketBatchSender sender;
+    size_t total = (size_t)(2 * MSG_NUM_ + SPARSE_NUM_ + 3) * MSG_SIZE_;
+
+    cout << "Socket Batch Sender Test." << endl;
+    int server_fd = init_tcp_ip_server(SERVER_PORT_);
+    int client_fd = init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+    int accept_fd = accept(server_fd, NULL, NULL);
+    if (server_fd < 0 || client_fd < 0 || accept_fd < 0) return -1;
+    if (init_socket_batch_sender(&sender, client_fd, 16 * 1024, DELAY_US_) <
+        0) {
+        return -1;
+    }
+
+    thread receiver([accept_fd, total]() {
+        char buf[64 * 1024];
+        size_t received = 0;
+        while (received < total) {
+            ssize_t ret = recv(accept_fd, buf, sizeof(buf), 0);
+            if (ret <= 0) break;
+            received += ret;
+        }
+        cout << "received " << received << " of " << total << " bytes"
+             << endl;
+    });
+
+    memset(data, 'x', sizeof(data));
+    reset_socket_metrics(client_fd);
+
+    // 逐条发送
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < MSG_NUM_; i++) send_tcp_ip_msg(client_fd, &msg);
+    report("unbatched", MSG_NUM_, client_fd, start);
+
+    // 连续发送时合并，发送循环中轮询截止时间
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < MSG_NUM_; i++) {
+        push_socket_batch_msg(&sender, &msg);
+        check_socket_batch_deadline(&sender);
+    }
+    flush_socket_batch_sender(&sender);
+    report("batched", MSG_NUM_, client_fd, start);
+
+    // 稀疏的消息直接发出，不等待截止时间
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < SPARSE_NUM_; i++) {
+        push_socket_batch_msg(&sender, &msg);
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    report("sparse", SPARSE_NUM_, client_fd, start);
+
+    // 后两条消息进入缓存，由timer_fd在截止时间写出
+    struct pollfd pfd = {sender.timer_fd, POLLIN, 0};
+    for (int i = 0; i < 3; i++) push_socket_batch_msg(&sender, &msg);
+    start = chrono::steady_clock::now();
+    while (sender.len > 0 && poll(&pfd, 1, 100) > 0) {
+        check_socket_batch_deadline(&sender);
+    }
+    cout << "deadline flush after "
+         << chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - start)
+                .count()
+         << " us (delay " << DELAY_US_ << " us)" << endl;
+
+    receiver.join();
+    close_socket_batch_sender(&sender);
+    close_tcp_ip_client(client_fd);
+    close(accept_fd);
+    close_tcp_ip_server(server_fd);
+
+    return 0;
+}
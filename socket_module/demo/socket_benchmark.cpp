@@ -0,0 +1,391 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../domain_socket/domain_socket.hpp"
+#include "../ip_socket/ip_socket.hpp"
+#include "../socket_log/socket_log.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1240
+#define SOCKET_ADDR_ "./bench_domain_socket"
+#define WARMUP_NUM_ 100
+#define UDP_TIMEOUT_MS_ 1000  // 超时未收到回显的报文计为错误
+#define SEQ_TAG_SIZE_ sizeof(uint64_t)  // 每条消息开头的序号，用于识别迟到的回显
+
+using namespace std;
+
+typedef chrono::steady_clock BenchClock;
+
+typedef int (*FrameSendFunc)(const int, const uint16_t, const SocketMessage*);
+typedef int (*FrameRecvFunc)(const int, SocketFrameDecoder*, SocketFrame*);
+typedef int (*MsgFunc)(const int, const SocketMessage*);
+
+typedef struct BenchTransport {
+    const char* name;
+    bool stream;  // 流式传输按帧收发，数据报一次收发一条
+    bool domain;
+    FrameSendFunc send_frame;
+    FrameRecvFunc recv_frame;
+    MsgFunc send_msg;
+    MsgFunc recv_msg;
+} BenchTransport;
+
+// 一端的收发通道，tcp两个方向共用一个连接，udp每个方向各用一对套接字
+typedef struct BenchChannel {
+    int send_fd;
+    int recv_fd;
+    SocketMessage buffer;
+    SocketFrameDecoder decoder;
+} BenchChannel;
+
+typedef struct BenchResult {
+    vector<uint64_t> rtt_ns;
+    uint64_t errors;
+} BenchResult;
+
+static const BenchTransport bench_transport_list[] = {
+    {"tcp_ip", true, false, send_tcp_ip_frame, recv_tcp_ip_frame, NULL, NULL},
+    {"udp_ip", false, false, NULL, NULL, send_udp_ip_msg, recv_udp_ip_msg},
+    {"tcp_domain", true, true, send_tcp_domain_frame, recv_tcp_domain_frame,
+     NULL, NULL},
+    {"udp_domain", false, true, NULL, NULL, send_udp_domain_msg,
+     recv_udp_domain_msg},
+};
+
+int send_bench_msg(const BenchTransport* t, BenchChannel* ch,
+                   const SocketMessage* msg) {
+    if (t->stream) return t->send_frame(ch->send_fd, 0, msg);
+    return t->send_msg(ch->send_fd, msg);
+}
+
+// 返回收到的负载，payload指向通道内部的缓存
+int recv_bench_msg(const BenchTransport* t, BenchChannel* ch,
+                   SocketMessage* payload) {
+    if (t->stream) {
+        SocketFrame frame;
+        int ret = t->recv_frame(ch->recv_fd, &ch->decoder, &frame);
+        if (ret <= 0) return -1;
+        *payload = frame.payload;
+        return frame.payload.len;
+    }
+
+    int ret = t->recv_msg(ch->recv_fd, &ch->buffer);
+    if (ret < 0) return -1;
+    payload->buf = ch->buffer.buf;
+    payload->len = ret;
+    return ret;
+}
+
+string make_domain_addr(const int index, const char* role) {
+    return string(SOCKET_ADDR_) + "_" + to_string(index) + "_" + role;
+}
+
+int open_udp_socket(const BenchTransport* t, const int index,
+                    const char* role, const bool server) {
+    if (t->domain) {
+        string addr = make_domain_addr(index, role);
+        return server ? init_udp_domain_server(addr.c_str())
+                      : init_udp_domain_client(addr.c_str());
+    }
+    uint port = SERVER_PORT_ + 2 * index + (string(role) == "req" ? 0 : 1);
+    return server ? init_udp_ip_server(port)
+                  : init_udp_ip_client(SERVER_ADDR_, port);
+}
+
+// 建立conn_num组客户端与回显端的通道
+int open_channels(const BenchTransport* t, const int conn_num,
+                  const size_t msg_size, int* listen_fd,
+                  vector<BenchChannel>* clients,
+                  vector<BenchChannel>* echoes) {
+    size_t buffer_len = 2 * (msg_size + SOCKET_FRAME_HEADER_SIZE);
+    string listen_addr = make_domain_addr(0, "listen");
+
+    *listen_fd = -1;
+    if (t->stream) {
+        *listen_fd = t->domain ? init_tcp_domain_server(listen_addr.c_str())
+                               : init_tcp_ip_server(SERVER_PORT_);
+        if (*listen_fd < 0) return -1;
+    }
+
+    BenchChannel empty = {-1, -1, {NULL, 0}, {NULL, 0, 0, 0}};
+    clients->assign(conn_num, empty);
+    echoes->assign(conn_num, empty);
+    for (int i = 0; i < conn_num; ++i) {
+        BenchChannel* c = &(*clients)[i];
+        BenchChannel* e = &(*echoes)[i];
+        if (t->stream) {
+            c->send_fd = c->recv_fd =
+                t->domain ? init_tcp_domain_client(listen_addr.c_str())
+                          : init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+            e->send_fd = e->recv_fd = accept(*listen_fd, NULL, NULL);
+        } else {
+            e->recv_fd = open_udp_socket(t, i, "req", true);
+            c->recv_fd = open_udp_socket(t, i, "resp", true);
+            c->send_fd = open_udp_socket(t, i, "req", false);
+            e->send_fd = open_udp_socket(t, i, "resp", false);
+
+            // 回显端也设置超时，停止报文丢失时不会一直阻塞
+            struct timeval timeout = {0, UDP_TIMEOUT_MS_ * 1000};
+            setsockopt(c->recv_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                       sizeof(timeout));
+            setsockopt(e->recv_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                       sizeof(timeout));
+        }
+        if (c->send_fd < 0 || c->recv_fd < 0 || e->send_fd < 0 ||
+            e->recv_fd < 0) {
+            return -1;
+        }
+
+        acquire_socket_message(&c->buffer, buffer_len);
+        acquire_socket_message(&e->buffer, buffer_len);
+        init_socket_frame_decoder(&c->decoder, &c->buffer);
+        init_socket_frame_decoder(&e->decoder, &e->buffer);
+    }
+
+    return 1;
+}
+
+void close_channels(const BenchTransport* t, const int listen_fd,
+                    vector<BenchChannel>* clients,
+                    vector<BenchChannel>* echoes) {
+    for (size_t i = 0; i < clients->size(); ++i) {
+        BenchChannel* c = &(*clients)[i];
+        BenchChannel* e = &(*echoes)[i];
+        if (t->stream && t->domain) {
+            close_tcp_domain_client(c->send_fd);
+            if (e->recv_fd >= 0) close(e->recv_fd);
+        } else if (t->stream) {
+            close_tcp_ip_client(c->send_fd);
+            if (e->recv_fd >= 0) close(e->recv_fd);
+        } else if (t->domain) {
+            close_udp_domain_server(e->recv_fd);
+            close_udp_domain_server(c->recv_fd);
+            close_udp_domain_client(c->send_fd);
+            close_udp_domain_client(e->send_fd);
+            remove(make_domain_addr(i, "req").c_str());
+            remove(make_domain_addr(i, "resp").c_str());
+        } else {
+            close_udp_ip_server(e->recv_fd);
+            close_udp_ip_server(c->recv_fd);
+            close_udp_ip_client(c->send_fd);
+            close_udp_ip_client(e->send_fd);
+        }
+        if (c->buffer.buf != NULL) release_socket_message(&c->buffer);
+        if (e->buffer.buf != NULL) release_socket_message(&e->buffer);
+    }
+
+    if (listen_fd >= 0 && t->domain) {
+        close_tcp_domain_server(listen_fd);
+        remove(make_domain_addr(0, "listen").c_str());
+    } else if (listen_fd >= 0) {
+        close_tcp_ip_server(listen_fd);
+    }
+}
+
+// 回显端，收到空报文或连接关闭时退出;udp在测试结束后接收超时也退出
+void run_echo(const BenchTransport* t, BenchChannel* ch,
+              const BenchClock::time_point deadline) {
+    SocketMessage payload;
+    while (1) {
+        int ret = recv_bench_msg(t, ch, &payload);
+        if (ret > 0) {
+            if (send_bench_msg(t, ch, &payload) < 0) break;
+            continue;
+        }
+        if (ret < 0 && !t->stream &&
+            (errno == EAGAIN || errno == EWOULDBLOCK) &&
+            BenchClock::now() < deadline) {
+            continue;
+        }
+        break;
+    }
+}
+
+// 客户端，每次发出一条消息并等待回显，记录往返时延
+void run_client(const BenchTransport* t, BenchChannel* ch,
+                const size_t msg_size, const BenchClock::time_point deadline,
+                BenchResult* result) {
+    SocketMessage msg, payload;
+    size_t tag_size = min(msg_size, SEQ_TAG_SIZE_);
+    acquire_socket_message(&msg, msg_size);
+    memset(msg.buf, 'x', msg_size);
+    msg.len = msg_size;
+
+    for (uint64_t i = 0; BenchClock::now() < deadline; ++i) {
+        BenchClock::time_point start = BenchClock::now();
+        memcpy(msg.buf, &i, tag_size);
+        if (send_bench_msg(t, ch, &msg) < 0) {
+            ++result->errors;
+            if (!t->stream && errno == EMSGSIZE) break;
+            continue;
+        }
+
+        // udp上一轮超时的回显可能迟到，序号不符的丢弃，不计入本轮
+        int ret = recv_bench_msg(t, ch, &payload);
+        while (!t->stream && ret == (int)msg_size &&
+               memcmp(payload.buf, msg.buf, tag_size) != 0) {
+            ret = recv_bench_msg(t, ch, &payload);
+        }
+        if (ret != (int)msg_size) {
+            ++result->errors;
+            if (t->stream) break;
+            continue;
+        }
+        chrono::nanoseconds cost = BenchClock::now() - start;
+        if (i >= WARMUP_NUM_) result->rtt_ns.push_back(cost.count());
+    }
+
+    if (t->stream) {
+        // 关闭写端，回显端收到EOF后退出
+        shutdown(ch->send_fd, SHUT_WR);
+    } else {
+        SocketMessage stop = {msg.buf, 0};
+        send_bench_msg(t, ch, &stop);
+    }
+    release_socket_message(&msg);
+}
+
+double percentile_us(const vector<uint64_t>& sorted, const double p) {
+    if (sorted.empty()) return 0;
+    size_t index = (size_t)(p * sorted.size());
+    if (index >= sorted.size()) index = sorted.size() - 1;
+    return sorted[index] / 1000.0;
+}
+
+void run_bench(FILE* out, const BenchTransport* t, const size_t msg_size,
+               const int conn_num, const double duration) {
+    int listen_fd = -1;
+    vector<BenchChannel> clients, echoes;
+    vector<BenchResult> results(conn_num);
+    vector<thread> workers;
+
+    if (open_channels(t, conn_num, msg_size, &listen_fd, &clients, &echoes) <
+        0) {
+        fprintf(out,
+                "{\"transport\":\"%s\",\"msg_size\":%zu,\"conns\":%d,"
+                "\"error\":\"setup failed\"}\n",
+                t->name, msg_size, conn_num);
+        close_channels(t, listen_fd, &clients, &echoes);
+        return;
+    }
+
+    BenchClock::time_point start = BenchClock::now();
+    BenchClock::time_point deadline =
+        start + chrono::duration_cast<BenchClock::duration>(
+                    chrono::duration<double>(duration));
+    for (int i = 0; i < conn_num; ++i) {
+        results[i].errors = 0;
+        workers.push_back(thread(run_echo, t, &echoes[i], deadline));
+        workers.push_back(thread(run_client, t, &clients[i], msg_size,
+                                 deadline, &results[i]));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+    chrono::duration<double> cost = BenchClock::now() - start;
+    close_channels(t, listen_fd, &clients, &echoes);
+
+    vector<uint64_t> rtt_ns;
+    uint64_t errors = 0;
+    for (int i = 0; i < conn_num; ++i) {
+        rtt_ns.insert(rtt_ns.end(), results[i].rtt_ns.begin(),
+                      results[i].rtt_ns.end());
+        errors += results[i].errors;
+    }
+    sort(rtt_ns.begin(), rtt_ns.end());
+
+    double msgs_per_sec = rtt_ns.size() / cost.count();
+    fprintf(out,
+            "{\"transport\":\"%s\",\"msg_size\":%zu,\"conns\":%d,"
+            "\"duration_s\":%.3f,\"msgs\":%zu,\"errors\":%llu,"
+            "\"msgs_per_sec\":%.1f,\"mb_per_sec\":%.3f,\"p50_us\":%.2f,"
+            "\"p99_us\":%.2f,\"p999_us\":%.2f}\n",
+            t->name, msg_size, conn_num, cost.count(), rtt_ns.size(),
+            (unsigned long long)errors, msgs_per_sec,
+            msgs_per_sec * msg_size / (1024 * 1024),
+            percentile_us(rtt_ns, 0.5), percentile_us(rtt_ns, 0.99),
+            percentile_us(rtt_ns, 0.999));
+    fflush(out);
+}
+
+vector<size_t> parse_list(const char* arg) {
+    vector<size_t> list;
+    char* end = NULL;
+    for (const char* p = arg; *p != '\0'; p = *end == ',' ? end + 1 : end) {
+        list.push_back(strtoull(p, &end, 10));
+        if (end == p) break;
+    }
+    return list;
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [--transport all|tcp_ip|udp_ip|tcp_domain|"
+            "udp_domain] [--sizes 64,1024,...] [--conns 1,4,...] "
+            "[--duration seconds] [--output file]\n",
+            name);
+}
+
+int main(int argc, char** argv) {
+    string transport = "all";
+    vector<size_t> sizes = parse_list("64,1024,16384,65536,1048576");
+    vector<size_t> conns = parse_list("1");
+    double duration = 1.0;
+    FILE* out = stdout;
+
+    if (argc % 2 == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string opt = argv[i];
+        if (opt == "--transport") {
+            transport = argv[i + 1];
+        } else if (opt == "--sizes") {
+            sizes = parse_list(argv[i + 1]);
+        } else if (opt == "--conns") {
+            conns = parse_list(argv[i + 1]);
+        } else if (opt == "--duration") {
+            duration = atof(argv[i + 1]);
+        } else if (opt == "--output") {
+            if (out != stdout) fclose(out);
+            out = fopen(argv[i + 1], "a");
+            if (out == NULL) {
+                perror(argv[i + 1]);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", opt.c_str());
+            print_usage(argv[0]);
+            if (out != stdout) fclose(out);
+            return 1;
+        }
+    }
+
+    // 结果独占标准输出，日志写到标准错误
+    set_socket_log_fd(STDERR_FILENO);
+
+    for (size_t i = 0; i < sizeof(bench_transport_list) /
+                               sizeof(bench_transport_list[0]);
+         ++i) {
+        const BenchTransport* t = &bench_transport_list[i];
+        if (transport != "all" && transport != t->name) continue;
+        for (size_t j = 0; j < sizes.size(); ++j) {
+            for (size_t k = 0; k < conns.size(); ++k) {
+                run_bench(out, t, sizes[j], conns[k], duration);
+            }
+        }
+    }
+
+    if (out != stdout) fclose(out);
+    return 0;
+}
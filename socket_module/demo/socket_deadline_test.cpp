@@ -0,0 +1,111 @@
+#include <errno.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../domain_socket/domain_socket.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1246
+#define SOCKET_ADDR_ "./deadline_test_socket"
+#define TIMEOUT_MS_ 200
+#define PART_DELAY_MS_ 50
+#define EARLY_MS_ 1    // 截止时间按毫秒计算，最多提前1毫秒返回
+#define SLACK_MS_ 100  // 超时返回允许的调度延迟
+#define LARGE_MSG_SIZE_ (64 * 1024 * 1024)
+
+using namespace std;
+
+typedef chrono::steady_clock DeadlineClock;
+
+long elapsed_ms(const DeadlineClock::time_point start) {
+    return chrono::duration_cast<chrono::milliseconds>(DeadlineClock::now() -
+                                                       start)
+        .count();
+}
+
+// 检查返回值、errno与耗时，expected_ret为-1时要求errno为ETIMEDOUT
+int check(const char* name, const int ret, const int expected_ret,
+          const DeadlineClock::time_point start, const long min_ms,
+          const long max_ms) {
+    int err = errno;
+    long ms = elapsed_ms(start);
+    bool ok = ret == expected_ret && (ret >= 0 || err == ETIMEDOUT) &&
+              ms >= min_ms && ms <= max_ms;
+
+    cout << name << ": ret " << ret << ", "
+         << (ret < 0 ? strerror(err) : "ok") << ", " << ms << " ms"
+         << (ok ? "" : " FAILED") << endl;
+
+    return ok ? 0 : -1;
+}
+
+int main() {
+    char small[10];
+    SocketMessage msg = {small, sizeof(small)};
+    DeadlineClock::time_point start;
+    int ret = 0;
+    int failed_num = 0;
+
+    cout << "Socket Deadline Test." << endl;
+
+    int server_fd = init_tcp_ip_server(SERVER_PORT_);
+    int client_fd = init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+    int accept_fd = accept(server_fd, NULL, NULL);
+    if (server_fd < 0 || client_fd < 0 || accept_fd < 0) return -1;
+
+    // 1. 对端不发送数据，接收在超时后返回
+    start = DeadlineClock::now();
+    ret = recv_tcp_ip_msg_exact(accept_fd, &msg, TIMEOUT_MS_);
+    if (check("recv exact without data", ret, -1, start,
+              TIMEOUT_MS_ - EARLY_MS_, TIMEOUT_MS_ + SLACK_MS_) < 0) {
+        failed_num++;
+    }
+
+    // 2. 数据分两次到达，接收凑满10字节后返回
+    start = DeadlineClock::now();
+    thread sender([client_fd]() {
+        SocketMessage half = {(char*)"01234", 5};
+        send_tcp_ip_msg_all(client_fd, &half, TIMEOUT_MS_);
+        this_thread::sleep_for(chrono::milliseconds(PART_DELAY_MS_));
+        half.buf = (char*)"56789";
+        send_tcp_ip_msg_all(client_fd, &half, TIMEOUT_MS_);
+    });
+    ret = recv_tcp_ip_msg_exact(accept_fd, &msg, TIMEOUT_MS_);
+    sender.join();
+    if (check("recv exact in two parts", ret, sizeof(small), start,
+              PART_DELAY_MS_, TIMEOUT_MS_) < 0) {
+        failed_num++;
+    }
+
+    // 3. 对端不读取，发送缓存写满后在超时后返回
+    vector<char> large(LARGE_MSG_SIZE_, 'x');
+    SocketMessage large_msg = {large.data(), large.size()};
+    start = DeadlineClock::now();
+    ret = send_tcp_ip_msg_all(client_fd, &large_msg, TIMEOUT_MS_);
+    if (check("send all to stalled peer", ret, -1, start,
+              TIMEOUT_MS_ - EARLY_MS_, TIMEOUT_MS_ + SLACK_MS_) < 0) {
+        failed_num++;
+    }
+
+    close(accept_fd);
+    close_tcp_ip_client(client_fd);
+    close_tcp_ip_server(server_fd);
+
+    // 4. udp域套接字没有报文时在超时后返回
+    int udp_fd = init_udp_domain_server(SOCKET_ADDR_);
+    start = DeadlineClock::now();
+    ret = recv_udp_domain_msg_timeout(udp_fd, &msg, TIMEOUT_MS_);
+    if (check("udp recv without data", ret, -1, start,
+              TIMEOUT_MS_ - EARLY_MS_, TIMEOUT_MS_ + SLACK_MS_) < 0) {
+        failed_num++;
+    }
+    close_udp_domain_server(udp_fd);
+    remove(SOCKET_ADDR_);
+
+    return failed_num == 0 ? 0 : -1;
+}
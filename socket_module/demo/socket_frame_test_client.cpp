@@ -0,0 +1,37 @@
+#include <stdio.h>
+
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1234
+#define BUFFER_SIZE_ 10240
+
+using namespace std;
+
+int main() {
+    int ret = 0;
+    int client_socket_fd = 0;
+    SocketMessage msg;
+    acquire_socket_message(&msg, BUFFER_SIZE_);
+
+    cout << "TCP IP Socket Frame Test." << endl;
+    client_socket_fd = init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+
+    // 连续发送多个小帧，服务端仍能逐帧还原消息边界
+    for (uint16_t i = 0; i < 10; i++) {
+        SocketMessage frame_msg;
+        frame_msg.buf = msg.buf;
+        frame_msg.len = snprintf(msg.buf, BUFFER_SIZE_, "frame %u", i);
+        ret = send_tcp_ip_frame(client_socket_fd, i, &frame_msg);
+        cout << "(" << ret << ")" << msg.buf << endl;
+    }
+
+    ret = close_tcp_ip_client(client_socket_fd);
+    cout << "(" << ret << ")" << endl;
+
+    release_socket_message(&msg);
+    return 0;
+}
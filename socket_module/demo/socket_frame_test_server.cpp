@@ -0,0 +1,39 @@
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_PORT_ 1234
+#define BUFFER_SIZE_ 10240
+
+using namespace std;
+
+int main() {
+    int ret = 0;
+    int server_socket_fd = 0, server_accept_fd = 0;
+    SocketMessage msg;
+    SocketFrameDecoder decoder;
+    SocketFrame frame;
+    acquire_socket_message(&msg, BUFFER_SIZE_);
+
+    cout << "TCP IP Socket Frame Test." << endl;
+    server_socket_fd = init_tcp_ip_server(SERVER_PORT_);
+    while (1) {
+        server_accept_fd = accept(server_socket_fd, NULL, NULL);
+        if (server_accept_fd < 0) break;
+        init_socket_frame_decoder(&decoder, &msg);
+        while ((ret = recv_tcp_ip_frame(server_accept_fd, &decoder, &frame)) >
+               0) {
+            cout << "(type " << frame.type << ", " << frame.payload.len
+                 << "):Received messege from remote: ";
+            cout.write(frame.payload.buf, frame.payload.len) << endl;
+        }
+        close(server_accept_fd);
+        cout << "(" << ret << ")request has been released!" << endl;
+    }
+    ret = close_tcp_ip_server(server_socket_fd);
+    cout << "(" << ret << ")" << endl;
+
+    release_socket_message(&msg);
+    return 0;
+}
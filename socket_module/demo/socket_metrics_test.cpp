@@ -0,0 +1,82 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../domain_socket/domain_socket.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+
+#define SOCKET_ADDR_ "./metrics_test_socket"
+#define METRICS_ADDR_ "./metrics_admin_socket"
+#define MSG_NUM_ 10000
+#define MSG_SIZE_ 256
+
+using namespace std;
+
+// 从查询端点读出全部统计并打印
+void dump_metrics_server() {
+    struct sockaddr_un addr;
+    char buf[4096];
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, METRICS_ADDR_);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        cout << "Connect metrics server...failed!" << endl;
+        close(fd);
+        return;
+    }
+
+    ssize_t ret = 0;
+    while ((ret = read(fd, buf, sizeof(buf))) > 0) cout.write(buf, ret);
+    close(fd);
+}
+
+int main() {
+    SocketMessage msg, recv_msg;
+    static SocketMetricsSnapshot snapshot;
+
+    cout << "Socket Metrics Test." << endl;
+    if (start_socket_metrics_server(METRICS_ADDR_) < 0) return -1;
+
+    int server_fd = init_udp_domain_server(SOCKET_ADDR_);
+    int client_fd = init_udp_domain_client(SOCKET_ADDR_);
+    if (server_fd < 0 || client_fd < 0) return -1;
+
+    acquire_socket_message(&msg, MSG_SIZE_);
+    acquire_socket_message(&recv_msg, MSG_SIZE_);
+    memset(msg.buf, 'x', MSG_SIZE_);
+
+    thread receiver([&]() {
+        for (int i = 0; i < MSG_NUM_; i++) {
+            recv_udp_domain_msg(server_fd, &recv_msg);
+        }
+    });
+    for (int i = 0; i < MSG_NUM_; i++) send_udp_domain_msg(client_fd, &msg);
+    receiver.join();
+
+    get_socket_metrics(client_fd, &snapshot);
+    SocketHistogram* send_latency = &snapshot.latency[SOCKET_METRICS_SEND];
+    cout << "client sent "
+         << snapshot.counters[SOCKET_METRICS_SEND].msgs << " msgs, p50 "
+         << get_socket_histogram_percentile(send_latency, 50) << " ns, p99 "
+         << get_socket_histogram_percentile(send_latency, 99) << " ns"
+         << endl;
+
+    cout << "Metrics server dump:" << endl;
+    dump_metrics_server();
+
+    stop_socket_metrics_server();
+    release_socket_message(&msg);
+    release_socket_message(&recv_msg);
+    close_udp_domain_client(client_fd);
+    close_udp_domain_server(server_fd);
+    remove(SOCKET_ADDR_);
+
+    return 0;
+}
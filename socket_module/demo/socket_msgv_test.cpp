@@ -0,0 +1,97 @@
+#include <cstring>
+#include <iostream>
+
+#include "../domain_socket/domain_socket.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SOCKET_ADDR_ "./msgv_test_socket"
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1244
+
+using namespace std;
+
+// 头部、负载、尾部三段分别存放，发送时不拼接
+static char header[] = "HEAD";
+static char body[] = "scatter-gather payload";
+static char trailer[] = "TAIL";
+
+void fill_segments(SocketMessage* segs) {
+    segs[0].buf = header;
+    segs[0].len = strlen(header);
+    segs[1].buf = body;
+    segs[1].len = strlen(body);
+    segs[2].buf = trailer;
+    segs[2].len = strlen(trailer);
+}
+
+int test_tcp_domain() {
+    SocketMessage segs[3], recv_segs[3];
+    char recv_header[4], recv_body[22], recv_trailer[4];
+
+    int server_fd = init_tcp_domain_server(SOCKET_ADDR_);
+    int client_fd = init_tcp_domain_client(SOCKET_ADDR_);
+    int accept_fd = accept(server_fd, NULL, NULL);
+    if (server_fd < 0 || client_fd < 0 || accept_fd < 0) return -1;
+
+    fill_segments(segs);
+    int sent = send_tcp_domain_msgv(client_fd, segs, 3);
+
+    // 接收端按相同的段长分散接收，头部与尾部直接落在各自的缓存中
+    recv_segs[0].buf = recv_header;
+    recv_segs[0].len = sizeof(recv_header);
+    recv_segs[1].buf = recv_body;
+    recv_segs[1].len = sizeof(recv_body);
+    recv_segs[2].buf = recv_trailer;
+    recv_segs[2].len = sizeof(recv_trailer);
+    int received = recv_tcp_domain_msgv(accept_fd, recv_segs, 3);
+
+    bool ok = sent == received &&
+              memcmp(recv_header, header, sizeof(recv_header)) == 0 &&
+              memcmp(recv_body, body, sizeof(recv_body)) == 0 &&
+              memcmp(recv_trailer, trailer, sizeof(recv_trailer)) == 0;
+    cout << "tcp domain: sent " << sent << " bytes, received " << received
+         << " bytes, " << (ok ? "match" : "mismatch") << endl;
+
+    close(accept_fd);
+    close_tcp_domain_client(client_fd);
+    close_tcp_domain_server(server_fd);
+    remove(SOCKET_ADDR_);
+
+    return ok ? 1 : -1;
+}
+
+int test_udp_ip() {
+    SocketMessage segs[3], recv_segs[2];
+    char first[8], second[64];
+
+    int server_fd = init_udp_ip_server(SERVER_PORT_);
+    int client_fd = init_udp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+    if (server_fd < 0 || client_fd < 0) return -1;
+
+    fill_segments(segs);
+    int sent = send_udp_ip_msgv(client_fd, segs, 3);
+
+    // 一个报文可以拆到与发送端不同的分段中
+    recv_segs[0].buf = first;
+    recv_segs[0].len = sizeof(first);
+    recv_segs[1].buf = second;
+    recv_segs[1].len = sizeof(second);
+    int received = recv_udp_ip_msgv(server_fd, recv_segs, 2);
+
+    bool ok = sent == received && memcmp(first, "HEADscat", 8) == 0;
+    cout << "udp ip: sent " << sent << " bytes, received " << received
+         << " bytes, " << (ok ? "match" : "mismatch") << endl;
+
+    close_udp_ip_client(client_fd);
+    close_udp_ip_server(server_fd);
+
+    return ok ? 1 : -1;
+}
+
+int main() {
+    cout << "Scatter-Gather Msg Test." << endl;
+
+    if (test_tcp_domain() < 0 || test_udp_ip() < 0) return -1;
+
+    return 0;
+}
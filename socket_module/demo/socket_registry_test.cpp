@@ -0,0 +1,56 @@
+#include <fcntl.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../ip_socket/ip_socket.hpp"
+#include "../socket_registry/socket_registry.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1234
+#define THREAD_NUM_ 4
+#define SOCKET_NUM_ 1000
+
+using namespace std;
+
+// 每个线程反复创建并关闭udp客户端，同时持有一部分句柄直到线程结束
+void open_and_close(vector<SocketHandle>* kept) {
+    for (int i = 0; i < SOCKET_NUM_; i++) {
+        SocketHandle handle(init_udp_ip_client(SERVER_ADDR_, SERVER_PORT_),
+                            UDP_IP_CLIENT_SOCKET);
+        if (!handle) continue;
+        if (i % 10 == 0) kept->push_back(std::move(handle));
+    }
+}
+
+int main() {
+    int ret = 0;
+    int leaked_fd = 0;
+    vector<vector<SocketHandle> > kept(THREAD_NUM_);
+    vector<thread> workers;
+
+    cout << "Socket Registry Test." << endl;
+    for (int i = 0; i < THREAD_NUM_; i++) {
+        workers.push_back(thread(open_and_close, &kept[i]));
+    }
+    for (int i = 0; i < THREAD_NUM_; i++) workers[i].join();
+
+    size_t kept_num = 0;
+    for (int i = 0; i < THREAD_NUM_; i++) kept_num += kept[i].size();
+    cout << "(" << kept_num << ")Handles still open." << endl;
+
+    // 句柄析构时注销并关闭套接字
+    kept.clear();
+
+    // 未被句柄接管的套接字仍由close_all_*关闭
+    leaked_fd = init_udp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+    ret = close_all_udp_ip_client();
+    cout << "(" << ret << ")Close all udp clients, fd " << leaked_fd
+         << (fcntl(leaked_fd, F_GETFD) < 0 ? " closed." : " still open!")
+         << endl;
+
+    ret = close_udp_ip_client(leaked_fd);
+    cout << "(" << ret << ")Close an unregistered fd." << endl;
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "../domain_socket/domain_socket.hpp"
+#include "../event_loop/event_loop.hpp"
+#include "../socket_send_queue/socket_send_queue.hpp"
+
+#define SERVER_ADDR_ "@socket_module_send_queue_test"
+#define MSG_SIZE_ 1024
+#define MSG_NUM_ 20000
+#define TELEMETRY_NUM_ 5000
+#define HIGH_BYTES_ (256 * 1024)
+#define LOW_BYTES_ (64 * 1024)
+
+using namespace std;
+
+typedef struct Producer {
+    SocketEventLoop *loop;
+    int accept_fd;
+    uint32_t next_seq;
+    int blocked_num;
+    int resumed_num;
+    size_t max_bytes;
+} Producer;
+
+// 消费者:按序号检查收到的消息，每stall_every条停顿一次，模拟跟不上的订阅者
+int consume(const int socket_fd, const uint32_t last_seq,
+            const int stall_every, uint32_t *received_num) {
+    char buf[MSG_SIZE_];
+    SocketMessage msg = {buf, sizeof(buf)};
+    uint32_t prev = 0, seq = 0;
+    int disordered = 0;
+
+    *received_num = 0;
+    while (seq != last_seq &&
+           recv_socket_exact(socket_fd, &msg, 5000) == MSG_SIZE_) {
+        memcpy(&seq, buf, sizeof(seq));
+        if (*received_num > 0 && seq <= prev) disordered++;
+        prev = seq;
+        ++*received_num;
+        if (stall_every > 0 && *received_num % stall_every == 0) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+
+    return seq == last_seq && disordered == 0 ? 0 : -1;
+}
+
+void count_backpressure(const int, const bool blocked, void *user_data) {
+    Producer *producer = (Producer *)user_data;
+    if (blocked) {
+        producer->blocked_num++;
+    } else {
+        producer->resumed_num++;
+    }
+}
+
+// 拒绝模式:生产者被拒绝后等待套接字可写再继续，所有消息按序到达
+int test_reject(int fds[2]) {
+    char buf[MSG_SIZE_];
+    SocketMessage msg = {buf, sizeof(buf)};
+    SocketSendQueueConfig config;
+    SocketSendQueue queue;
+    Producer producer = {NULL, fds[0], 0, 0, 0, 0};
+    int rejected = 0;
+    uint32_t received_num = 0;
+    int ret = 0;
+
+    get_default_socket_send_queue_config(&config);
+    config.high_bytes = HIGH_BYTES_;
+    config.low_bytes = LOW_BYTES_;
+    config.on_backpressure = count_backpressure;
+    config.user_data = &producer;
+    init_socket_send_queue(&queue, fds[0], &config);
+
+    // 消费者启动前先填满发送缓存与队列
+    memset(buf, 'x', sizeof(buf));
+    while (1) {
+        memcpy(buf, &producer.next_seq, sizeof(uint32_t));
+        if (push_socket_send_queue(&queue, &msg) < 0) break;
+        producer.next_seq++;
+    }
+    bool stalled_ok = errno == EAGAIN && queue.blocked &&
+                      queue.bytes <= HIGH_BYTES_ + MSG_SIZE_;
+
+    thread consumer([&]() {
+        ret = consume(fds[1], MSG_NUM_ - 1, 256, &received_num);
+    });
+
+    struct pollfd pfd = {fds[0], POLLOUT, 0};
+    while (producer.next_seq < MSG_NUM_) {
+        memcpy(buf, &producer.next_seq, sizeof(uint32_t));
+        if (push_socket_send_queue(&queue, &msg) < 0) {
+            rejected++;
+            poll(&pfd, 1, 10);
+            flush_socket_send_queue(&queue);
+            continue;
+        }
+        producer.next_seq++;
+        if (queue.bytes > producer.max_bytes) producer.max_bytes = queue.bytes;
+    }
+    drain_socket_send_queue(&queue, 5000);
+    consumer.join();
+    close_socket_send_queue(&queue);
+
+    cout << "reject: " << received_num << " of " << MSG_NUM_
+         << " received in order, " << rejected << " pushes rejected, "
+         << producer.blocked_num << " blocked / " << producer.resumed_num
+         << " resumed, max queued " << producer.max_bytes << " bytes"
+         << endl;
+
+    return ret == 0 && stalled_ok && producer.blocked_num > 0 &&
+                   producer.max_bytes <= HIGH_BYTES_ + MSG_SIZE_
+               ? 0
+               : -1;
+}
+
+// 丢弃模式:消费者停顿期间从不拒绝，内存有界，最新的消息一定送达
+int test_drop_oldest(int fds[2]) {
+    char buf[MSG_SIZE_];
+    SocketMessage msg = {buf, sizeof(buf)};
+    SocketSendQueueConfig config;
+    SocketSendQueue queue;
+    size_t max_bytes = 0;
+    int failed_num = 0;
+    uint32_t received_num = 0;
+
+    get_default_socket_send_queue_config(&config);
+    config.high_bytes = 64 * 1024;
+    config.low_bytes = 16 * 1024;
+    config.mode = SEND_QUEUE_DROP_OLDEST;
+    init_socket_send_queue(&queue, fds[0], &config);
+
+    memset(buf, 't', sizeof(buf));
+    for (uint32_t seq = 0; seq < TELEMETRY_NUM_; seq++) {
+        memcpy(buf, &seq, sizeof(seq));
+        if (push_socket_send_queue(&queue, &msg) < 0) failed_num++;
+        if (queue.bytes > max_bytes) max_bytes = queue.bytes;
+    }
+    int ret = 0;
+    thread consumer([&]() {
+        ret = consume(fds[1], TELEMETRY_NUM_ - 1, 0, &received_num);
+    });
+    drain_socket_send_queue(&queue, 5000);
+    consumer.join();
+
+    cout << "drop oldest: " << failed_num << " pushes failed, "
+         << queue.dropped_num << " dropped, " << received_num
+         << " received, latest delivered " << (ret == 0 ? "yes" : "no")
+         << ", max queued " << max_bytes << " bytes" << endl;
+    close_socket_send_queue(&queue);
+
+    return failed_num == 0 && queue.dropped_num > 0 && ret == 0 &&
+                   max_bytes <= config.high_bytes + MSG_SIZE_
+               ? 0
+               : -1;
+}
+
+// 事件循环:被拒绝后停止生产，解除背压的回调中继续生产，排队的消息在EPOLLOUT时写出
+void produce(Producer *producer) {
+    char buf[MSG_SIZE_];
+    SocketMessage msg = {buf, sizeof(buf)};
+
+    memset(buf, 'e', sizeof(buf));
+    while (producer->next_seq < MSG_NUM_) {
+        memcpy(buf, &producer->next_seq, sizeof(uint32_t));
+        if (send_socket_event_loop_msg(producer->loop, producer->accept_fd,
+                                       &msg) < 0) {
+            return;
+        }
+        producer->next_seq++;
+        size_t bytes =
+            producer->loop->send_queues[producer->accept_fd]->bytes;
+        if (bytes > producer->max_bytes) producer->max_bytes = bytes;
+    }
+}
+
+void resume_producer(const int socket_fd, const bool blocked,
+                     void *user_data) {
+    count_backpressure(socket_fd, blocked, user_data);
+    if (!blocked) produce((Producer *)user_data);
+}
+
+int start_producer(const int accept_fd, const SocketMessage *msg,
+                   void *user_data) {
+    Producer *producer = (Producer *)user_data;
+    if (msg->len == 0) return -1;
+    producer->accept_fd = accept_fd;
+    produce(producer);
+    return 1;
+}
+
+int test_event_loop() {
+    SocketEventLoop loop;
+    SocketSendQueueConfig config;
+    Producer producer = {&loop, -1, 0, 0, 0, 0};
+    char recv_buf[MSG_SIZE_];
+    SocketMessage recv_msg = {recv_buf, sizeof(recv_buf)};
+    SocketMessage go = {(char *)"go", 2};
+    uint32_t received_num = 0;
+
+    get_default_socket_send_queue_config(&config);
+    config.high_bytes = HIGH_BYTES_;
+    config.low_bytes = LOW_BYTES_;
+    config.on_backpressure = resume_producer;
+    config.user_data = &producer;
+
+    int server_fd = init_tcp_domain_server(SERVER_ADDR_);
+    if (server_fd < 0) return -1;
+    init_socket_event_loop(&loop, server_fd, start_producer, &producer,
+                           &config);
+    thread server([&]() { run_socket_event_loop(&loop, &recv_msg); });
+
+    int client_fd = init_tcp_domain_client(SERVER_ADDR_);
+    send_tcp_domain_msg(client_fd, &go);
+    int ret = consume(client_fd, MSG_NUM_ - 1, 256, &received_num);
+
+    stop_socket_event_loop(&loop);
+    server.join();
+    close_tcp_domain_client(client_fd);
+    close_socket_event_loop(&loop);
+    close_tcp_domain_server(server_fd);
+
+    cout << "event loop: " << received_num << " of " << MSG_NUM_
+         << " received in order, " << producer.blocked_num << " blocked / "
+         << producer.resumed_num << " resumed, max queued "
+         << producer.max_bytes << " bytes" << endl;
+
+    return ret == 0 && producer.blocked_num > 0 &&
+                   producer.max_bytes <= HIGH_BYTES_ + MSG_SIZE_
+               ? 0
+               : -1;
+}
+
+int main() {
+    int fds[2];
+    int failed_num = 0;
+
+    cout << "Socket Send Queue Test." << endl;
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) return -1;
+    if (test_reject(fds) < 0) failed_num++;
+    close(fds[0]);
+    close(fds[1]);
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) return -1;
+    if (test_drop_oldest(fds) < 0) failed_num++;
+    close(fds[0]);
+    close(fds[1]);
+
+    if (test_event_loop() < 0) failed_num++;
+
+    return failed_num == 0 ? 0 : -1;
+}
@@ -0,0 +1,131 @@
+#include <stdint.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "../socket_typed/socket_typed.hpp"
+
+#define ROUND_NUM_ 2000
+#define BATCH_NUM_ 100  // 每个小帧在域套接字的发送缓存中占用一个skb
+#define RAW_TYPE_ 1
+
+using namespace std;
+
+typedef struct VehicleState {
+    uint64_t timestamp_ns;
+    double x;
+    double y;
+    double speed;
+    uint32_t seq;
+    uint32_t status;
+} VehicleState;
+
+typedef struct VehicleCommand {
+    uint32_t seq;
+    uint16_t code;
+    uint16_t reserved;
+} VehicleCommand;
+
+DEFINE_SOCKET_MESSAGE(VehicleState, 0x0101, 1, 40);
+CHECK_SOCKET_MESSAGE_FIELD(VehicleState, seq, 32);
+DEFINE_SOCKET_MESSAGE(VehicleCommand, 0x0102, 1, 8);
+
+typedef struct VehicleHandler {
+    uint64_t state_num;
+    uint64_t command_num;
+    uint32_t last_seq;
+
+    void operator()(const VehicleState& state) {
+        state_num++;
+        last_seq = state.seq;
+    }
+    void operator()(const VehicleCommand& command) {
+        command_num++;
+        last_seq = command.seq;
+    }
+} VehicleHandler;
+
+double elapsed_ns(const chrono::steady_clock::time_point start) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start)
+        .count();
+}
+
+int main() {
+    int fds[2];
+    char buf[64 * 1024], raw[sizeof(VehicleState)];
+    SocketMessage buffer = {buf, sizeof(buf)};
+    SocketFrameDecoder decoder;
+    SocketFrame frame;
+    VehicleState state;
+    VehicleCommand command;
+    VehicleHandler handler = {0, 0, 0};
+    int failed_num = 0;
+
+    cout << "Typed Socket Message Test." << endl;
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) return -1;
+    init_socket_frame_decoder(&decoder, &buffer);
+    memset(&state, 0, sizeof(state));
+    memset(&command, 0, sizeof(command));
+
+    // 类型消息: 交替发送两种消息，通过分发表交给处理器
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int round = 0; round < ROUND_NUM_; round++) {
+        for (int i = 0; i < BATCH_NUM_; i++) {
+            state.seq = command.seq = round * BATCH_NUM_ + i;
+            if (i % 2 == 0) {
+                send_typed_msg(fds[0], state);
+            } else {
+                send_typed_msg(fds[0], command);
+            }
+        }
+        for (int i = 0; i < BATCH_NUM_; i++) {
+            if (recv_socket_frame(fds[1], &decoder, &frame) <= 0 ||
+                dispatch_typed_msg<VehicleState, VehicleCommand>(
+                    &frame, handler) <= 0) {
+                failed_num++;
+            }
+        }
+    }
+    double typed_ns = elapsed_ns(start) / (ROUND_NUM_ * BATCH_NUM_);
+
+    // 对照组: 手工拷贝到缓存后发送，按类型手工转换
+    SocketMessage raw_msg = {raw, sizeof(state)};
+    start = chrono::steady_clock::now();
+    for (int round = 0; round < ROUND_NUM_; round++) {
+        for (int i = 0; i < BATCH_NUM_; i++) {
+            state.seq = round * BATCH_NUM_ + i;
+            memcpy(raw, &state, sizeof(state));
+            send_socket_frame(fds[0], RAW_TYPE_, &raw_msg);
+        }
+        for (int i = 0; i < BATCH_NUM_; i++) {
+            if (recv_socket_frame(fds[1], &decoder, &frame) <= 0 ||
+                frame.type != RAW_TYPE_) {
+                failed_num++;
+                continue;
+            }
+            memcpy(&state, frame.payload.buf, sizeof(state));
+        }
+    }
+    double raw_ns = elapsed_ns(start) / (ROUND_NUM_ * BATCH_NUM_);
+
+    // 版本不匹配的消息应被拒绝
+    send_typed_msg(fds[0], command);
+    recv_socket_frame(fds[1], &decoder, &frame);
+    frame.flags ^= 1;
+    bool rejected = decode_typed_msg(&frame, &command) < 0 && errno == EPROTO;
+
+    cout << "typed: " << handler.state_num << " states, "
+         << handler.command_num << " commands, last seq " << handler.last_seq
+         << ", " << typed_ns << " ns/msg" << endl;
+    cout << "raw: " << raw_ns << " ns/msg" << endl;
+    cout << "version mismatch rejected: " << (rejected ? "yes" : "no")
+         << ", failed " << failed_num << endl;
+
+    close(fds[0]);
+    close(fds[1]);
+
+    return failed_num == 0 && rejected ? 0 : -1;
+}
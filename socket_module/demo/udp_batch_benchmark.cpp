@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iostream>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../domain_socket/domain_socket.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1235
+#define SOCKET_ADDR_ "./test_udp_batch_socket"
+#define PACKET_SIZE_ 64
+#define BURST_NUM_ 32  // 每轮收发的报文数，小于接收缓冲区可容纳的数量以避免丢包
+#define DOMAIN_BURST_NUM_ 8  // 域数据报的接收队列长度默认只有10(max_dgram_qlen)
+#define ROUND_NUM_ 20000
+
+using namespace std;
+
+typedef int (*SingleFunc)(const int, const SocketMessage*);
+typedef int (*BatchRecvFunc)(const int, const SocketMessage*, int*,
+                             const uint);
+typedef int (*BatchSendFunc)(const int, const SocketMessage*, const uint);
+
+int recv_ip_batch(const int fd, const SocketMessage* msgs, int* lens,
+                  const uint num) {
+    return recv_udp_ip_msg_batch(fd, msgs, lens, NULL, num);
+}
+
+int recv_domain_batch(const int fd, const SocketMessage* msgs, int* lens,
+                      const uint num) {
+    return recv_udp_domain_msg_batch(fd, msgs, lens, NULL, num);
+}
+
+double bench_single(int server_fd, int client_fd, SocketMessage* msgs,
+                    int burst, SingleFunc send_func, SingleFunc recv_func) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int round = 0; round < ROUND_NUM_; ++round) {
+        for (int i = 0; i < burst; ++i) send_func(client_fd, &msgs[i]);
+        for (int i = 0; i < burst; ++i) recv_func(server_fd, &msgs[i]);
+    }
+    chrono::duration<double> cost = chrono::steady_clock::now() - start;
+    return (double)ROUND_NUM_ * burst / cost.count();
+}
+
+double bench_batch(int server_fd, int client_fd, SocketMessage* msgs,
+                   int burst, BatchSendFunc send_func,
+                   BatchRecvFunc recv_func) {
+    int lens[BURST_NUM_];
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int round = 0; round < ROUND_NUM_; ++round) {
+        send_func(client_fd, msgs, burst);
+        for (int recved = 0; recved < burst;) {
+            int ret = recv_func(server_fd, msgs, lens, burst - recved);
+            if (ret <= 0) break;
+            recved += ret;
+        }
+    }
+    chrono::duration<double> cost = chrono::steady_clock::now() - start;
+    return (double)ROUND_NUM_ * burst / cost.count();
+}
+
+int main() {
+    int server_socket_fd = 0, client_socket_fd = 0;
+    SocketMessage msgs[BURST_NUM_];
+    for (int i = 0; i < BURST_NUM_; ++i) {
+        acquire_socket_message(&msgs[i], PACKET_SIZE_);
+    }
+
+    cout << "UDP IP Socket Batch Benchmark." << endl;
+    server_socket_fd = init_udp_ip_server(SERVER_PORT_);
+    client_socket_fd = init_udp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+    cout << "single: "
+         << bench_single(server_socket_fd, client_socket_fd, msgs, BURST_NUM_,
+                         send_udp_ip_msg, recv_udp_ip_msg)
+         << " packets/s" << endl;
+    cout << "batch:  "
+         << bench_batch(server_socket_fd, client_socket_fd, msgs, BURST_NUM_,
+                        send_udp_ip_msg_batch, recv_ip_batch)
+         << " packets/s" << endl;
+    close_udp_ip_client(client_socket_fd);
+    close_udp_ip_server(server_socket_fd);
+
+    cout << "UDP Domain Socket Batch Benchmark." << endl;
+    server_socket_fd = init_udp_domain_server(SOCKET_ADDR_);
+    client_socket_fd = init_udp_domain_client(SOCKET_ADDR_);
+    cout << "single: "
+         << bench_single(server_socket_fd, client_socket_fd, msgs,
+                         DOMAIN_BURST_NUM_, send_udp_domain_msg,
+                         recv_udp_domain_msg)
+         << " packets/s" << endl;
+    cout << "batch:  "
+         << bench_batch(server_socket_fd, client_socket_fd, msgs,
+                        DOMAIN_BURST_NUM_, send_udp_domain_msg_batch,
+                        recv_domain_batch)
+         << " packets/s" << endl;
+    close_udp_domain_client(client_socket_fd);
+    close_udp_domain_server(server_socket_fd);
+    remove(SOCKET_ADDR_);
+
+    for (int i = 0; i < BURST_NUM_; ++i) release_socket_message(&msgs[i]);
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <errno.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "../ip_socket/ip_socket.hpp"
+
+#define GROUP_ADDR_ "239.255.0.1"
+#define GROUP_PORT_ 1252
+#define LOOPBACK_ADDR_ "127.0.0.1"
+#define RECEIVER_NUM_ 30
+#define MSG_NUM_ 100
+#define TIMEOUT_MS_ 200
+
+using namespace std;
+
+// 组播只经过回环接口，不需要外部网络
+int main() {
+    int receivers[RECEIVER_NUM_];
+    int received[RECEIVER_NUM_];
+    char send_buf[64], recv_buf[64];
+    SocketMessage msg = {send_buf, 0};
+    SocketMessage recv_msg = {recv_buf, sizeof(recv_buf)};
+    int failed_num = 0;
+
+    cout << "UDP Multicast Test." << endl;
+    for (int i = 0; i < RECEIVER_NUM_; i++) {
+        receivers[i] = init_udp_ip_multicast_server(GROUP_ADDR_, GROUP_PORT_,
+                                                    LOOPBACK_ADDR_);
+        received[i] = 0;
+        if (receivers[i] < 0) return -1;
+    }
+    int sender = init_udp_ip_multicast_client(GROUP_ADDR_, GROUP_PORT_, 0,
+                                              true, LOOPBACK_ADDR_);
+    if (sender < 0) return -1;
+
+    // 每条消息只发送一次，所有接收端都应收到
+    for (int seq = 0; seq < MSG_NUM_; seq++) {
+        msg.len = snprintf(send_buf, sizeof(send_buf), "control %d", seq);
+        send_udp_ip_msg(sender, &msg);
+        for (int i = 0; i < RECEIVER_NUM_; i++) {
+            int ret = recv_udp_ip_msg_timeout(receivers[i], &recv_msg,
+                                              TIMEOUT_MS_);
+            if (ret == (int)msg.len && memcmp(recv_buf, send_buf, ret) == 0) {
+                received[i]++;
+            }
+        }
+    }
+    for (int i = 0; i < RECEIVER_NUM_; i++) {
+        if (received[i] != MSG_NUM_) failed_num++;
+    }
+    cout << MSG_NUM_ << " sends reached " << RECEIVER_NUM_ - failed_num
+         << " of " << RECEIVER_NUM_ << " receivers" << endl;
+
+    // 离开组播组的接收端不再收到消息
+    leave_udp_ip_multicast_group(receivers[0], GROUP_ADDR_, LOOPBACK_ADDR_);
+    msg.len = snprintf(send_buf, sizeof(send_buf), "after leave");
+    send_udp_ip_msg(sender, &msg);
+    bool left = recv_udp_ip_msg_timeout(receivers[0], &recv_msg,
+                                        TIMEOUT_MS_) < 0 &&
+                errno == ETIMEDOUT;
+    bool stayed =
+        recv_udp_ip_msg_timeout(receivers[1], &recv_msg, TIMEOUT_MS_) > 0;
+    cout << "after leave: left receiver " << (left ? "silent" : "received")
+         << ", other receivers " << (stayed ? "received" : "silent") << endl;
+
+    close_udp_ip_client(sender);
+    for (int i = 0; i < RECEIVER_NUM_; i++) close_udp_ip_server(receivers[i]);
+
+    return failed_num == 0 && left && stayed ? 0 : -1;
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../ip_socket/ip_socket.hpp"
+#include "../uring_socket/uring_socket.hpp"
+
+#define SERVER_ADDR_ "127.0.0.1"
+#define SERVER_PORT_ 1236
+#define MESSAGE_SIZE_ 64
+#define ROUND_NUM_ 100000
+#define RING_ENTRIES_ 256
+#define RING_BUFFER_NUM_ 64
+
+using namespace std;
+
+// 回显服务端，所有I/O经过指定的后端
+void echo_server(UringSocket* ring, int server_socket_fd,
+                 const SocketMessage* msg) {
+    int accept_fd = uring_accept(ring, server_socket_fd);
+    while (accept_fd >= 0) {
+        int ret = uring_recv(ring, accept_fd, msg);
+        if (ret <= 0) break;
+        SocketMessage echo;
+        echo.buf = msg->buf;
+        echo.len = ret;
+        if (uring_send(ring, accept_fd, &echo) < 0) break;
+    }
+    uring_close(ring, accept_fd);
+}
+
+double bench(const unsigned entries) {
+    UringSocket ring;
+    SocketMessage msg, server_msg;
+    acquire_socket_message(&msg, MESSAGE_SIZE_);
+    acquire_socket_message(&server_msg, MESSAGE_SIZE_);
+    msg.len = MESSAGE_SIZE_;
+
+    // 服务端的回显缓存注册为发送缓存
+    int ret = init_uring_socket(&ring, entries, MESSAGE_SIZE_,
+                                RING_BUFFER_NUM_, &server_msg, 1);
+    cout << (ret > 0 ? "io_uring:" : "blocking:") << endl;
+
+    int server_socket_fd = init_tcp_ip_server(SERVER_PORT_);
+    thread server(echo_server, &ring, server_socket_fd, &server_msg);
+    int client_socket_fd = init_tcp_ip_client(SERVER_ADDR_, SERVER_PORT_);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < ROUND_NUM_; ++i) {
+        send_tcp_ip_msg(client_socket_fd, &msg);
+        for (size_t recved = 0; recved < MESSAGE_SIZE_;) {
+            ret = recv(client_socket_fd, msg.buf, MESSAGE_SIZE_ - recved, 0);
+            if (ret <= 0) break;
+            recved += ret;
+        }
+    }
+    chrono::duration<double> cost = chrono::steady_clock::now() - start;
+
+    close(client_socket_fd);
+    server.join();
+    close_tcp_ip_server(server_socket_fd);
+    close_uring_socket(&ring);
+    release_socket_message(&msg);
+    release_socket_message(&server_msg);
+
+    return ROUND_NUM_ / cost.count();
+}
+
+int main() {
+    cout << "TCP IP Socket io_uring Benchmark." << endl;
+    double blocking = bench(0);
+    cout << "blocking: " << blocking << " round trips/s" << endl;
+    double uring = bench(RING_ENTRIES_);
+    cout << "io_uring: " << uring << " round trips/s" << endl;
+    return 0;
+}
@@ -9,113 +9,35 @@
 
 #include "domain_socket.hpp"
 
-#include <iostream>
-#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 
-std::vector<int> tcp_domain_socket_server_list;
-std::vector<int> udp_domain_socket_server_list;
+#include <cstdio>
 
-std::vector<int> tcp_domain_socket_client_list;
-std::vector<int> udp_domain_socket_client_list;
-
-///////////////////////////////////////////////////////////////////
+#include "../socket_log/socket_log.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+#include "../socket_registry/socket_registry.hpp"
 
 /**
  * @brief 初始化一个tcp域套接字服务端
- * @param  socket_addr      域套接字地址
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
+ * @param  backlog          全连接队列长度
  * @return int 域套接字服务端的socket_fd
  */
-int init_tcp_domain_server(const char *const socket_addr) {
-    int ret = 0;
-    int socket_fd = 0;
-    struct sockaddr_un server_addr;
-
-    // 1. 创建套接字
-    std::cout << "Socket create...";
-
-    socket_fd = socket(PF_UNIX, SOCK_STREAM, 0);
-
-    if (socket_fd < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    // 移除已有的域套接字路径
-    remove(socket_addr);
-
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-    server_addr.sun_family = PF_UNIX;
-    strcpy(server_addr.sun_path, socket_addr);
-
-    // 绑定套接字
-    std::cout << "Binding socket...";
-    ret = bind(socket_fd, (sockaddr *)&server_addr, sizeof(server_addr));
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    // 3. 监听套接字
-    std::cout << "Listen socket...";
-    ret = listen(socket_fd, MAX_LISTEN_NUM);  // 最大监听数量10
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    tcp_domain_socket_server_list.push_back(socket_fd);
-
-    return socket_fd;
+int init_tcp_domain_server(const char *const socket_addr, const int backlog) {
+    return TcpDomainTransport::listen_socket(socket_addr, 0, backlog);
 }
 
 /**
  * @brief 初始化一个tcp域套接字客户端
- * @param  socket_addr      域套接字地址
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
  * @return int 域套接字客户端的socket_fd
  */
 int init_tcp_domain_client(const char *const socket_addr) {
-    int socket_fd;
-    int ret = 0;
-    struct sockaddr_un server_addr;
-
-    // 1. 创建套接字
-    ret = socket_fd = socket(PF_UNIX, SOCK_STREAM, 0);
-    std::cout << "Socket create...";
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-    server_addr.sun_family = PF_UNIX;
-    strcpy(server_addr.sun_path, socket_addr);
-
-    // 2. 连接套接字
-    std::cout << "Connect socket...";
-    ret = connect(socket_fd, (sockaddr *)&server_addr, sizeof(server_addr));
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    tcp_domain_socket_client_list.push_back(socket_fd);
-
-    return socket_fd;
+    return TcpDomainTransport::connect_socket(socket_addr, 0);
 }
 
 /**
@@ -128,19 +50,16 @@ int recv_tcp_domain_msg(const int socket_fd, const SocketMessage *msg) {
     int ret = 0;
     int accept_fd = 0;
 
-    std::cout << "Waiting for new requests...";
-
     ret = accept_fd = accept(socket_fd, NULL, NULL);
 
     if (ret < 0) {
-        std::cout << "failed!" << std::endl;
+        SOCKET_LOG_ERROR("Waiting for new requests...failed!");
         return -1;
     } else {
-        std::cout << "success!" << std::endl;
+        SOCKET_LOG_DEBUG("Waiting for new requests...success!");
     }
 
-    bzero(msg->buf, msg->len);
-    ret = recv(accept_fd, msg->buf, msg->len, 0);
+    ret = TcpDomainTransport::recv_msg(accept_fd, msg, socket_fd);
     close(accept_fd);
 
     return ret;
@@ -158,23 +77,21 @@ int recv_tcp_domain_msg_durable(const int &socket_fd, int &accept_fd,
                                 const SocketMessage *msg) {
     int ret = 0;
     if (accept_fd == 0) {
-        std::cout << "Waiting for new requests...";
         ret = accept_fd = accept(socket_fd, NULL, NULL);
     }
 
     if (ret < 0) {
-        std::cout << "failed!" << std::endl;
+        SOCKET_LOG_ERROR("Waiting for new requests...failed!");
         return -1;
     } else {
-        std::cout << "success!" << std::endl;
+        SOCKET_LOG_DEBUG("Waiting for new requests...success!");
     }
 
-    bzero(msg->buf, msg->len);
-    ret = recv(accept_fd, msg->buf, msg->len, 0);
+    ret = TcpDomainTransport::recv_msg(accept_fd, msg, socket_fd);
     if (ret <= 0) {
         close(accept_fd);
         accept_fd = 0;
-        std::cout << "request has been released!" << std::endl;
+        SOCKET_LOG_DEBUG("request has been released!");
     }
     return ret;
 }
@@ -186,7 +103,111 @@ int recv_tcp_domain_msg_durable(const int &socket_fd, int &accept_fd,
  * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
  */
 int send_tcp_domain_msg(const int socket_fd, const SocketMessage *msg) {
-    return send(socket_fd, msg->buf, msg->len, 0);
+    return TcpDomainTransport::send_msg(socket_fd, msg);
+}
+
+/**
+ * @brief tcp域套接字在超时之前发出全部数据，不会因部分写入而丢弃剩余数据
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msg              需要发送数据的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果全部发出，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+ */
+int send_tcp_domain_msg_all(const int socket_fd, const SocketMessage *msg,
+                            const int timeout_ms) {
+    return TcpDomainTransport::send_msg_all(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief tcp域套接字在超时之前恰好接收msg->len字节
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msg              数据缓存的指针，缓存长度即需要接收的字节数
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果接收完整，返回接收的字节数;如果对端在收到任何数据前关闭，返回0;如果超时或数据不完整，返回-1
+ */
+int recv_tcp_domain_msg_exact(const int socket_fd, const SocketMessage *msg,
+                              const int timeout_ms) {
+    return TcpDomainTransport::recv_msg_exact(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief tcp域套接字分散接收数据，一次recvmsg依次填满各数据段
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msgs             数据段数组
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int
+ * 如果接收成功，返回接收的总字节数(可能少于各段容量之和);如果对端关闭，返回0;如果接收失败，返回-1
+ */
+int recv_tcp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num) {
+    return TcpDomainTransport::recv_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief tcp域套接字聚集发送数据，各数据段无需拼接即可一次sendmsg发出，并处理部分写入
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msgs             数据段数组，按顺序发出
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int
+ * 如果发送成功，返回发送的总字节数;如果已写出一部分后出错，返回已写出的字节数，errno保留;如果一个字节都未发出就失败，返回-1
+ */
+int send_tcp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num) {
+    return TcpDomainTransport::send_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief tcp域套接字按帧接收数据，一次recv中的多帧会依次返回，不完整的帧会等待后续数据
+ * @param  socket_fd        服务端的accept_fd或客户端的socket_fd
+ * @param  decoder          该连接的解帧器
+ * @param  frame            解出的帧，负载指向解帧器的缓存
+ * @return int 如果接收成功，返回1;如果对端关闭，返回0;如果接收失败，返回-1
+ */
+int recv_tcp_domain_frame(const int socket_fd, SocketFrameDecoder *decoder,
+                          SocketFrame *frame) {
+    return TcpDomainTransport::recv_frame(socket_fd, decoder, frame);
+}
+
+/**
+ * @brief tcp域套接字按帧发送数据，保证整帧写出
+ * @param  socket_fd        客户端的socket_fd
+ * @param  type             消息类型
+ * @param  msg              需要发送数据的指针
+ * @return int 如果发送成功，返回发送的总字节数(含帧头);如果发送失败，返回-1
+ */
+int send_tcp_domain_frame(const int socket_fd, const uint16_t type,
+                          const SocketMessage *msg) {
+    return TcpDomainTransport::send_frame(socket_fd, type, msg);
+}
+
+/**
+ * @brief tcp域套接字通过sendfile发送文件的一段，数据不经过用户态缓存
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  file_fd          需要发送的文件
+ * @param  offset           文件中的起始偏移
+ * @param  count            需要发送的字节数
+ * @return ssize_t
+ * 如果发送成功，返回发送的字节数;如果中途出错，返回已发送的字节数，可从offset加该值处续传;如果未发送就失败，返回-1
+ */
+ssize_t send_tcp_domain_file(const int socket_fd, const int file_fd,
+                             const off_t offset, const size_t count) {
+    return send_socket_file(socket_fd, file_fd, offset, count);
+}
+
+/**
+ * @brief tcp域套接字接收count字节并通过splice直接写入文件，数据不经过用户态缓存
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  file_fd          写入的文件
+ * @param  offset           文件中的起始偏移
+ * @param  count            需要接收的字节数
+ * @return ssize_t
+ * 如果接收成功，返回写入文件的字节数;如果对端提前关闭或中途出错，返回已写入的字节数;如果未写入就失败，返回-1
+ */
+ssize_t recv_tcp_domain_file(const int socket_fd, const int file_fd,
+                             const off_t offset, const size_t count) {
+    return recv_socket_file(socket_fd, file_fd, offset, count);
 }
 
 /**
@@ -195,19 +216,7 @@ int send_tcp_domain_msg(const int socket_fd, const SocketMessage *msg) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_tcp_domain_server(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = tcp_domain_socket_server_list.begin();
-         it != tcp_domain_socket_server_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > tcp_domain_socket_server_list.size()) return -1;
-    close(socket_fd);
-
-    tcp_domain_socket_server_list.erase(it);
-
-    return 1;
+    return TcpDomainTransport::close_server(socket_fd);
 }
 
 /**
@@ -216,108 +225,27 @@ int close_tcp_domain_server(const int socket_fd) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_tcp_domain_client(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = tcp_domain_socket_client_list.begin();
-         it != tcp_domain_socket_client_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > tcp_domain_socket_client_list.size()) return -1;
-    close(socket_fd);
-
-    tcp_domain_socket_client_list.erase(it);
-
-    return 1;
+    return TcpDomainTransport::close_client(socket_fd);
 }
 
 ///////////////////////////////////////////////////////////////////
 
 /**
  * @brief 初始化一个udp域套接字服务端
- * @param  socket_addr      域套接字地址
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
  * @return int udp域套接字服务端的socket_fd
  */
 int init_udp_domain_server(const char *const socket_addr) {
-    int ret = 0;
-    struct sockaddr_un server_addr;
-    int socket_fd = 0;
-
-    // 1. 创建套接字
-    std::cout << "Socket create...";
-
-    socket_fd = socket(PF_UNIX, SOCK_DGRAM, 0);
-
-    if (socket_fd < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    // 移除已有的域套接字路径
-    remove(socket_addr);
-
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-    server_addr.sun_family = PF_UNIX;
-    strcpy(server_addr.sun_path, socket_addr);
-
-    // 2. 绑定套接字
-    std::cout << "Binding socket...";
-    ret = bind(socket_fd, (sockaddr *)&server_addr, sizeof(server_addr));
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    udp_domain_socket_server_list.push_back(socket_fd);
-
-    return socket_fd;
+    return UdpDomainTransport::bind_server(socket_addr, 0);
 }
 
 /**
  * @brief 初始化一个udp域套接字客户端
- * @param  socket_addr      域套接字地址
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
  * @return int udp域套接字客户端的socket_fd
  */
 int init_udp_domain_client(const char *const socket_addr) {
-    int socket_fd;
-    int ret = 0;
-    struct sockaddr_un server_addr;
-
-    // 1. 创建套接字
-    ret = socket_fd = socket(PF_UNIX, SOCK_DGRAM, 0);
-    std::cout << "Socket create...";
-    if (ret == -1) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-    server_addr.sun_family = PF_UNIX;
-    strcpy(server_addr.sun_path, socket_addr);
-
-    // 2. 连接套接字
-    std::cout << "Connect socket...";
-    ret = connect(socket_fd, (sockaddr *)&server_addr, sizeof(server_addr));
-
-    if (ret == -1) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    udp_domain_socket_client_list.push_back(socket_fd);
-
-    return socket_fd;
+    return UdpDomainTransport::connect_socket(socket_addr, 0);
 }
 
 /**
@@ -327,8 +255,7 @@ int init_udp_domain_client(const char *const socket_addr) {
  * @return int 如果接收成功，返回接收的字节数;如果接收失败，返回-1
  */
 int recv_udp_domain_msg(const int socket_fd, const SocketMessage *msg) {
-    bzero(msg->buf, msg->len);
-    return recvfrom(socket_fd, msg->buf, msg->len, 0, NULL, NULL);
+    return UdpDomainTransport::recv_msg(socket_fd, msg);
 }
 
 /**
@@ -338,7 +265,85 @@ int recv_udp_domain_msg(const int socket_fd, const SocketMessage *msg) {
  * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
  */
 int send_udp_domain_msg(const int socket_fd, const SocketMessage *msg) {
-    return sendto(socket_fd, msg->buf, msg->len, 0, NULL, NULL);
+    return UdpDomainTransport::send_msg(socket_fd, msg);
+}
+
+/**
+ * @brief udp域套接字服务端在超时之前接收一个报文
+ * @param  socket_fd        udp域套接字服务端的socket_fd
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果接收成功，返回接收的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果接收失败，返回-1
+ */
+int recv_udp_domain_msg_timeout(const int socket_fd, const SocketMessage *msg,
+                                const int timeout_ms) {
+    return UdpDomainTransport::recv_msg_timeout(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief udp域套接字客户端在超时之前发出一个报文，发送缓存已满时等待而不是阻塞
+ * @param  socket_fd        udp域套接字客户端的socket_fd
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果发送成功，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+ */
+int send_udp_domain_msg_timeout(const int socket_fd, const SocketMessage *msg,
+                                const int timeout_ms) {
+    return UdpDomainTransport::send_msg_timeout(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief udp域套接字服务端分散接收一个报文，报文依次填入各数据段
+ * @param  socket_fd        udp域套接字服务端的socket_fd
+ * @param  msgs             数据段数组
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int
+ * 如果接收成功，返回报文的字节数;如果接收失败或报文超过各段容量之和被截断，返回-1
+ */
+int recv_udp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num) {
+    return UdpDomainTransport::recv_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief udp域套接字客户端聚集发送数据，所有数据段作为一个报文发出
+ * @param  socket_fd        udp域套接字客户端的socket_fd
+ * @param  msgs             数据段数组，按顺序拼成一个报文
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
+ */
+int send_udp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num) {
+    return UdpDomainTransport::send_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief udp域套接字服务端批量接收数据，一次recvmmsg最多接收MAX_UDP_BATCH_NUM个报文
+ * @param  socket_fd        udp域套接字服务端的socket_fd
+ * @param  msgs             数据缓存数组，每个元素接收一个报文
+ * @param  lens             输出每个报文的实际长度
+ * @param  src_addrs        输出每个报文的来源地址，可以为NULL
+ * @param  num              数据缓存数组的长度
+ * @return int
+ * 如果接收成功，返回接收的报文数(至少为1，阻塞直到第一个报文到达);如果接收失败，返回-1
+ */
+int recv_udp_domain_msg_batch(const int socket_fd, const SocketMessage *msgs,
+                              int *lens, struct sockaddr_un *src_addrs,
+                              const uint num) {
+    return UdpDomainTransport::recv_msg_batch(socket_fd, msgs, lens, src_addrs,
+                                              num);
+}
+
+/**
+ * @brief udp域套接字客户端批量发送数据，每MAX_UDP_BATCH_NUM个报文一次sendmmsg
+ * @param  socket_fd        udp域套接字客户端的socket_fd
+ * @param  msgs             需要发送的数据数组，每个元素作为一个报文
+ * @param  num              数据数组的长度
+ * @return int 如果发送成功，返回发送的报文数;如果一个也没有发出，返回-1
+ */
+int send_udp_domain_msg_batch(const int socket_fd, const SocketMessage *msgs,
+                              const uint num) {
+    return UdpDomainTransport::send_msg_batch(socket_fd, msgs, num);
 }
 
 /**
@@ -347,19 +352,7 @@ int send_udp_domain_msg(const int socket_fd, const SocketMessage *msg) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_udp_domain_server(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = udp_domain_socket_server_list.begin();
-         it != udp_domain_socket_server_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > udp_domain_socket_server_list.size()) return -1;
-    close(socket_fd);
-
-    udp_domain_socket_server_list.erase(it);
-
-    return 1;
+    return UdpDomainTransport::close_server(socket_fd);
 }
 
 /**
@@ -368,17 +361,221 @@ int close_udp_domain_server(const int socket_fd) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_udp_domain_client(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = udp_domain_socket_client_list.begin();
-         it != udp_domain_socket_client_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
+    return UdpDomainTransport::close_client(socket_fd);
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 初始化一个seqpacket域套接字服务端，连接上的每次发送都是一条有边界的记录
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
+ * @param  backlog          全连接队列长度
+ * @return int seqpacket域套接字服务端的socket_fd
+ */
+int init_seqpacket_domain_server(const char *const socket_addr,
+                                 const int backlog) {
+    return SeqpacketDomainTransport::listen_socket(socket_addr, 0, backlog);
+}
+
+/**
+ * @brief 初始化一个seqpacket域套接字客户端
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
+ * @return int seqpacket域套接字客户端的socket_fd
+ */
+int init_seqpacket_domain_client(const char *const socket_addr) {
+    return SeqpacketDomainTransport::connect_socket(socket_addr, 0);
+}
+
+/**
+ * @brief 在seqpacket连接上接收一条完整的记录，不需要长度前缀与重组
+ * @param  socket_fd        已连接的seqpacket套接字
+ * @param  msg              数据缓存的指针
+ * @return int 如果接收成功，返回记录的字节数;如果对端关闭，返回0;
+ * 如果记录超过缓存，剩余部分被内核丢弃，返回-1并置errno为EMSGSIZE;如果接收失败，返回-1
+ */
+int recv_seqpacket_domain_msg(const int socket_fd, const SocketMessage *msg) {
+    return SeqpacketDomainTransport::recv_msg(socket_fd, msg);
+}
+
+/**
+ * @brief 在seqpacket连接上发送一条记录，一次调用只会整条发出或失败
+ * @param  socket_fd        已连接的seqpacket套接字
+ * @param  msg              数据缓存的指针
+ * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
+ */
+int send_seqpacket_domain_msg(const int socket_fd, const SocketMessage *msg) {
+    return SeqpacketDomainTransport::send_msg(socket_fd, msg);
+}
+
+/**
+ * @brief 关闭一个seqpacket域套接字服务端
+ * @param  socket_fd        被关闭seqpacket域套接字服务端的socket_fd
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_seqpacket_domain_server(const int socket_fd) {
+    return SeqpacketDomainTransport::close_server(socket_fd);
+}
+
+/**
+ * @brief 关闭一个seqpacket域套接字客户端
+ * @param  socket_fd        被关闭seqpacket域套接字客户端的socket_fd
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_seqpacket_domain_client(const int socket_fd) {
+    return SeqpacketDomainTransport::close_client(socket_fd);
+}
+
+///////////////////////////////////////////////////////////////////
 
-    if (i > udp_domain_socket_client_list.size()) return -1;
-    close(socket_fd);
+/**
+ * @brief 申请一块基于memfd的共享消息，生产者直接在msg->buf中写入负载
+ * @param  msg              申请到的共享消息
+ * @param  len              负载长度
+ * @return int 如果申请成功，返回1;如果申请失败，返回-1
+ */
+int alloc_domain_shared_msg(SharedMessage *msg, const size_t len) {
+    msg->memfd =
+        memfd_create("domain_shared_msg", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    msg->buf = NULL;
+    msg->len = len;
+    if (msg->memfd < 0) return -1;
+
+    if (ftruncate(msg->memfd, len) < 0) {
+        release_domain_shared_msg(msg);
+        return -1;
+    }
 
-    udp_domain_socket_client_list.erase(it);
+    void *addr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      msg->memfd, 0);
+    if (addr == MAP_FAILED) {
+        release_domain_shared_msg(msg);
+        return -1;
+    }
+    msg->buf = (char *)addr;
+
+    return 1;
+}
+
+/**
+ * @brief
+ * 封存共享消息并通过SCM_RIGHTS把memfd发给对端，只传递fd与长度，负载不经过套接字拷贝;
+ * 发送后本进程不再持有该消息
+ * @param  socket_fd        域套接字(流式或数据报均可)
+ * @param  msg              由alloc_domain_shared_msg申请的共享消息
+ * @return int 如果发送成功，返回负载长度;如果发送失败，返回-1
+ */
+int send_domain_shared_msg(const int socket_fd, SharedMessage *msg) {
+    uint64_t len = msg->len;
+    struct msghdr hdr;
+    struct iovec iov;
+    char control[CMSG_SPACE(sizeof(int))];
+    int ret = 0;
+
+    // 封存前必须解除可写映射，封存后对端无需担心内容被改写或截断
+    if (msg->buf != NULL) munmap(msg->buf, msg->len);
+    msg->buf = NULL;
+    if (fcntl(msg->memfd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0) {
+        release_domain_shared_msg(msg);
+        return -1;
+    }
+
+    iov.iov_base = &len;
+    iov.iov_len = sizeof(len);
+    bzero(&hdr, sizeof(hdr));
+    bzero(control, sizeof(control));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &msg->memfd, sizeof(int));
+
+    ret = sendmsg(socket_fd, &hdr, 0);
+    release_domain_shared_msg(msg);
+
+    return ret == sizeof(len) ? (int)len : -1;
+}
+
+/**
+ * @brief 接收对端发来的memfd并只读映射，负载不经过套接字拷贝
+ * @param  socket_fd        域套接字(流式或数据报均可)
+ * @param  msg              接收到的共享消息，使用完毕后调用release_domain_shared_msg
+ * @return int
+ * 如果接收成功，返回负载长度;如果对端关闭，返回0;如果接收失败或memfd未封存，返回-1
+ */
+int recv_domain_shared_msg(const int socket_fd, SharedMessage *msg) {
+    uint64_t len = 0;
+    struct msghdr hdr;
+    struct iovec iov;
+    struct stat file_stat;
+    char control[CMSG_SPACE(sizeof(int))];
+    int ret = 0;
+    const int required_seals = F_SEAL_SHRINK | F_SEAL_WRITE;
+
+    msg->memfd = -1;
+    msg->buf = NULL;
+    msg->len = 0;
+
+    iov.iov_base = &len;
+    iov.iov_len = sizeof(len);
+    bzero(&hdr, sizeof(hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    ret = recvmsg(socket_fd, &hdr, MSG_WAITALL | MSG_CMSG_CLOEXEC);
+    if (ret <= 0) return ret;
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+    if (cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET &&
+        cmsg->cmsg_type == SCM_RIGHTS) {
+        memcpy(&msg->memfd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    if (ret != sizeof(len) || msg->memfd < 0 ||
+        (hdr.msg_flags & MSG_CTRUNC)) {
+        release_domain_shared_msg(msg);
+        return -1;
+    }
+
+    // 未封存的memfd可能被发送方截断，映射后访问会触发SIGBUS
+    int seals = fcntl(msg->memfd, F_GET_SEALS);
+    if (seals < 0 || (seals & required_seals) != required_seals ||
+        fstat(msg->memfd, &file_stat) < 0 ||
+        (uint64_t)file_stat.st_size < len) {
+        release_domain_shared_msg(msg);
+        return -1;
+    }
+
+    msg->len = len;
+    if (len > 0) {
+        void *addr = mmap(NULL, len, PROT_READ, MAP_SHARED, msg->memfd, 0);
+        if (addr == MAP_FAILED) {
+            release_domain_shared_msg(msg);
+            return -1;
+        }
+        msg->buf = (char *)addr;
+    }
+
+    return len;
+}
+
+/**
+ * @brief 释放共享消息的映射与memfd
+ * @param  msg              共享消息
+ * @return int 释放成功，返回1
+ */
+int release_domain_shared_msg(SharedMessage *msg) {
+    if (msg->buf != NULL) munmap(msg->buf, msg->len);
+    if (msg->memfd >= 0) close(msg->memfd);
+    msg->buf = NULL;
+    msg->memfd = -1;
+    msg->len = 0;
 
     return 1;
 }
@@ -390,14 +587,7 @@ int close_udp_domain_client(const int socket_fd) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_tcp_domain_server() {
-    std::vector<int>::iterator it;
-    for (it = tcp_domain_socket_server_list.begin();
-         it != tcp_domain_socket_server_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        tcp_domain_socket_server_list.erase(it);
-    };
-
-    return 1;
+    return TcpDomainTransport::close_all_server();
 }
 
 /**
@@ -405,14 +595,7 @@ int close_all_tcp_domain_server() {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_tcp_domain_client() {
-    std::vector<int>::iterator it;
-    for (it = tcp_domain_socket_client_list.begin();
-         it != tcp_domain_socket_client_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        tcp_domain_socket_client_list.erase(it);
-    };
-
-    return 1;
+    return TcpDomainTransport::close_all_client();
 }
 
 /**
@@ -420,14 +603,7 @@ int close_all_tcp_domain_client() {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_udp_domain_server() {
-    std::vector<int>::iterator it;
-    for (it = udp_domain_socket_server_list.begin();
-         it != udp_domain_socket_server_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        udp_domain_socket_server_list.erase(it);
-    };
-
-    return 1;
+    return UdpDomainTransport::close_all_server();
 }
 
 /**
@@ -435,12 +611,21 @@ int close_all_udp_domain_server() {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_udp_domain_client() {
-    std::vector<int>::iterator it;
-    for (it = udp_domain_socket_client_list.begin();
-         it != udp_domain_socket_client_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        udp_domain_socket_client_list.erase(it);
-    };
+    return UdpDomainTransport::close_all_client();
+}
 
-    return 1;
+/**
+ * @brief 关闭所有seqpacket域套接字的服务端
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_all_seqpacket_domain_server() {
+    return SeqpacketDomainTransport::close_all_server();
+}
+
+/**
+ * @brief 关闭所有seqpacket域套接字的客户端
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_all_seqpacket_domain_client() {
+    return SeqpacketDomainTransport::close_all_client();
 }
\ No newline at end of file
@@ -6,20 +6,49 @@
  * @date 2021-05-15
  */
 
+#ifndef DOMAIN_SOCKET_HPP_
+#define DOMAIN_SOCKET_HPP_
+
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include "../file_transfer/file_transfer.hpp"
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_frame/socket_frame.hpp"
 #include "../socket_message.hpp"
+#include "../socket_transport/socket_transport.hpp"
 
-#define MAX_LISTEN_NUM 10
+// 通过memfd共享的消息，buf为memfd在本进程中的映射
+typedef struct SharedMessage {
+    int memfd;
+    char *buf;
+    size_t len;
+} SharedMessage;
 
-int init_tcp_domain_server(const char *const socket_addr);
+int init_tcp_domain_server(const char *const socket_addr,
+                           const int backlog = MAX_LISTEN_NUM);
 int init_tcp_domain_client(const char *const socket_addr);
 int recv_tcp_domain_msg(const int socket_fd, const SocketMessage *msg);
 int recv_tcp_domain_msg_durable(const int &socket_fd, int &accept_fd,
                                 const SocketMessage *msg);
 int send_tcp_domain_msg(const int socket_fd, const SocketMessage *msg);
+int send_tcp_domain_msg_all(const int socket_fd, const SocketMessage *msg,
+                            const int timeout_ms);
+int recv_tcp_domain_msg_exact(const int socket_fd, const SocketMessage *msg,
+                              const int timeout_ms);
+int recv_tcp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num);
+int send_tcp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num);
+int recv_tcp_domain_frame(const int socket_fd, SocketFrameDecoder *decoder,
+                          SocketFrame *frame);
+int send_tcp_domain_frame(const int socket_fd, const uint16_t type,
+                          const SocketMessage *msg);
+ssize_t send_tcp_domain_file(const int socket_fd, const int file_fd,
+                             const off_t offset, const size_t count);
+ssize_t recv_tcp_domain_file(const int socket_fd, const int file_fd,
+                             const off_t offset, const size_t count);
 int close_tcp_domain_server(const int socket_fd);
 int close_tcp_domain_client(const int socket_fd);
 
@@ -27,10 +56,40 @@ int init_udp_domain_server(const char *const socket_addr);
 int init_udp_domain_client(const char *const socket_addr);
 int recv_udp_domain_msg(const int socket_fd, const SocketMessage *msg);
 int send_udp_domain_msg(const int socket_fd, const SocketMessage *msg);
+int send_udp_domain_msg_timeout(const int socket_fd, const SocketMessage *msg,
+                                const int timeout_ms);
+int recv_udp_domain_msg_timeout(const int socket_fd, const SocketMessage *msg,
+                                const int timeout_ms);
+int recv_udp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num);
+int send_udp_domain_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num);
+int recv_udp_domain_msg_batch(const int socket_fd, const SocketMessage *msgs,
+                              int *lens, struct sockaddr_un *src_addrs,
+                              const uint num);
+int send_udp_domain_msg_batch(const int socket_fd, const SocketMessage *msgs,
+                              const uint num);
 int close_udp_domain_server(const int socket_fd);
 int close_udp_domain_client(const int socket_fd);
 
+int init_seqpacket_domain_server(const char *const socket_addr,
+                                 const int backlog = MAX_LISTEN_NUM);
+int init_seqpacket_domain_client(const char *const socket_addr);
+int recv_seqpacket_domain_msg(const int socket_fd, const SocketMessage *msg);
+int send_seqpacket_domain_msg(const int socket_fd, const SocketMessage *msg);
+int close_seqpacket_domain_server(const int socket_fd);
+int close_seqpacket_domain_client(const int socket_fd);
+
+int alloc_domain_shared_msg(SharedMessage *msg, const size_t len);
+int send_domain_shared_msg(const int socket_fd, SharedMessage *msg);
+int recv_domain_shared_msg(const int socket_fd, SharedMessage *msg);
+int release_domain_shared_msg(SharedMessage *msg);
+
 int close_all_tcp_domain_server();
 int close_all_tcp_domain_client();
 int close_all_udp_domain_server();
 int close_all_udp_domain_client();
+int close_all_seqpacket_domain_server();
+int close_all_seqpacket_domain_client();
+
+#endif  // DOMAIN_SOCKET_HPP_
@@ -0,0 +1,354 @@
+/**
+ * @file event_loop.cpp
+ * @brief
+ * 实现了基于epoll边沿触发的事件循环，单个线程即可同时服务监听套接字与大量已建立的连接。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "event_loop.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <strings.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../socket_log/socket_log.hpp"
+
+/**
+ * @brief 将套接字设置为非阻塞模式，边沿触发要求读写不能阻塞
+ * @param  fd               需要设置的套接字
+ * @return int 如果设置成功，返回1;如果设置失败，返回-1
+ */
+static int set_nonblocking(const int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) return -1;
+    if (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) return -1;
+    return 1;
+}
+
+/**
+ * @brief 接受监听套接字上所有等待中的连接，边沿触发下必须一直accept到EAGAIN
+ * @param  loop             事件循环
+ */
+static void accept_all(SocketEventLoop *loop) {
+    while (1) {
+        int accept_fd = accept(loop->listen_fd, NULL, NULL);
+        if (accept_fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                SOCKET_LOG_ERROR("Accept request...failed!");
+            }
+            return;
+        }
+        if (add_socket_event_loop_fd(loop, accept_fd) < 0) close(accept_fd);
+    }
+}
+
+/**
+ * @brief 读取连接上所有可读的数据并交给回调函数处理
+ * @param  loop             事件循环
+ * @param  accept_fd        可读的连接
+ * @param  msg              接收数据的缓存
+ */
+static void read_all(SocketEventLoop *loop, const int accept_fd,
+                     const SocketMessage *msg) {
+    SocketMessage data;
+    data.buf = msg->buf;
+
+    while (1) {
+        ssize_t ret = recv(accept_fd, msg->buf, msg->len, 0);
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+
+        // 对端关闭或出错时以长度0通知回调，随后释放连接
+        data.len = ret > 0 ? ret : 0;
+        if (loop->on_read(accept_fd, &data, loop->user_data) < 0 || ret <= 0) {
+            remove_socket_event_loop_fd(loop, accept_fd);
+            return;
+        }
+        // 回调中可能已经调用remove_socket_event_loop_fd关闭了连接
+        if (loop->closed_fds.count(accept_fd) > 0) return;
+    }
+}
+
+/**
+ * @brief 更新连接关注的事件，发送队列中有未写出的消息时才关注EPOLLOUT
+ * @param  loop             事件循环
+ * @param  accept_fd        连接
+ * @param  queue            该连接的发送队列
+ * @return int 如果更新成功，返回1;如果更新失败，返回-1
+ */
+static int update_write_event(SocketEventLoop *loop, const int accept_fd,
+                              const SocketSendQueue *queue) {
+    struct epoll_event event;
+    bool want_write = !queue->msgs.empty();
+
+    if (want_write == (loop->write_fds.count(accept_fd) > 0)) return 1;
+
+    bzero(&event, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET |
+                   (want_write ? (uint32_t)EPOLLOUT : 0u);
+    event.data.fd = accept_fd;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_MOD, accept_fd, &event) < 0) {
+        return -1;
+    }
+
+    if (want_write) {
+        loop->write_fds.insert(accept_fd);
+    } else {
+        loop->write_fds.erase(accept_fd);
+    }
+    return 1;
+}
+
+/**
+ * @brief 连接可写时写出发送队列中排队的消息
+ * @param  loop             事件循环
+ * @param  accept_fd        可写的连接
+ * @return int 如果写出成功或发送缓存已满，返回1;如果连接出错，返回-1
+ */
+static int write_all(SocketEventLoop *loop, const int accept_fd) {
+    std::unordered_map<int, SocketSendQueue *>::iterator it =
+        loop->send_queues.find(accept_fd);
+    if (it == loop->send_queues.end()) return 1;
+
+    if (flush_socket_send_queue(it->second) < 0) return -1;
+    return update_write_event(loop, accept_fd, it->second);
+}
+
+/**
+ * @brief 初始化一个事件循环
+ * @param  loop             需要初始化的事件循环
+ * @param  listen_fd
+ * 由init_tcp_ip_server或init_tcp_domain_server创建的监听套接字;小于0表示只管理已有连接
+ * @param  on_read          连接可读时的回调函数
+ * @param  user_data        传给回调函数的用户指针
+ * @param  send_config      每个连接发送队列的配置，为NULL时使用默认配置
+ * @return int 如果初始化成功，返回epoll_fd;如果初始化失败，返回-1
+ */
+int init_socket_event_loop(SocketEventLoop *loop, const int listen_fd,
+                           SocketReadCallback on_read, void *user_data,
+                           const SocketSendQueueConfig *send_config) {
+    struct epoll_event event;
+
+    loop->listen_fd = listen_fd;
+    loop->on_read = on_read;
+    loop->user_data = user_data;
+    loop->running = true;
+    loop->accept_fds.clear();
+    loop->send_queues.clear();
+    loop->write_fds.clear();
+    loop->closed_fds.clear();
+    if (send_config == NULL) {
+        get_default_socket_send_queue_config(&loop->send_config);
+    } else {
+        loop->send_config = *send_config;
+    }
+
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->epoll_fd < 0 || loop->wake_fd < 0) {
+        SOCKET_LOG_ERROR("Epoll create...failed!");
+        close_socket_event_loop(loop);
+        return -1;
+    } else {
+        SOCKET_LOG_DEBUG("Epoll create...success!");
+    }
+
+    bzero(&event, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = loop->wake_fd;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &event) < 0) {
+        close_socket_event_loop(loop);
+        return -1;
+    }
+
+    if (listen_fd >= 0) {
+        event.events = EPOLLIN | EPOLLET;
+        event.data.fd = listen_fd;
+        if (set_nonblocking(listen_fd) < 0 ||
+            epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) < 0) {
+            close_socket_event_loop(loop);
+            return -1;
+        }
+    }
+
+    return loop->epoll_fd;
+}
+
+/**
+ * @brief 将一个已建立的连接加入事件循环
+ * @param  loop             事件循环
+ * @param  accept_fd        已建立的连接
+ * @return int 如果加入成功，返回1;如果加入失败，返回-1
+ */
+int add_socket_event_loop_fd(SocketEventLoop *loop, const int accept_fd) {
+    struct epoll_event event;
+    bzero(&event, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.fd = accept_fd;
+
+    if (set_nonblocking(accept_fd) < 0) return -1;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, accept_fd, &event) < 0) {
+        return -1;
+    }
+
+    loop->accept_fds.insert(accept_fd);
+    return 1;
+}
+
+/**
+ * @brief 将一个连接移出事件循环并关闭;发送队列中的消息先以不阻塞的方式再写出一次，仍未写出的被丢弃并记录日志
+ * @param  loop             事件循环
+ * @param  accept_fd        需要关闭的连接
+ * @return int 如果关闭成功，返回1;如果该连接不属于此事件循环，返回-1
+ */
+int remove_socket_event_loop_fd(SocketEventLoop *loop, const int accept_fd) {
+    if (loop->accept_fds.erase(accept_fd) == 0) return -1;
+
+    std::unordered_map<int, SocketSendQueue *>::iterator it =
+        loop->send_queues.find(accept_fd);
+    if (it != loop->send_queues.end()) {
+        SocketSendQueue *queue = it->second;
+        if (!queue->msgs.empty() && flush_socket_send_queue(queue) != 1) {
+            SOCKET_LOG_WARN("Connection %d closed with %zu bytes unsent!",
+                            accept_fd, queue->bytes);
+        }
+        close_socket_send_queue(queue);
+        delete it->second;
+        loop->send_queues.erase(it);
+    }
+    loop->write_fds.erase(accept_fd);
+    loop->closed_fds.insert(accept_fd);
+
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, accept_fd, NULL);
+    close(accept_fd);
+
+    return 1;
+}
+
+/**
+ * @brief
+ * 通过连接的发送队列发送一条消息，写不完的部分在连接可写时由事件循环写出，只能在事件循环的线程中调用
+ * @param  loop             事件循环
+ * @param  accept_fd        事件循环中的连接
+ * @param  msg              需要发送的消息，返回后即可重用
+ * @return int
+ * 如果已写出或已排队，返回1;如果发送队列处于背压，返回-1并置errno为EAGAIN;如果连接不属于此事件循环或出错，返回-1
+ */
+int send_socket_event_loop_msg(SocketEventLoop *loop, const int accept_fd,
+                               const SocketMessage *msg) {
+    if (loop->accept_fds.count(accept_fd) == 0) {
+        errno = EBADF;
+        return -1;
+    }
+
+    SocketSendQueue *&queue = loop->send_queues[accept_fd];
+    if (queue == NULL) {
+        queue = new SocketSendQueue;
+        if (init_socket_send_queue(queue, accept_fd, &loop->send_config) <
+            0) {
+            delete queue;
+            loop->send_queues.erase(accept_fd);
+            return -1;
+        }
+    }
+
+    int ret = push_socket_send_queue(queue, msg);
+    if (update_write_event(loop, accept_fd, queue) < 0) return -1;
+
+    return ret;
+}
+
+/**
+ * @brief 运行事件循环，直到stop_socket_event_loop被调用
+ * @param  loop             事件循环
+ * @param  msg              接收数据的缓存，所有连接共用
+ * @return int 如果正常退出，返回1;如果epoll_wait出错，返回-1
+ */
+int run_socket_event_loop(SocketEventLoop *loop, const SocketMessage *msg) {
+    struct epoll_event events[MAX_EVENT_NUM];
+
+    while (loop->running) {
+        int num = epoll_wait(loop->epoll_fd, events, MAX_EVENT_NUM, -1);
+        if (num < 0) {
+            if (errno == EINTR) continue;
+            loop->running = false;
+            return -1;
+        }
+
+        // 同一批事件中，先处理的事件可能已关闭某个连接，accept_all还可能复用了它的fd，
+        // 因此已关闭或不属于此事件循环的连接跳过其余事件，新连接的事件在下一批中报告
+        loop->closed_fds.clear();
+        for (int i = 0; i < num; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == loop->wake_fd) {
+                uint64_t count;
+                while (read(loop->wake_fd, &count, sizeof(count)) > 0) {
+                }
+            } else if (fd == loop->listen_fd) {
+                accept_all(loop);
+            } else if (loop->closed_fds.count(fd) > 0 ||
+                       loop->accept_fds.count(fd) == 0) {
+                continue;
+            } else {
+                // 先写出排队的消息，连接出错时不再读取
+                if ((events[i].events & EPOLLOUT) && write_all(loop, fd) < 0) {
+                    remove_socket_event_loop_fd(loop, fd);
+                    continue;
+                }
+                if (events[i].events & ~EPOLLOUT) read_all(loop, fd, msg);
+            }
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 停止事件循环，可以在其他线程或回调函数中调用，在事件循环运行前调用同样有效
+ * @param  loop             事件循环
+ * @return int 如果唤醒成功，返回1;如果唤醒失败，返回-1
+ */
+int stop_socket_event_loop(SocketEventLoop *loop) {
+    uint64_t one = 1;
+    loop->running = false;
+    if (write(loop->wake_fd, &one, sizeof(one)) < 0) return -1;
+    return 1;
+}
+
+/**
+ * @brief
+ * 关闭事件循环及其管理的所有连接，监听套接字仍由close_tcp_*_server负责关闭
+ * @param  loop             事件循环
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_socket_event_loop(SocketEventLoop *loop) {
+    int ret = 1;
+    std::set<int>::iterator it;
+    for (it = loop->accept_fds.begin(); it != loop->accept_fds.end(); ++it) {
+        if (close(*it) < 0) ret = -1;
+    }
+    loop->accept_fds.clear();
+
+    std::unordered_map<int, SocketSendQueue *>::iterator queue_it;
+    for (queue_it = loop->send_queues.begin();
+         queue_it != loop->send_queues.end(); ++queue_it) {
+        close_socket_send_queue(queue_it->second);
+        delete queue_it->second;
+    }
+    loop->send_queues.clear();
+    loop->write_fds.clear();
+    loop->closed_fds.clear();
+
+    if (loop->wake_fd >= 0) close(loop->wake_fd);
+    if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+    loop->wake_fd = -1;
+    loop->epoll_fd = -1;
+
+    return ret;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file event_loop.hpp
+ * @brief 声名了基于epoll边沿触发的多连接事件循环
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef EVENT_LOOP_HPP_
+#define EVENT_LOOP_HPP_
+
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <set>
+#include <unordered_map>
+
+#include "../socket_message.hpp"
+#include "../socket_send_queue/socket_send_queue.hpp"
+
+#define MAX_EVENT_NUM 256  // 单次epoll_wait最多处理的事件数量
+
+/**
+ * @brief 连接可读时的回调函数
+ * @param  accept_fd        产生数据的连接
+ * @param  msg              本次接收到的数据，msg->len为接收的字节数;
+ * 为0表示对端已关闭连接
+ * @param  user_data        用户在初始化事件循环时传入的指针
+ * @return int 返回值小于0时，事件循环主动关闭该连接
+ */
+typedef int (*SocketReadCallback)(const int accept_fd, const SocketMessage *msg,
+                                  void *user_data);
+
+typedef struct SocketEventLoop {
+    int epoll_fd;
+    int listen_fd;
+    int wake_fd;  // 用于从其他线程唤醒epoll_wait的eventfd
+    SocketReadCallback on_read;
+    void *user_data;
+    std::atomic<bool> running;
+    std::set<int> accept_fds;
+    SocketSendQueueConfig send_config;
+    std::unordered_map<int, SocketSendQueue *> send_queues;  // 第一次发送时创建
+    std::set<int> write_fds;   // 关注EPOLLOUT的连接
+    std::set<int> closed_fds;  // 本批事件中已关闭的连接，其余事件不再分发
+} SocketEventLoop;
+
+int init_socket_event_loop(SocketEventLoop *loop, const int listen_fd,
+                           SocketReadCallback on_read, void *user_data,
+                           const SocketSendQueueConfig *send_config = NULL);
+int add_socket_event_loop_fd(SocketEventLoop *loop, const int accept_fd);
+int remove_socket_event_loop_fd(SocketEventLoop *loop, const int accept_fd);
+int send_socket_event_loop_msg(SocketEventLoop *loop, const int accept_fd,
+                               const SocketMessage *msg);
+int run_socket_event_loop(SocketEventLoop *loop, const SocketMessage *msg);
+int stop_socket_event_loop(SocketEventLoop *loop);
+int close_socket_event_loop(SocketEventLoop *loop);
+
+#endif  // EVENT_LOOP_HPP_
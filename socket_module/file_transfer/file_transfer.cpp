@@ -0,0 +1,97 @@
+/**
+ * @file file_transfer.cpp
+ * @brief
+ * 实现了流式套接字与文件之间的零拷贝传输。发送端使用sendfile，接收端经由管道splice到文件，
+ * 数据全程不经过用户态缓存。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "file_transfer.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+/**
+ * @brief 将文件的一段通过sendfile发往套接字，处理部分写入
+ * @param  socket_fd        tcp客户端的socket_fd或服务端的accept_fd
+ * @param  file_fd          需要发送的文件
+ * @param  offset           文件中的起始偏移，不改变file_fd的读写位置
+ * @param  count            需要发送的字节数
+ * @return ssize_t
+ * 如果发送成功，返回发送的字节数;如果文件提前结束或中途出错，返回已发送的字节数，调用方可从offset加该值处续传，
+ * 出错时errno保留;如果一个字节都未发送就失败，返回-1
+ */
+ssize_t send_socket_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count) {
+    off_t pos = offset;
+    size_t sent = 0;
+
+    while (sent < count) {
+        ssize_t ret = sendfile(socket_fd, file_fd, &pos, count - sent);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            return sent > 0 ? (ssize_t)sent : -1;
+        }
+        if (ret == 0) break;
+        sent += ret;
+    }
+
+    return sent;
+}
+
+/**
+ * @brief 从套接字接收count字节并经由管道splice写入文件
+ * @param  socket_fd        tcp客户端的socket_fd或服务端的accept_fd
+ * @param  file_fd          写入的文件
+ * @param  offset           文件中的起始偏移，不改变file_fd的读写位置
+ * @param  count            需要接收的字节数
+ * @return ssize_t
+ * 如果接收成功，返回写入文件的字节数;如果对端提前关闭或中途出错，返回已写入文件的字节数，出错时errno保留;
+ * 如果一个字节都未写入就失败，返回-1
+ */
+ssize_t recv_socket_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count) {
+    int pipe_fd[2];
+    loff_t pos = offset;
+    size_t recved = 0;
+    ssize_t ret = 0;
+
+    if (pipe2(pipe_fd, O_CLOEXEC) < 0) return -1;
+    fcntl(pipe_fd[1], F_SETPIPE_SZ, SPLICE_PIPE_SIZE);
+
+    while (recved < count) {
+        ssize_t in_pipe = splice(socket_fd, NULL, pipe_fd[1], NULL,
+                                 count - recved, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (in_pipe < 0) {
+            if (errno == EINTR) continue;
+            ret = -1;
+            break;
+        }
+        if (in_pipe == 0) break;
+
+        // 管道中的数据必须全部写入文件，才能继续从套接字读取
+        while (in_pipe > 0) {
+            ssize_t out = splice(pipe_fd[0], NULL, file_fd, &pos, in_pipe,
+                                 SPLICE_F_MOVE | SPLICE_F_MORE);
+            if (out < 0) {
+                if (errno == EINTR) continue;
+                ret = -1;
+                break;
+            }
+            in_pipe -= out;
+            recved += out;
+        }
+        if (ret < 0) break;
+    }
+
+    int err = errno;
+    close(pipe_fd[0]);
+    close(pipe_fd[1]);
+    errno = err;
+
+    return ret < 0 && recved == 0 ? -1 : (ssize_t)recved;
+}
@@ -0,0 +1,21 @@
+/**
+ * @file file_transfer.hpp
+ * @brief 声名了基于sendfile/splice的零拷贝文件传输函数
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef FILE_TRANSFER_HPP_
+#define FILE_TRANSFER_HPP_
+
+#include <sys/types.h>
+
+#define SPLICE_PIPE_SIZE (1024 * 1024)  // splice中转管道的容量
+
+ssize_t send_socket_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count);
+ssize_t recv_socket_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count);
+
+#endif  // FILE_TRANSFER_HPP_
@@ -9,68 +9,73 @@
 
 #include "ip_socket.hpp"
 
-#include <iostream>
-#include <vector>
+#include <errno.h>
+#include <sys/uio.h>
 
-std::vector<int> tcp_ip_socket_server_list;
-std::vector<int> udp_ip_socket_server_list;
-
-std::vector<int> tcp_ip_socket_client_list;
-std::vector<int> udp_ip_socket_client_list;
+#include "../socket_log/socket_log.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+#include "../socket_registry/socket_registry.hpp"
 
 /**
- * @brief 初始化一个tcp套接字服务端
- * @param  port             监听端口
- * @return int ip套接字服务端的socket_fd
+ * @brief 解析组播使用的本地接口地址
+ * @param  if_addr          本地接口的ip地址，为NULL时由内核按路由选择
+ * @param  addr             解析出的地址
+ * @return int 如果解析成功，返回1;如果地址无效，返回-1
  */
-int init_tcp_ip_server(const uint port) {
-    int ret = 0;
-    int socket_fd = 0;
-    struct sockaddr_in server_addr;
-
-    // 1. 创建套接字
-    std::cout << "Socket create...";
-
-    ret = socket_fd = socket(AF_INET, SOCK_STREAM, 0);
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
+static int parse_if_addr(const char* const if_addr, struct in_addr* addr) {
+    if (if_addr == NULL) {
+        addr->s_addr = htonl(INADDR_ANY);
+        return 1;
     }
+    return inet_pton(AF_INET, if_addr, addr) == 1 ? 1 : -1;
+}
 
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
-    server_addr.sin_addr.s_addr = INADDR_ANY;
-
-    // 2. 绑定套接字
-    std::cout << "Binding socket...";
-    ret = bind(socket_fd, (sockaddr*)&server_addr, sizeof(server_addr));
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
+/**
+ * @brief 加入或离开一个组播组
+ * @param  socket_fd        udp套接字的socket_fd
+ * @param  group_addr       组播组地址
+ * @param  if_addr          接收组播的本地接口地址
+ * @param  option           IP_ADD_MEMBERSHIP或IP_DROP_MEMBERSHIP
+ * @return int 如果操作成功，返回1;如果操作失败，返回-1
+ */
+static int update_multicast_membership(const int socket_fd,
+                                       const char* const group_addr,
+                                       const char* const if_addr,
+                                       const int option) {
+    struct ip_mreq mreq;
+
+    bzero(&mreq, sizeof(mreq));
+    if (inet_pton(AF_INET, group_addr, &mreq.imr_multiaddr) != 1 ||
+        !IN_MULTICAST(ntohl(mreq.imr_multiaddr.s_addr)) ||
+        parse_if_addr(if_addr, &mreq.imr_interface) < 0) {
+        errno = EINVAL;
         return -1;
-    } else {
-        std::cout << "success!" << std::endl;
     }
 
-    // 3. 监听套接字
-    std::cout << "Listen socket...";
-    ret = listen(socket_fd, 10);  // 最大监听数量10
-
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
+    return setsockopt(socket_fd, IPPROTO_IP, option, &mreq, sizeof(mreq)) < 0
+               ? -1
+               : 1;
+}
 
-    tcp_ip_socket_server_list.push_back(socket_fd);
+/**
+ * @brief 初始化一个tcp套接字服务端
+ * @param  port             监听端口
+ * @param  backlog          全连接队列长度，突发重连较多时应调大
+ * @return int ip套接字服务端的socket_fd
+ */
+int init_tcp_ip_server(const uint port, const int backlog) {
+    return TcpIpTransport::listen_socket(NULL, port, backlog);
+}
 
-    return socket_fd;
+/**
+ * @brief
+ * 初始化一个开启SO_REUSEPORT的tcp套接字服务端，同一端口上的多个此类服务端由内核分摊新连接
+ * @param  port             监听端口
+ * @param  backlog          全连接队列长度
+ * @return int ip套接字服务端的socket_fd
+ */
+int init_tcp_ip_server_reuseport(const uint port, const int backlog) {
+    return TcpIpTransport::listen_socket(NULL, port, backlog, true);
 }
 
 /**
@@ -80,36 +85,7 @@ int init_tcp_ip_server(const uint port) {
  * @return int 套接字客户端的socket_fd
  */
 int init_tcp_ip_client(const char* const ip_addr, const uint port) {
-    int ret = 0;
-    int socket_fd = 0;
-    struct sockaddr_in server_addr;
-    ret = socket_fd = socket(AF_INET, SOCK_STREAM, 0);
-    std::cout << "Socket create...";
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
-    server_addr.sin_addr.s_addr = inet_addr(ip_addr);
-
-    std::cout << "Connect socket...";
-    ret =
-        connect(socket_fd, (struct sockaddr*)&server_addr, sizeof(server_addr));
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
-        return -1;
-    } else {
-        std::cout << "success!" << std::endl;
-    }
-
-    return socket_fd;
+    return TcpIpTransport::connect_socket(ip_addr, port);
 }
 
 /**
@@ -122,19 +98,16 @@ int recv_tcp_ip_msg(const int socket_fd, const SocketMessage* msg) {
     int ret = 0;
     int accept_fd = 0;
 
-    std::cout << "Waiting for new requests...";
-
     ret = accept_fd = accept(socket_fd, NULL, NULL);
 
     if (ret < 0) {
-        std::cout << "failed!" << std::endl;
+        SOCKET_LOG_ERROR("Waiting for new requests...failed!");
         return -1;
     } else {
-        std::cout << "success!" << std::endl;
+        SOCKET_LOG_DEBUG("Waiting for new requests...success!");
     }
 
-    bzero(msg->buf, msg->len);
-    ret = recv(accept_fd, msg->buf, msg->len, 0);
+    ret = TcpIpTransport::recv_msg(accept_fd, msg, socket_fd);
     close(accept_fd);
 
     return ret;
@@ -153,23 +126,21 @@ int recv_tcp_ip_msg_durable(const int& socket_fd, int& accept_fd,
                             const SocketMessage* msg) {
     int ret = 0;
     if (accept_fd == 0) {
-        std::cout << "Waiting for new requests...";
         ret = accept_fd = accept(socket_fd, NULL, NULL);
     }
 
     if (ret < 0) {
-        std::cout << "failed!" << std::endl;
+        SOCKET_LOG_ERROR("Waiting for new requests...failed!");
         return -1;
     } else {
-        std::cout << "success!" << std::endl;
+        SOCKET_LOG_DEBUG("Waiting for new requests...success!");
     }
 
-    bzero(msg->buf, msg->len);
-    ret = recv(accept_fd, msg->buf, msg->len, 0);
+    ret = TcpIpTransport::recv_msg(accept_fd, msg, socket_fd);
     if (ret <= 0) {
         close(accept_fd);
         accept_fd = 0;
-        std::cout << "request has been released!" << std::endl;
+        SOCKET_LOG_DEBUG("request has been released!");
     }
     return ret;
 }
@@ -181,7 +152,111 @@ int recv_tcp_ip_msg_durable(const int& socket_fd, int& accept_fd,
  * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
  */
 int send_tcp_ip_msg(const int socket_fd, const SocketMessage* msg) {
-    return send(socket_fd, msg->buf, msg->len, 0);
+    return TcpIpTransport::send_msg(socket_fd, msg);
+}
+
+/**
+ * @brief tcp套接字在超时之前发出全部数据，不会因部分写入而丢弃剩余数据
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msg              需要发送数据的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果全部发出，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+ */
+int send_tcp_ip_msg_all(const int socket_fd, const SocketMessage* msg,
+                        const int timeout_ms) {
+    return TcpIpTransport::send_msg_all(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief tcp套接字在超时之前恰好接收msg->len字节
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msg              数据缓存的指针，缓存长度即需要接收的字节数
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果接收完整，返回接收的字节数;如果对端在收到任何数据前关闭，返回0;如果超时或数据不完整，返回-1
+ */
+int recv_tcp_ip_msg_exact(const int socket_fd, const SocketMessage* msg,
+                          const int timeout_ms) {
+    return TcpIpTransport::recv_msg_exact(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief tcp套接字分散接收数据，一次recvmsg依次填满各数据段
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msgs             数据段数组
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int
+ * 如果接收成功，返回接收的总字节数(可能少于各段容量之和);如果对端关闭，返回0;如果接收失败，返回-1
+ */
+int recv_tcp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num) {
+    return TcpIpTransport::recv_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief tcp套接字聚集发送数据，各数据段无需拼接即可一次sendmsg发出，并处理部分写入
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msgs             数据段数组，按顺序发出
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int
+ * 如果发送成功，返回发送的总字节数;如果已写出一部分后出错，返回已写出的字节数，errno保留;如果一个字节都未发出就失败，返回-1
+ */
+int send_tcp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num) {
+    return TcpIpTransport::send_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief tcp套接字按帧接收数据，一次recv中的多帧会依次返回，不完整的帧会等待后续数据
+ * @param  socket_fd        服务端的accept_fd或客户端的socket_fd
+ * @param  decoder          该连接的解帧器
+ * @param  frame            解出的帧，负载指向解帧器的缓存
+ * @return int 如果接收成功，返回1;如果对端关闭，返回0;如果接收失败，返回-1
+ */
+int recv_tcp_ip_frame(const int socket_fd, SocketFrameDecoder* decoder,
+                      SocketFrame* frame) {
+    return TcpIpTransport::recv_frame(socket_fd, decoder, frame);
+}
+
+/**
+ * @brief tcp套接字按帧发送数据，保证整帧写出
+ * @param  socket_fd        客户端的socket_fd
+ * @param  type             消息类型
+ * @param  msg              需要发送数据的指针
+ * @return int 如果发送成功，返回发送的总字节数(含帧头);如果发送失败，返回-1
+ */
+int send_tcp_ip_frame(const int socket_fd, const uint16_t type,
+                      const SocketMessage* msg) {
+    return TcpIpTransport::send_frame(socket_fd, type, msg);
+}
+
+/**
+ * @brief tcp套接字通过sendfile发送文件的一段，数据不经过用户态缓存
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  file_fd          需要发送的文件
+ * @param  offset           文件中的起始偏移
+ * @param  count            需要发送的字节数
+ * @return ssize_t
+ * 如果发送成功，返回发送的字节数;如果中途出错，返回已发送的字节数，可从offset加该值处续传;如果未发送就失败，返回-1
+ */
+ssize_t send_tcp_ip_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count) {
+    return send_socket_file(socket_fd, file_fd, offset, count);
+}
+
+/**
+ * @brief tcp套接字接收count字节并通过splice直接写入文件，数据不经过用户态缓存
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  file_fd          写入的文件
+ * @param  offset           文件中的起始偏移
+ * @param  count            需要接收的字节数
+ * @return ssize_t
+ * 如果接收成功，返回写入文件的字节数;如果对端提前关闭或中途出错，返回已写入的字节数;如果未写入就失败，返回-1
+ */
+ssize_t recv_tcp_ip_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count) {
+    return recv_socket_file(socket_fd, file_fd, offset, count);
 }
 
 /**
@@ -190,19 +265,7 @@ int send_tcp_ip_msg(const int socket_fd, const SocketMessage* msg) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_tcp_ip_server(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = tcp_ip_socket_server_list.begin();
-         it != tcp_ip_socket_server_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > tcp_ip_socket_server_list.size()) return -1;
-    close(socket_fd);
-
-    tcp_ip_socket_server_list.erase(it);
-
-    return 1;
+    return TcpIpTransport::close_server(socket_fd);
 }
 
 /**
@@ -211,19 +274,7 @@ int close_tcp_ip_server(const int socket_fd) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_tcp_ip_client(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = tcp_ip_socket_client_list.begin();
-         it != tcp_ip_socket_client_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > tcp_ip_socket_client_list.size()) return -1;
-    close(socket_fd);
-
-    tcp_ip_socket_client_list.erase(it);
-
-    return 1;
+    return TcpIpTransport::close_client(socket_fd);
 }
 
 /**
@@ -233,86 +284,191 @@ int close_tcp_ip_client(const int socket_fd) {
  */
 
 int init_udp_ip_server(const uint port) {
-    int ret = 0;
-    struct sockaddr_in server_addr;
-    int socket_fd = 0;
+    return UdpIpTransport::bind_server(NULL, port);
+}
 
-    // 1. 创建套接字
-    std::cout << "Socket create...";
+/**
+ * @brief 初始化一个udp套接字客户端
+ * @param  socket_addr      套接字地址
+ * @param  port             发往服务端的端口
+ * @return int udp套接字客户端的socket_fd
+ */
+int init_udp_ip_client(const char* const ip_addr, const uint port) {
+    return UdpIpTransport::connect_socket(ip_addr, port);
+}
 
-    socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
+/**
+ * @brief
+ * 初始化一个udp组播接收端，绑定在组播地址上并加入该组，同一主机上的多个接收端可以使用同一端口
+ * @param  group_addr       组播组地址，如239.255.0.1
+ * @param  port             组播端口
+ * @param  if_addr          接收组播的本地接口地址，为NULL时由内核选择;只在本机测试时可以使用127.0.0.1
+ * @return int 如果初始化成功，返回udp套接字服务端的socket_fd;如果初始化失败，返回-1
+ */
+int init_udp_ip_multicast_server(const char* const group_addr, const uint port,
+                                 const char* const if_addr) {
+    struct in_addr group;
+    int off = 0;
+
+    if (inet_pton(AF_INET, group_addr, &group) != 1) {
+        SOCKET_LOG_ERROR("Invalid multicast group %s!", group_addr);
+        errno = EINVAL;
+        return -1;
+    }
 
-    if (socket_fd < 0) {
-        std::cout << "failed!" << std::endl;
+    // 1. 绑定在组播地址上，不接收发往该端口的单播报文
+    int socket_fd = UdpIpTransport::bind_server(group_addr, port, true);
+    if (socket_fd < 0) return -1;
+
+    // 2. Linux默认向套接字投递本机任一套接字加入的组，关闭后只接收自己加入的组
+    if (setsockopt(socket_fd, IPPROTO_IP, IP_MULTICAST_ALL, &off,
+                   sizeof(off)) < 0) {
+        SOCKET_LOG_ERROR("Set IP_MULTICAST_ALL...failed!");
+        UdpIpTransport::close_server(socket_fd);
         return -1;
-    } else {
-        std::cout << "success!" << std::endl;
     }
 
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
-    server_addr.sin_addr.s_addr = INADDR_ANY;
+    // 3. 加入组播组
+    if (join_udp_ip_multicast_group(socket_fd, group_addr, if_addr) < 0) {
+        UdpIpTransport::close_server(socket_fd);
+        return -1;
+    }
 
-    // 2. 绑定套接字
-    std::cout << "Binding socket...";
-    ret = bind(socket_fd, (sockaddr*)&server_addr, sizeof(server_addr));
+    return socket_fd;
+}
 
-    if (ret < 0) {
-        std::cout << "failed!" << std::endl;
+/**
+ * @brief
+ * 初始化一个udp组播发送端，连接到组播地址，之后用send_udp_ip_msg等函数发出的一个报文即可到达组内所有接收端
+ * @param  group_addr       组播组地址
+ * @param  port             组播端口
+ * @param  ttl              报文的生存跳数，0时不离开本机，1时不离开本网段
+ * @param  loop             本机上的接收端是否收到自己发出的报文
+ * @param  if_addr          发出组播的本地接口地址，为NULL时按路由选择
+ * @return int 如果初始化成功，返回udp套接字客户端的socket_fd;如果初始化失败，返回-1
+ */
+int init_udp_ip_multicast_client(const char* const group_addr, const uint port,
+                                 const int ttl, const bool loop,
+                                 const char* const if_addr) {
+    struct in_addr group;
+
+    if (inet_pton(AF_INET, group_addr, &group) != 1) {
+        SOCKET_LOG_ERROR("Invalid multicast group %s!", group_addr);
+        errno = EINVAL;
         return -1;
-    } else {
-        std::cout << "success!" << std::endl;
     }
 
-    udp_ip_socket_server_list.push_back(socket_fd);
+    // 1. 连接到组播地址
+    int socket_fd = UdpIpTransport::connect_socket(group_addr, port);
+    if (socket_fd < 0) return -1;
+
+    // 2. 设置组播选项，组播报文每次发送时按这些选项选择出口，连接后设置同样生效
+    if (set_udp_ip_multicast_ttl(socket_fd, ttl) < 0 ||
+        set_udp_ip_multicast_loop(socket_fd, loop) < 0 ||
+        (if_addr != NULL && set_udp_ip_multicast_if(socket_fd, if_addr) < 0)) {
+        UdpIpTransport::close_client(socket_fd);
+        return -1;
+    }
 
     return socket_fd;
 }
 
 /**
- * @brief 初始化一个udp套接字客户端
- * @param  socket_addr      套接字地址
- * @param  port             发往服务端的端口
- * @return int udp套接字客户端的socket_fd
+ * @brief 让udp套接字加入一个组播组，同一套接字可以加入多个组
+ * @param  socket_fd        udp套接字的socket_fd
+ * @param  group_addr       组播组地址
+ * @param  if_addr          接收组播的本地接口地址，为NULL时由内核选择
+ * @return int 如果加入成功，返回1;如果加入失败，返回-1
  */
-int init_udp_ip_client(const char* const ip_addr, const uint port) {
-    int socket_fd;
-    int ret = 0;
-    struct sockaddr_in server_addr;
+int join_udp_ip_multicast_group(const int socket_fd,
+                                const char* const group_addr,
+                                const char* const if_addr) {
+    int ret = update_multicast_membership(socket_fd, group_addr, if_addr,
+                                          IP_ADD_MEMBERSHIP);
+    if (ret < 0) {
+        SOCKET_LOG_ERROR("Join multicast group %s...failed!", group_addr);
+    } else {
+        SOCKET_LOG_DEBUG("Join multicast group %s...success!", group_addr);
+    }
 
-    // 1. 创建套接字
-    ret = socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
-    std::cout << "Socket create...";
-    if (ret == -1) {
-        std::cout << "failed!" << std::endl;
-        return -1;
+    return ret;
+}
+
+/**
+ * @brief 让udp套接字离开一个组播组
+ * @param  socket_fd        udp套接字的socket_fd
+ * @param  group_addr       组播组地址
+ * @param  if_addr          加入时使用的本地接口地址
+ * @return int 如果离开成功，返回1;如果离开失败，返回-1
+ */
+int leave_udp_ip_multicast_group(const int socket_fd,
+                                 const char* const group_addr,
+                                 const char* const if_addr) {
+    int ret = update_multicast_membership(socket_fd, group_addr, if_addr,
+                                          IP_DROP_MEMBERSHIP);
+    if (ret < 0) {
+        SOCKET_LOG_ERROR("Leave multicast group %s...failed!", group_addr);
     } else {
-        std::cout << "success!" << std::endl;
+        SOCKET_LOG_DEBUG("Leave multicast group %s...success!", group_addr);
     }
 
-    // 内存区域置0
-    bzero(&server_addr, sizeof(server_addr));
+    return ret;
+}
 
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
-    server_addr.sin_addr.s_addr = inet_addr(ip_addr);
+/**
+ * @brief 设置发出的组播报文的生存跳数
+ * @param  socket_fd        udp套接字的socket_fd
+ * @param  ttl              生存跳数，取值0~255
+ * @return int 如果设置成功，返回1;如果设置失败，返回-1
+ */
+int set_udp_ip_multicast_ttl(const int socket_fd, const int ttl) {
+    unsigned char value = (unsigned char)ttl;
 
-    // 2. 连接套接字
-    std::cout << "Connect socket...";
-    ret = connect(socket_fd, (sockaddr*)&server_addr, sizeof(server_addr));
+    if (ttl < 0 || ttl > 255 ||
+        setsockopt(socket_fd, IPPROTO_IP, IP_MULTICAST_TTL, &value,
+                   sizeof(value)) < 0) {
+        SOCKET_LOG_ERROR("Set IP_MULTICAST_TTL...failed!");
+        return -1;
+    }
 
-    if (ret == -1) {
-        std::cout << "failed!" << std::endl;
+    return 1;
+}
+
+/**
+ * @brief 设置本机上的接收端是否收到本套接字发出的组播报文
+ * @param  socket_fd        udp套接字的socket_fd
+ * @param  loop             是否回环
+ * @return int 如果设置成功，返回1;如果设置失败，返回-1
+ */
+int set_udp_ip_multicast_loop(const int socket_fd, const bool loop) {
+    unsigned char value = loop ? 1 : 0;
+
+    if (setsockopt(socket_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &value,
+                   sizeof(value)) < 0) {
+        SOCKET_LOG_ERROR("Set IP_MULTICAST_LOOP...failed!");
         return -1;
-    } else {
-        std::cout << "success!" << std::endl;
     }
 
-    udp_ip_socket_client_list.push_back(socket_fd);
+    return 1;
+}
 
-    return socket_fd;
+/**
+ * @brief 设置发出组播报文的本地接口
+ * @param  socket_fd        udp套接字的socket_fd
+ * @param  if_addr          本地接口的ip地址，为NULL时恢复为按路由选择
+ * @return int 如果设置成功，返回1;如果设置失败，返回-1
+ */
+int set_udp_ip_multicast_if(const int socket_fd, const char* const if_addr) {
+    struct in_addr addr;
+
+    if (parse_if_addr(if_addr, &addr) < 0 ||
+        setsockopt(socket_fd, IPPROTO_IP, IP_MULTICAST_IF, &addr,
+                   sizeof(addr)) < 0) {
+        SOCKET_LOG_ERROR("Set IP_MULTICAST_IF...failed!");
+        return -1;
+    }
+
+    return 1;
 }
 
 /**
@@ -322,8 +478,7 @@ int init_udp_ip_client(const char* const ip_addr, const uint port) {
  * @return int 如果接收成功，返回接收的字节数;如果接收失败，返回-1
  */
 int recv_udp_ip_msg(const int socket_fd, const SocketMessage* msg) {
-    bzero(msg->buf, msg->len);
-    return recvfrom(socket_fd, msg->buf, msg->len, 0, NULL, NULL);
+    return UdpIpTransport::recv_msg(socket_fd, msg);
 }
 
 /**
@@ -333,7 +488,85 @@ int recv_udp_ip_msg(const int socket_fd, const SocketMessage* msg) {
  * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
  */
 int send_udp_ip_msg(const int socket_fd, const SocketMessage* msg) {
-    return sendto(socket_fd, msg->buf, msg->len, 0, NULL, NULL);
+    return UdpIpTransport::send_msg(socket_fd, msg);
+}
+
+/**
+ * @brief udp套接字服务端在超时之前接收一个报文
+ * @param  socket_fd        udp套接字服务端的socket_fd
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果接收成功，返回接收的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果接收失败，返回-1
+ */
+int recv_udp_ip_msg_timeout(const int socket_fd, const SocketMessage* msg,
+                            const int timeout_ms) {
+    return UdpIpTransport::recv_msg_timeout(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief udp套接字客户端在超时之前发出一个报文，发送缓存已满时等待而不是阻塞
+ * @param  socket_fd        udp套接字客户端的socket_fd
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果发送成功，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+ */
+int send_udp_ip_msg_timeout(const int socket_fd, const SocketMessage* msg,
+                            const int timeout_ms) {
+    return UdpIpTransport::send_msg_timeout(socket_fd, msg, timeout_ms);
+}
+
+/**
+ * @brief udp套接字服务端分散接收一个报文，报文依次填入各数据段
+ * @param  socket_fd        udp套接字服务端的socket_fd
+ * @param  msgs             数据段数组
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int
+ * 如果接收成功，返回报文的字节数;如果接收失败或报文超过各段容量之和被截断，返回-1
+ */
+int recv_udp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num) {
+    return UdpIpTransport::recv_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief udp套接字客户端聚集发送数据，所有数据段作为一个报文发出
+ * @param  socket_fd        udp套接字客户端的socket_fd
+ * @param  msgs             数据段数组，按顺序拼成一个报文
+ * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+ * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
+ */
+int send_udp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num) {
+    return UdpIpTransport::send_msgv(socket_fd, msgs, num);
+}
+
+/**
+ * @brief udp套接字服务端批量接收数据，一次recvmmsg最多接收MAX_UDP_BATCH_NUM个报文
+ * @param  socket_fd        udp套接字服务端的socket_fd
+ * @param  msgs             数据缓存数组，每个元素接收一个报文
+ * @param  lens             输出每个报文的实际长度
+ * @param  src_addrs        输出每个报文的来源地址，可以为NULL
+ * @param  num              数据缓存数组的长度
+ * @return int
+ * 如果接收成功，返回接收的报文数(至少为1，阻塞直到第一个报文到达);如果接收失败，返回-1
+ */
+int recv_udp_ip_msg_batch(const int socket_fd, const SocketMessage* msgs,
+                          int* lens, struct sockaddr_in* src_addrs,
+                          const uint num) {
+    return UdpIpTransport::recv_msg_batch(socket_fd, msgs, lens, src_addrs,
+                                          num);
+}
+
+/**
+ * @brief udp套接字客户端批量发送数据，每MAX_UDP_BATCH_NUM个报文一次sendmmsg
+ * @param  socket_fd        udp套接字客户端的socket_fd
+ * @param  msgs             需要发送的数据数组，每个元素作为一个报文
+ * @param  num              数据数组的长度
+ * @return int 如果发送成功，返回发送的报文数;如果一个也没有发出，返回-1
+ */
+int send_udp_ip_msg_batch(const int socket_fd, const SocketMessage* msgs,
+                          const uint num) {
+    return UdpIpTransport::send_msg_batch(socket_fd, msgs, num);
 }
 
 /**
@@ -342,19 +575,7 @@ int send_udp_ip_msg(const int socket_fd, const SocketMessage* msg) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_udp_ip_server(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = udp_ip_socket_server_list.begin();
-         it != udp_ip_socket_server_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > udp_ip_socket_server_list.size()) return -1;
-    close(socket_fd);
-
-    udp_ip_socket_server_list.erase(it);
-
-    return 1;
+    return UdpIpTransport::close_server(socket_fd);
 }
 
 /**
@@ -363,19 +584,7 @@ int close_udp_ip_server(const int socket_fd) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_udp_ip_client(const int socket_fd) {
-    size_t i = 0;
-    std::vector<int>::iterator it;
-    for (it = udp_ip_socket_client_list.begin();
-         it != udp_ip_socket_client_list.end(); ++it, ++i) {
-        if (*it == socket_fd) break;
-    };
-
-    if (i > udp_ip_socket_client_list.size()) return -1;
-    close(socket_fd);
-
-    udp_ip_socket_client_list.erase(it);
-
-    return 1;
+    return UdpIpTransport::close_client(socket_fd);
 }
 
 /**
@@ -383,14 +592,7 @@ int close_udp_ip_client(const int socket_fd) {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_tcp_ip_server() {
-    std::vector<int>::iterator it;
-    for (it = tcp_ip_socket_server_list.begin();
-         it != tcp_ip_socket_server_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        tcp_ip_socket_server_list.erase(it);
-    };
-
-    return 1;
+    return TcpIpTransport::close_all_server();
 }
 
 /**
@@ -398,14 +600,7 @@ int close_all_tcp_ip_server() {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_tcp_ip_client() {
-    std::vector<int>::iterator it;
-    for (it = tcp_ip_socket_client_list.begin();
-         it != tcp_ip_socket_client_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        tcp_ip_socket_client_list.erase(it);
-    };
-
-    return 1;
+    return TcpIpTransport::close_all_client();
 }
 
 /**
@@ -413,14 +608,7 @@ int close_all_tcp_ip_client() {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_udp_ip_server() {
-    std::vector<int>::iterator it;
-    for (it = udp_ip_socket_server_list.begin();
-         it != udp_ip_socket_server_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        udp_ip_socket_server_list.erase(it);
-    };
-
-    return 1;
+    return UdpIpTransport::close_all_server();
 }
 
 /**
@@ -428,12 +616,5 @@ int close_all_udp_ip_server() {
  * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
  */
 int close_all_udp_ip_client() {
-    std::vector<int>::iterator it;
-    for (it = udp_ip_socket_client_list.begin();
-         it != udp_ip_socket_client_list.end(); ++it) {
-        if (close(*it) < 0) return -1;
-        udp_ip_socket_client_list.erase(it);
-    };
-
-    return 1;
+    return UdpIpTransport::close_all_client();
 }
\ No newline at end of file
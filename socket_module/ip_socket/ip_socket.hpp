@@ -5,33 +5,88 @@
  * @version 1.0
  * @date 2021-05-16
  */
+#ifndef IP_SOCKET_HPP_
+#define IP_SOCKET_HPP_
+
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
 #include <cstring>
 
+#include "../file_transfer/file_transfer.hpp"
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_frame/socket_frame.hpp"
 #include "../socket_message.hpp"
+#include "../socket_transport/socket_transport.hpp"
 
-#define MAX_LISTEN_NUM 10
+#define DEFAULT_MULTICAST_TTL 1  // 组播报文默认不离开本网段
 
-int init_tcp_ip_server(const uint port);
+int init_tcp_ip_server(const uint port, const int backlog = MAX_LISTEN_NUM);
+int init_tcp_ip_server_reuseport(const uint port,
+                                 const int backlog = MAX_LISTEN_NUM);
 int init_tcp_ip_client(const char* const ip_addr, const uint port);
 int recv_tcp_ip_msg(const int socket_fd, const SocketMessage* msg);
 int recv_tcp_ip_msg_durable(const int& socket_fd, int& accept_fd,
                             const SocketMessage* msg);
 int send_tcp_ip_msg(const int socket_fd, const SocketMessage* msg);
+int send_tcp_ip_msg_all(const int socket_fd, const SocketMessage* msg,
+                        const int timeout_ms);
+int recv_tcp_ip_msg_exact(const int socket_fd, const SocketMessage* msg,
+                          const int timeout_ms);
+int recv_tcp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num);
+int send_tcp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num);
+int recv_tcp_ip_frame(const int socket_fd, SocketFrameDecoder* decoder,
+                      SocketFrame* frame);
+int send_tcp_ip_frame(const int socket_fd, const uint16_t type,
+                      const SocketMessage* msg);
+ssize_t send_tcp_ip_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count);
+ssize_t recv_tcp_ip_file(const int socket_fd, const int file_fd,
+                         const off_t offset, const size_t count);
 int close_tcp_ip_server(const int socket_fd);
 int close_tcp_ip_client(const int socket_fd);
 
 int init_udp_ip_server(const uint port);
 int init_udp_ip_client(const char* const ip_addr, const uint port);
+int init_udp_ip_multicast_server(const char* const group_addr, const uint port,
+                                 const char* const if_addr = NULL);
+int init_udp_ip_multicast_client(const char* const group_addr, const uint port,
+                                 const int ttl = DEFAULT_MULTICAST_TTL,
+                                 const bool loop = true,
+                                 const char* const if_addr = NULL);
+int join_udp_ip_multicast_group(const int socket_fd,
+                                const char* const group_addr,
+                                const char* const if_addr = NULL);
+int leave_udp_ip_multicast_group(const int socket_fd,
+                                 const char* const group_addr,
+                                 const char* const if_addr = NULL);
+int set_udp_ip_multicast_ttl(const int socket_fd, const int ttl);
+int set_udp_ip_multicast_loop(const int socket_fd, const bool loop);
+int set_udp_ip_multicast_if(const int socket_fd, const char* const if_addr);
 int recv_udp_ip_msg(const int socket_fd, const SocketMessage* msg);
 int send_udp_ip_msg(const int socket_fd, const SocketMessage* msg);
+int send_udp_ip_msg_timeout(const int socket_fd, const SocketMessage* msg,
+                            const int timeout_ms);
+int recv_udp_ip_msg_timeout(const int socket_fd, const SocketMessage* msg,
+                            const int timeout_ms);
+int recv_udp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num);
+int send_udp_ip_msgv(const int socket_fd, const SocketMessage* msgs,
+                     const uint num);
+int recv_udp_ip_msg_batch(const int socket_fd, const SocketMessage* msgs,
+                          int* lens, struct sockaddr_in* src_addrs,
+                          const uint num);
+int send_udp_ip_msg_batch(const int socket_fd, const SocketMessage* msgs,
+                          const uint num);
 int close_udp_ip_server(const int socket_fd);
 int close_udp_ip_client(const int socket_fd);
 
 int close_all_tcp_ip_server();
 int close_all_tcp_ip_client();
 int close_all_udp_ip_server();
-int close_all_udp_ip_client();
\ No newline at end of file
+int close_all_udp_ip_client();
+
+#endif  // IP_SOCKET_HPP_
@@ -0,0 +1,575 @@
+/**
+ * @file pubsub_broker.cpp
+ * @brief
+ * 实现了发布/订阅代理。每条发布的消息只编码一次，由shared_ptr在所有订阅者的队列间共享;
+ * 每个订阅者有独立的有界队列，非阻塞写出，写不完时等待EPOLLOUT，慢订阅者只会丢弃或合并自己的消息，不会阻塞其他订阅者。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "pubsub_broker.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../domain_socket/domain_socket.hpp"
+#include "../socket_log/socket_log.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+
+#define PUBSUB_BUFFER_LEN (2 * (MAX_PUBSUB_MSG_LEN + SOCKET_FRAME_HEADER_SIZE))
+
+/**
+ * @brief 更新连接关注的事件，队列中有未写出的消息时才关注EPOLLOUT
+ * @param  broker           代理
+ * @param  conn             连接
+ * @param  op               EPOLL_CTL_ADD或EPOLL_CTL_MOD
+ * @param  want_write       是否关注EPOLLOUT
+ * @return int 如果更新成功，返回1;如果更新失败，返回-1
+ */
+static int update_conn_events(PubSubBroker *broker, PubSubConn *conn,
+                              const int op, const bool want_write) {
+    struct epoll_event event;
+    bzero(&event, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET |
+                   (want_write ? (uint32_t)EPOLLOUT : 0u);
+    event.data.fd = conn->accept_fd;
+
+    if (epoll_ctl(broker->epoll_fd, op, conn->accept_fd, &event) < 0) {
+        return -1;
+    }
+    conn->want_write = want_write;
+
+    return 1;
+}
+
+/**
+ * @brief 为新连接分配接收缓存并加入epoll
+ * @param  broker           代理
+ * @param  accept_fd        非阻塞的新连接
+ * @return int 如果加入成功，返回1;如果加入失败，返回-1
+ */
+static int add_conn(PubSubBroker *broker, const int accept_fd) {
+    PubSubConn *conn = new PubSubConn();
+    conn->accept_fd = accept_fd;
+    conn->offset = 0;
+    conn->want_write = false;
+    conn->dropped_num = 0;
+    acquire_socket_message(&conn->buffer, PUBSUB_BUFFER_LEN);
+    init_socket_frame_decoder(&conn->decoder, &conn->buffer);
+
+    if (update_conn_events(broker, conn, EPOLL_CTL_ADD, false) < 0) {
+        release_socket_message(&conn->buffer);
+        delete conn;
+        return -1;
+    }
+    broker->conns[accept_fd] = conn;
+
+    return 1;
+}
+
+/**
+ * @brief 取消连接的所有订阅，移出epoll并关闭
+ * @param  broker           代理
+ * @param  accept_fd        需要关闭的连接
+ */
+static void remove_conn(PubSubBroker *broker, const int accept_fd) {
+    std::unordered_map<int, PubSubConn *>::iterator it =
+        broker->conns.find(accept_fd);
+    if (it == broker->conns.end()) return;
+    PubSubConn *conn = it->second;
+
+    std::unordered_map<std::string, int>::iterator topic;
+    for (topic = conn->topics.begin(); topic != conn->topics.end(); ++topic) {
+        std::set<int> &subscribers = broker->topics[topic->first];
+        subscribers.erase(accept_fd);
+        if (subscribers.empty()) broker->topics.erase(topic->first);
+    }
+
+    epoll_ctl(broker->epoll_fd, EPOLL_CTL_DEL, accept_fd, NULL);
+    close(accept_fd);
+    release_socket_message(&conn->buffer);
+    delete conn;
+    broker->conns.erase(it);
+}
+
+/**
+ * @brief 尽可能多地写出连接队列中的消息，一次sendmsg写出多条
+ * @param  broker           代理
+ * @param  conn             连接
+ * @return int 如果写出成功或发送缓存已满，返回1;如果连接出错，返回-1
+ */
+static int flush_conn(PubSubBroker *broker, PubSubConn *conn) {
+    struct iovec iovs[MAX_SOCKET_IOV_NUM];
+    struct msghdr hdr;
+
+    while (!conn->queue.empty()) {
+        size_t num = conn->queue.size() < MAX_SOCKET_IOV_NUM
+                         ? conn->queue.size()
+                         : MAX_SOCKET_IOV_NUM;
+        size_t len = 0;
+        for (size_t i = 0; i < num; ++i) {
+            const std::vector<char> &frame = conn->queue[i]->frame;
+            size_t skip = i == 0 ? conn->offset : 0;
+            iovs[i].iov_base = (char *)frame.data() + skip;
+            iovs[i].iov_len = frame.size() - skip;
+            len += iovs[i].iov_len;
+        }
+        bzero(&hdr, sizeof(hdr));
+        hdr.msg_iov = iovs;
+        hdr.msg_iovlen = num;
+
+        ssize_t ret =
+            sendmsg(conn->accept_fd, &hdr, MSG_DONTWAIT | MSG_NOSIGNAL);
+        record_socket_syscall(conn->accept_fd, SOCKET_METRICS_SEND, ret, len);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+
+        // 弹出已经完整写出的消息，记录队首消息写出的位置
+        while (ret > 0) {
+            size_t remain = conn->queue.front()->frame.size() - conn->offset;
+            if ((size_t)ret < remain) {
+                conn->offset += ret;
+                break;
+            }
+            ret -= remain;
+            conn->offset = 0;
+            conn->queue.pop_front();
+        }
+    }
+
+    bool want_write = !conn->queue.empty();
+    if (want_write != conn->want_write) {
+        return update_conn_events(broker, conn, EPOLL_CTL_MOD, want_write);
+    }
+    return 1;
+}
+
+/**
+ * @brief 将一条消息放入订阅者的队列，队列已满时按订阅的处理方式丢弃或合并
+ * @param  broker           代理
+ * @param  conn             订阅者的连接
+ * @param  frame            共享的消息
+ * @param  mode             PUBSUB_DROP_OLDEST或PUBSUB_CONFLATE
+ */
+static void enqueue_frame(PubSubBroker *broker, PubSubConn *conn,
+                          const std::shared_ptr<const PubSubFrame> &frame,
+                          const int mode) {
+    // 队首消息可能已写出一部分，不能替换或丢弃
+    size_t first = conn->offset > 0 ? 1 : 0;
+
+    if (mode == PUBSUB_CONFLATE) {
+        for (size_t i = first; i < conn->queue.size(); ++i) {
+            if (conn->queue[i]->topic != frame->topic) continue;
+            conn->queue[i] = frame;
+            ++conn->dropped_num;
+            broker->dropped_num.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    if (conn->queue.size() >= broker->queue_len &&
+        first < conn->queue.size()) {
+        conn->queue.erase(conn->queue.begin() + first);
+        ++conn->dropped_num;
+        broker->dropped_num.fetch_add(1, std::memory_order_relaxed);
+    }
+    conn->queue.push_back(frame);
+}
+
+/**
+ * @brief 将一条发布的消息编码一次，分发到该主题所有订阅者的队列并尝试写出
+ * @param  broker           代理
+ * @param  payload          发布帧的负载，包含主题
+ * @param  topic            主题
+ * @param  broken           输出写出失败的连接，由调用者在处理完成后关闭
+ */
+static void publish_frame(PubSubBroker *broker, const SocketMessage *payload,
+                          const std::string &topic, std::vector<int> *broken) {
+    broker->published_num.fetch_add(1, std::memory_order_relaxed);
+
+    std::unordered_map<std::string, std::set<int> >::iterator subscribers =
+        broker->topics.find(topic);
+    if (subscribers == broker->topics.end()) return;
+
+    SocketFrameHeader header;
+    header.len = htonl(payload->len);
+    header.type = htons(PUBSUB_PUBLISH_FRAME);
+    header.flags = 0;
+
+    std::shared_ptr<PubSubFrame> frame = std::make_shared<PubSubFrame>();
+    frame->topic = topic;
+    frame->frame.resize(SOCKET_FRAME_HEADER_SIZE + payload->len);
+    memcpy(frame->frame.data(), &header, SOCKET_FRAME_HEADER_SIZE);
+    memcpy(frame->frame.data() + SOCKET_FRAME_HEADER_SIZE, payload->buf,
+           payload->len);
+
+    std::set<int>::iterator it;
+    for (it = subscribers->second.begin(); it != subscribers->second.end();
+         ++it) {
+        PubSubConn *conn = broker->conns[*it];
+        enqueue_frame(broker, conn, frame, conn->topics[topic]);
+        if (flush_conn(broker, conn) < 0) broken->push_back(*it);
+    }
+}
+
+/**
+ * @brief 处理连接上收到的一帧
+ * @param  broker           代理
+ * @param  conn             收到该帧的连接
+ * @param  frame            收到的帧
+ * @param  broken           输出出错的连接
+ */
+static void handle_frame(PubSubBroker *broker, PubSubConn *conn,
+                         const SocketFrame *frame, std::vector<int> *broken) {
+    const char *buf = frame->payload.buf;
+    size_t len = frame->payload.len;
+
+    if (frame->type == PUBSUB_SUBSCRIBE_FRAME && len >= 2) {
+        std::string topic(buf + 1, len - 1);
+        conn->topics[topic] = buf[0] == PUBSUB_CONFLATE ? PUBSUB_CONFLATE
+                                                        : PUBSUB_DROP_OLDEST;
+        broker->topics[topic].insert(conn->accept_fd);
+    } else if (frame->type == PUBSUB_UNSUBSCRIBE_FRAME && len >= 1) {
+        std::string topic(buf, len);
+        if (conn->topics.erase(topic) == 0) return;
+        std::set<int> &subscribers = broker->topics[topic];
+        subscribers.erase(conn->accept_fd);
+        if (subscribers.empty()) broker->topics.erase(topic);
+    } else if (frame->type == PUBSUB_PUBLISH_FRAME && len >= 1 &&
+               (size_t)(uint8_t)buf[0] + 1 <= len) {
+        std::string topic(buf + 1, (uint8_t)buf[0]);
+        publish_frame(broker, &frame->payload, topic, broken);
+    } else {
+        SOCKET_LOG_WARN("Pubsub broker drops invalid frame type %u",
+                        frame->type);
+    }
+}
+
+/**
+ * @brief 读取连接上所有可读的数据并处理其中的完整帧，边沿触发下必须读到EAGAIN
+ * @param  broker           代理
+ * @param  conn             可读的连接
+ * @param  broken           输出出错或已关闭的连接
+ */
+static void read_conn(PubSubBroker *broker, PubSubConn *conn,
+                      std::vector<int> *broken) {
+    SocketFrame frame;
+
+    while (1) {
+        int ret = 0;
+        while ((ret = next_socket_frame(&conn->decoder, &frame)) > 0) {
+            handle_frame(broker, conn, &frame, broken);
+        }
+        if (ret < 0) break;
+
+        ret = fill_socket_frame_decoder(&conn->decoder, conn->accept_fd);
+        if (ret > 0) continue;
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        break;
+    }
+
+    broken->push_back(conn->accept_fd);
+}
+
+/**
+ * @brief 接受监听套接字上所有等待中的连接
+ * @param  broker           代理
+ */
+static void accept_conns(PubSubBroker *broker) {
+    while (1) {
+        int accept_fd = accept4(broker->listen_fd, NULL, NULL,
+                                SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (accept_fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                SOCKET_LOG_ERROR("Pubsub broker accept...failed!");
+            }
+            return;
+        }
+        if (add_conn(broker, accept_fd) < 0) close(accept_fd);
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 初始化一个发布/订阅代理
+ * @param  broker           需要初始化的代理
+ * @param  socket_addr      代理监听的域套接字地址
+ * @param  queue_len        每个订阅者最多排队的消息数
+ * @return int 如果初始化成功，返回1;如果初始化失败，返回-1
+ */
+int init_pubsub_broker(PubSubBroker *broker, const char *const socket_addr,
+                       const size_t queue_len) {
+    struct epoll_event event;
+
+    broker->queue_len = queue_len > 0 ? queue_len : 1;
+    broker->running = true;
+    broker->published_num = 0;
+    broker->dropped_num = 0;
+    broker->wake_fd = -1;
+    broker->epoll_fd = -1;
+
+    broker->listen_fd = init_tcp_domain_server(socket_addr);
+    if (broker->listen_fd < 0) return -1;
+
+    broker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    broker->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (broker->epoll_fd < 0 || broker->wake_fd < 0 ||
+        set_socket_nonblocking(broker->listen_fd, true) < 0) {
+        SOCKET_LOG_ERROR("Pubsub broker create...failed!");
+        close_pubsub_broker(broker);
+        return -1;
+    }
+
+    bzero(&event, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = broker->wake_fd;
+    epoll_ctl(broker->epoll_fd, EPOLL_CTL_ADD, broker->wake_fd, &event);
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = broker->listen_fd;
+    epoll_ctl(broker->epoll_fd, EPOLL_CTL_ADD, broker->listen_fd, &event);
+
+    return 1;
+}
+
+/**
+ * @brief 运行代理，直到stop_pubsub_broker被调用
+ * @param  broker           代理
+ * @return int 如果正常退出，返回1;如果epoll_wait出错，返回-1
+ */
+int run_pubsub_broker(PubSubBroker *broker) {
+    struct epoll_event events[MAX_PUBSUB_EVENT_NUM];
+    std::vector<int> broken;
+
+    while (broker->running) {
+        int num =
+            epoll_wait(broker->epoll_fd, events, MAX_PUBSUB_EVENT_NUM, -1);
+        if (num < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+
+        for (int i = 0; i < num; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == broker->wake_fd) {
+                uint64_t count;
+                while (read(broker->wake_fd, &count, sizeof(count)) > 0) {
+                }
+                continue;
+            }
+            if (fd == broker->listen_fd) {
+                accept_conns(broker);
+                continue;
+            }
+
+            std::unordered_map<int, PubSubConn *>::iterator it =
+                broker->conns.find(fd);
+            if (it == broker->conns.end()) continue;
+            if ((events[i].events & EPOLLOUT) &&
+                flush_conn(broker, it->second) < 0) {
+                broken.push_back(fd);
+            }
+            if (events[i].events &
+                (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                read_conn(broker, it->second, &broken);
+            }
+
+            // 所有分发完成后再关闭出错的连接，避免在遍历订阅者时修改集合
+            for (size_t j = 0; j < broken.size(); ++j) {
+                remove_conn(broker, broken[j]);
+            }
+            broken.clear();
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 停止代理，可以在其他线程中调用
+ * @param  broker           代理
+ * @return int 如果唤醒成功，返回1;如果唤醒失败，返回-1
+ */
+int stop_pubsub_broker(PubSubBroker *broker) {
+    uint64_t one = 1;
+    broker->running = false;
+    if (write(broker->wake_fd, &one, sizeof(one)) < 0) return -1;
+    return 1;
+}
+
+/**
+ * @brief 关闭代理及其所有连接，未写出的消息被丢弃
+ * @param  broker           代理
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_pubsub_broker(PubSubBroker *broker) {
+    int ret = 1;
+
+    while (!broker->conns.empty()) {
+        remove_conn(broker, broker->conns.begin()->first);
+    }
+    broker->topics.clear();
+
+    if (broker->listen_fd >= 0 &&
+        close_tcp_domain_server(broker->listen_fd) < 0) {
+        ret = -1;
+    }
+    if (broker->wake_fd >= 0) close(broker->wake_fd);
+    if (broker->epoll_fd >= 0) close(broker->epoll_fd);
+    broker->listen_fd = -1;
+    broker->wake_fd = -1;
+    broker->epoll_fd = -1;
+
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 连接到代理，发布者与订阅者使用同一种连接
+ * @param  socket_addr      代理的域套接字地址
+ * @return int 如果连接成功，返回socket_fd;如果连接失败，返回-1
+ */
+int init_pubsub_client(const char *const socket_addr) {
+    return init_tcp_domain_client(socket_addr);
+}
+
+/**
+ * @brief 订阅一个主题，重复订阅时更新处理方式
+ * @param  socket_fd        到代理的连接
+ * @param  topic            主题，长度不超过MAX_PUBSUB_TOPIC_LEN
+ * @param  mode             跟不上时的处理方式，PUBSUB_DROP_OLDEST或PUBSUB_CONFLATE
+ * @return int 如果发送成功，返回1;如果主题无效或发送失败，返回-1
+ */
+int subscribe_pubsub_topic(const int socket_fd, const char *const topic,
+                           const int mode) {
+    SocketFrameHeader header;
+    char mode_byte = (char)mode;
+    size_t topic_len = strlen(topic);
+    SocketMessage segs[3];
+
+    if (topic_len == 0 || topic_len > MAX_PUBSUB_TOPIC_LEN) return -1;
+
+    header.len = htonl(1 + topic_len);
+    header.type = htons(PUBSUB_SUBSCRIBE_FRAME);
+    header.flags = 0;
+    segs[0].buf = (char *)&header;
+    segs[0].len = SOCKET_FRAME_HEADER_SIZE;
+    segs[1].buf = &mode_byte;
+    segs[1].len = 1;
+    segs[2].buf = (char *)topic;
+    segs[2].len = topic_len;
+
+    // 只写出一部分时帧已不完整，按失败处理
+    return send_tcp_domain_msgv(socket_fd, segs, 3) ==
+                   (int)(SOCKET_FRAME_HEADER_SIZE + 1 + topic_len)
+               ? 1
+               : -1;
+}
+
+/**
+ * @brief 取消订阅一个主题
+ * @param  socket_fd        到代理的连接
+ * @param  topic            主题
+ * @return int 如果发送成功，返回1;如果主题无效或发送失败，返回-1
+ */
+int unsubscribe_pubsub_topic(const int socket_fd, const char *const topic) {
+    SocketMessage msg;
+    msg.buf = (char *)topic;
+    msg.len = strlen(topic);
+
+    if (msg.len == 0 || msg.len > MAX_PUBSUB_TOPIC_LEN) return -1;
+
+    return send_tcp_domain_frame(socket_fd, PUBSUB_UNSUBSCRIBE_FRAME, &msg) < 0
+               ? -1
+               : 1;
+}
+
+/**
+ * @brief 发布一条消息，帧头、主题与数据通过一次sendmsg发出，不做拼接
+ * @param  socket_fd        到代理的连接
+ * @param  topic            主题，长度不超过MAX_PUBSUB_TOPIC_LEN
+ * @param  msg              消息数据
+ * @return int 如果发送成功，返回1;如果主题或消息过长、发送失败，返回-1
+ */
+int publish_pubsub_msg(const int socket_fd, const char *const topic,
+                       const SocketMessage *msg) {
+    SocketFrameHeader header;
+    size_t topic_len = strlen(topic);
+    uint8_t topic_len_byte = (uint8_t)topic_len;
+    size_t payload_len = 1 + topic_len + msg->len;
+    SocketMessage segs[4];
+
+    if (topic_len == 0 || topic_len > MAX_PUBSUB_TOPIC_LEN ||
+        payload_len > MAX_PUBSUB_MSG_LEN) {
+        return -1;
+    }
+
+    header.len = htonl(payload_len);
+    header.type = htons(PUBSUB_PUBLISH_FRAME);
+    header.flags = 0;
+    segs[0].buf = (char *)&header;
+    segs[0].len = SOCKET_FRAME_HEADER_SIZE;
+    segs[1].buf = (char *)&topic_len_byte;
+    segs[1].len = 1;
+    segs[2].buf = (char *)topic;
+    segs[2].len = topic_len;
+    segs[3].buf = msg->buf;
+    segs[3].len = msg->len;
+
+    return send_tcp_domain_msgv(socket_fd, segs, 4) ==
+                   (int)(SOCKET_FRAME_HEADER_SIZE + payload_len)
+               ? 1
+               : -1;
+}
+
+/**
+ * @brief 接收一条订阅的消息
+ * @param  socket_fd        到代理的连接
+ * @param  decoder          该连接的解帧器，缓存容量应不小于MAX_PUBSUB_MSG_LEN加帧头
+ * @param  msg              收到的消息，指向解帧器的缓存，在下一次接收前有效
+ * @return int 如果接收成功，返回1;如果代理关闭连接，返回0;如果接收失败或消息无效，返回-1
+ */
+int recv_pubsub_msg(const int socket_fd, SocketFrameDecoder *decoder,
+                    PubSubMessage *msg) {
+    SocketFrame frame;
+
+    while (1) {
+        int ret = recv_tcp_domain_frame(socket_fd, decoder, &frame);
+        if (ret <= 0) return ret;
+        if (frame.type != PUBSUB_PUBLISH_FRAME) continue;
+
+        size_t topic_len = (uint8_t)frame.payload.buf[0];
+        if (frame.payload.len < 1 + topic_len) return -1;
+
+        msg->topic.buf = frame.payload.buf + 1;
+        msg->topic.len = topic_len;
+        msg->data.buf = frame.payload.buf + 1 + topic_len;
+        msg->data.len = frame.payload.len - 1 - topic_len;
+
+        return 1;
+    }
+}
+
+/**
+ * @brief 关闭到代理的连接
+ * @param  socket_fd        到代理的连接
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_pubsub_client(const int socket_fd) {
+    return close_tcp_domain_client(socket_fd);
+}
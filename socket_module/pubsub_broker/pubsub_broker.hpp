@@ -0,0 +1,91 @@
+/**
+ * @file pubsub_broker.hpp
+ * @brief 声名了基于tcp域套接字的发布/订阅代理，以及发布者与订阅者使用的客户端函数
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef PUBSUB_BROKER_HPP_
+#define PUBSUB_BROKER_HPP_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../socket_frame/socket_frame.hpp"
+#include "../socket_message.hpp"
+
+#define DEFAULT_PUBSUB_QUEUE_LEN 256  // 每个订阅者最多排队的消息数
+#define MAX_PUBSUB_MSG_LEN (64 * 1024)  // 单条消息负载(含主题)的最大长度
+#define MAX_PUBSUB_TOPIC_LEN 255
+#define MAX_PUBSUB_EVENT_NUM 256
+
+// 订阅者跟不上时的处理方式
+#define PUBSUB_DROP_OLDEST 0  // 队列已满时丢弃最早的消息
+#define PUBSUB_CONFLATE 1     // 同一主题只保留最新的一条消息
+
+// 代理协议使用的帧类型
+#define PUBSUB_SUBSCRIBE_FRAME 0xFF01
+#define PUBSUB_UNSUBSCRIBE_FRAME 0xFF02
+#define PUBSUB_PUBLISH_FRAME 0xFF03
+
+// 订阅者收到的一条消息，topic与data均指向解帧器的缓存
+typedef struct PubSubMessage {
+    SocketMessage topic;
+    SocketMessage data;
+} PubSubMessage;
+
+// 编码后的一帧，由所有订阅者的队列共享，只保存一份
+typedef struct PubSubFrame {
+    std::string topic;
+    std::vector<char> frame;
+} PubSubFrame;
+
+// 代理上的一个连接，既可以发布也可以订阅
+typedef struct PubSubConn {
+    int accept_fd;
+    SocketMessage buffer;
+    SocketFrameDecoder decoder;
+    std::unordered_map<std::string, int> topics;  // 主题 -> 处理方式
+    std::deque<std::shared_ptr<const PubSubFrame> > queue;
+    size_t offset;  // 队首消息已写出的字节数
+    bool want_write;
+    uint64_t dropped_num;
+} PubSubConn;
+
+typedef struct PubSubBroker {
+    int epoll_fd;
+    int listen_fd;
+    int wake_fd;
+    size_t queue_len;
+    std::atomic<bool> running;
+    std::unordered_map<int, PubSubConn *> conns;
+    std::unordered_map<std::string, std::set<int> > topics;
+    std::atomic<uint64_t> published_num;
+    std::atomic<uint64_t> dropped_num;
+} PubSubBroker;
+
+int init_pubsub_broker(PubSubBroker *broker, const char *const socket_addr,
+                       const size_t queue_len = DEFAULT_PUBSUB_QUEUE_LEN);
+int run_pubsub_broker(PubSubBroker *broker);
+int stop_pubsub_broker(PubSubBroker *broker);
+int close_pubsub_broker(PubSubBroker *broker);
+
+int init_pubsub_client(const char *const socket_addr);
+int subscribe_pubsub_topic(const int socket_fd, const char *const topic,
+                           const int mode = PUBSUB_DROP_OLDEST);
+int unsubscribe_pubsub_topic(const int socket_fd, const char *const topic);
+int publish_pubsub_msg(const int socket_fd, const char *const topic,
+                       const SocketMessage *msg);
+int recv_pubsub_msg(const int socket_fd, SocketFrameDecoder *decoder,
+                    PubSubMessage *msg);
+int close_pubsub_client(const int socket_fd);
+
+#endif  // PUBSUB_BROKER_HPP_
@@ -0,0 +1,573 @@
+/**
+ * @file reliable_udp.cpp
+ * @brief
+ * 实现了udp之上的可靠传输。每个数据报文立即确认，确认报文携带累计确认与之后32个序号的位图;
+ * 超时按RFC 6298由RTT样本估计，重传过的报文不取样，超时后按报文指数退避;
+ * 之后的报文被确认RUDP_FAST_RETRANSMIT_NUM次时不等超时直接重传。
+ * 有序交付只在同一流内等待，一个流上的丢包不会阻塞其他流和无序消息。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "reliable_udp.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <cstring>
+
+#include "../socket_log/socket_log.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+
+/**
+ * @brief 获取单调时钟的当前时间
+ * @return uint64_t 微秒数
+ */
+static uint64_t now_us() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * @brief 将报文中的32位序号还原为最接近ref的64位序号
+ * @param  wire             报文中的序号
+ * @param  ref              当前期望的序号
+ * @return uint64_t 还原后的序号
+ */
+static uint64_t expand_seq(const uint32_t wire, const uint64_t ref) {
+    const uint64_t span = (uint64_t)1 << 32;
+    uint64_t seq = (ref & ~(span - 1)) | wire;
+
+    if (seq + span / 2 < ref) {
+        seq += span;
+    } else if (seq > ref + span / 2 && seq >= span) {
+        seq -= span;
+    }
+    return seq;
+}
+
+/**
+ * @brief 向对端发出一个报文
+ * @param  conn             连接
+ * @param  data             报文
+ * @param  len              报文长度
+ * @return int 如果发送成功，返回1;如果还不知道对端或发送失败，返回-1
+ */
+static int send_packet(RudpConn *conn, const char *data, const size_t len) {
+    ssize_t ret = 0;
+
+    if (conn->connected) {
+        ret = send(conn->socket_fd, data, len, MSG_DONTWAIT);
+    } else if (conn->has_peer) {
+        ret = sendto(conn->socket_fd, data, len, MSG_DONTWAIT,
+                     (struct sockaddr *)&conn->peer, sizeof(conn->peer));
+    } else {
+        errno = ENOTCONN;
+        return -1;
+    }
+    record_socket_syscall(conn->socket_fd, SOCKET_METRICS_SEND, ret, len);
+
+    // 发送缓存已满时与丢包相同，交给重传处理
+    if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return -1;
+    return 1;
+}
+
+/**
+ * @brief 发出当前的累计确认与选择确认位图
+ * @param  conn             连接
+ */
+static void send_ack(RudpConn *conn) {
+    RudpHeader header;
+    uint32_t bits = 0;
+
+    std::set<uint64_t>::iterator it;
+    for (it = conn->recv_sacked.begin(); it != conn->recv_sacked.end(); ++it) {
+        uint64_t offset = *it - conn->recv_cum - 1;
+        if (offset >= RUDP_SACK_BITS) break;
+        bits |= (uint32_t)1 << offset;
+    }
+
+    header.type = RUDP_ACK_PACKET;
+    header.flags = 0;
+    header.stream = 0;
+    header.seq = htonl((uint32_t)conn->recv_cum);
+    header.extra = htonl(bits);
+    send_packet(conn, (const char *)&header, RUDP_HEADER_SIZE);
+}
+
+/**
+ * @brief 用一个RTT样本更新平滑RTT与重传超时
+ * @param  conn             连接
+ * @param  rtt_us           样本
+ */
+static void update_rtt(RudpConn *conn, const uint64_t rtt_us) {
+    if (conn->srtt_us == 0) {
+        conn->srtt_us = rtt_us;
+        conn->rttvar_us = rtt_us / 2;
+    } else {
+        uint64_t diff = conn->srtt_us > rtt_us ? conn->srtt_us - rtt_us
+                                               : rtt_us - conn->srtt_us;
+        conn->rttvar_us = (3 * conn->rttvar_us + diff) / 4;
+        conn->srtt_us = (7 * conn->srtt_us + rtt_us) / 8;
+    }
+
+    conn->rto_us = conn->srtt_us + 4 * conn->rttvar_us;
+    if (conn->rto_us < conn->min_rto_us) conn->rto_us = conn->min_rto_us;
+    if (conn->rto_us > MAX_RUDP_RTO_US) conn->rto_us = MAX_RUDP_RTO_US;
+}
+
+/**
+ * @brief 报文的重传时间，每多发一次超时加倍
+ * @param  conn             连接
+ * @param  packet           等待确认的报文
+ * @return uint64_t 单调时钟上的重传时间
+ */
+static uint64_t retransmit_time(const RudpConn *conn,
+                                const RudpPacket *packet) {
+    uint64_t rto = conn->rto_us;
+    for (uint32_t i = 1; i < packet->send_num && rto < MAX_RUDP_RTO_US; ++i) {
+        rto *= 2;
+    }
+    if (rto > MAX_RUDP_RTO_US) rto = MAX_RUDP_RTO_US;
+    return packet->send_us + rto;
+}
+
+/**
+ * @brief 重新发出一个报文
+ * @param  conn             连接
+ * @param  packet           等待确认的报文
+ * @param  now              当前时间
+ * @param  fast             是否为快速重传;超时重传后允许再次快速重传
+ */
+static void retransmit(RudpConn *conn, RudpPacket *packet, const uint64_t now,
+                       const bool fast) {
+    send_packet(conn, packet->data.data(), packet->data.size());
+    packet->send_us = now;
+    packet->send_num++;
+    packet->sacked_after = 0;
+    packet->fast_retransmitted = fast;
+    conn->retransmit_num++;
+}
+
+/**
+ * @brief 确认一个报文，只用第一次发出就被确认的报文更新RTT
+ * @param  conn             连接
+ * @param  it               被确认的报文
+ * @param  now              当前时间
+ */
+static void ack_packet(RudpConn *conn,
+                       std::map<uint64_t, RudpPacket>::iterator it,
+                       const uint64_t now) {
+    if (it->second.send_num == 1) update_rtt(conn, now - it->second.send_us);
+    conn->unacked.erase(it);
+}
+
+/**
+ * @brief 处理对端的确认报文
+ * @param  conn             连接
+ * @param  header           报文头
+ * @param  now              当前时间
+ */
+static void handle_ack(RudpConn *conn, const RudpHeader *header,
+                       const uint64_t now) {
+    if (conn->unacked.empty()) return;
+
+    uint64_t cum = expand_seq(ntohl(header->seq),
+                              conn->unacked.begin()->first);
+    uint32_t bits = ntohl(header->extra);
+    uint64_t highest = 0;
+    bool acked = false;
+
+    while (!conn->unacked.empty() && conn->unacked.begin()->first < cum) {
+        highest = conn->unacked.begin()->first;
+        ack_packet(conn, conn->unacked.begin(), now);
+        acked = true;
+    }
+    for (uint32_t i = 0; i < RUDP_SACK_BITS; ++i) {
+        if ((bits & ((uint32_t)1 << i)) == 0) continue;
+        std::map<uint64_t, RudpPacket>::iterator it =
+            conn->unacked.find(cum + 1 + i);
+        if (it == conn->unacked.end()) continue;
+        highest = it->first;
+        ack_packet(conn, it, now);
+        acked = true;
+    }
+    if (!acked) return;
+
+    // 之后的报文已被确认，之前仍未确认的报文很可能已经丢失;
+    // 重传的报文仍在途中时不再快速重传，直到超时重传开始新的一轮
+    std::map<uint64_t, RudpPacket>::iterator it;
+    for (it = conn->unacked.begin();
+         it != conn->unacked.end() && it->first < highest; ++it) {
+        if (it->second.fast_retransmitted) continue;
+        if (++it->second.sacked_after >= RUDP_FAST_RETRANSMIT_NUM) {
+            retransmit(conn, &it->second, now, true);
+        }
+    }
+}
+
+/**
+ * @brief 将一个流内的消息按序交付
+ * @param  conn             连接
+ * @param  stream           流编号
+ * @param  stream_seq       流内的序号
+ * @param  data             消息数据
+ * @param  len              消息长度
+ */
+static void deliver_ordered(RudpConn *conn, const uint16_t stream,
+                            const uint64_t stream_seq, const char *data,
+                            const size_t len) {
+    RudpStream *s = &conn->streams[stream];
+
+    if (stream_seq < s->next_recv_seq) return;
+    if (stream_seq > s->next_recv_seq) {
+        s->pending[stream_seq].assign(data, data + len);
+        return;
+    }
+
+    RudpDelivery delivery;
+    delivery.stream = stream;
+    delivery.data.assign(data, data + len);
+    conn->delivered.push_back(delivery);
+    s->next_recv_seq++;
+
+    while (!s->pending.empty() &&
+           s->pending.begin()->first == s->next_recv_seq) {
+        delivery.data.swap(s->pending.begin()->second);
+        conn->delivered.push_back(delivery);
+        s->pending.erase(s->pending.begin());
+        s->next_recv_seq++;
+    }
+}
+
+/**
+ * @brief 处理对端的数据报文，重复的报文只确认不交付
+ * @param  conn             连接
+ * @param  header           报文头
+ * @param  data             消息数据
+ * @param  len              消息长度
+ */
+static void handle_data(RudpConn *conn, const RudpHeader *header,
+                        const char *data, const size_t len) {
+    uint64_t seq = expand_seq(ntohl(header->seq), conn->recv_cum);
+    uint16_t stream = ntohs(header->stream);
+
+    if (stream >= MAX_RUDP_STREAM_NUM ||
+        seq >= conn->recv_cum + 2 * MAX_RUDP_WINDOW) {
+        return;
+    }
+    if (seq < conn->recv_cum || conn->recv_sacked.count(seq) > 0) {
+        send_ack(conn);
+        return;
+    }
+
+    if (seq == conn->recv_cum) {
+        conn->recv_cum++;
+        while (!conn->recv_sacked.empty() &&
+               *conn->recv_sacked.begin() == conn->recv_cum) {
+            conn->recv_sacked.erase(conn->recv_sacked.begin());
+            conn->recv_cum++;
+        }
+    } else {
+        conn->recv_sacked.insert(seq);
+    }
+    send_ack(conn);
+
+    if (header->flags & RUDP_ORDERED) {
+        RudpStream *s = &conn->streams[stream];
+        deliver_ordered(conn, stream,
+                        expand_seq(ntohl(header->extra), s->next_recv_seq),
+                        data, len);
+    } else {
+        RudpDelivery delivery;
+        delivery.stream = stream;
+        delivery.data.assign(data, data + len);
+        conn->delivered.push_back(delivery);
+    }
+}
+
+/**
+ * @brief 读出套接字上所有已到达的报文
+ * @param  conn             连接
+ * @return int 如果处理成功，返回1;如果接收失败，返回-1
+ */
+static int read_packets(RudpConn *conn) {
+    char buf[RUDP_HEADER_SIZE + MAX_RUDP_PAYLOAD_LEN];
+    RudpHeader header;
+    struct sockaddr_in addr;
+
+    while (1) {
+        socklen_t addr_len = sizeof(addr);
+        ssize_t ret = recvfrom(conn->socket_fd, buf, sizeof(buf), MSG_DONTWAIT,
+                               (struct sockaddr *)&addr, &addr_len);
+        record_socket_syscall(conn->socket_fd, SOCKET_METRICS_RECV, ret,
+                              sizeof(buf));
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 1;
+            // 连接的对端暂时没有监听时会收到ECONNREFUSED，等待重传即可
+            if (errno == ECONNREFUSED) continue;
+            return -1;
+        }
+        if (ret < RUDP_HEADER_SIZE) continue;
+
+        if (!conn->connected) {
+            conn->peer = addr;
+            conn->has_peer = true;
+        }
+        memcpy(&header, buf, RUDP_HEADER_SIZE);
+        if (header.type == RUDP_DATA_PACKET) {
+            handle_data(conn, &header, buf + RUDP_HEADER_SIZE,
+                        ret - RUDP_HEADER_SIZE);
+        } else if (header.type == RUDP_ACK_PACKET) {
+            handle_ack(conn, &header, now_us());
+        }
+    }
+}
+
+/**
+ * @brief 重传所有已经超时的报文
+ * @param  conn             连接
+ * @return uint64_t 下一个报文的重传时间;如果没有等待确认的报文，返回0
+ */
+static uint64_t retransmit_expired(RudpConn *conn) {
+    uint64_t now = now_us();
+    uint64_t next = 0;
+
+    std::map<uint64_t, RudpPacket>::iterator it;
+    for (it = conn->unacked.begin(); it != conn->unacked.end(); ++it) {
+        uint64_t when = retransmit_time(conn, &it->second);
+        if (when <= now) {
+            retransmit(conn, &it->second, now, false);
+            when = retransmit_time(conn, &it->second);
+        }
+        if (next == 0 || when < next) next = when;
+    }
+
+    return next;
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 在一个udp套接字上初始化可靠连接
+ * @param  conn             需要初始化的连接
+ * @param  socket_fd        init_udp_ip_client创建的已连接套接字，或init_udp_ip_server创建的套接字;
+ * 后者回复最近一个发来报文的对端，因此只能服务一个对端
+ * @param  min_rto_us       重传超时的下限(微秒)
+ * @return int 如果初始化成功，返回1;如果初始化失败，返回-1
+ */
+int init_rudp_conn(RudpConn *conn, const int socket_fd,
+                   const uint64_t min_rto_us) {
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+
+    if (socket_fd < 0) return -1;
+
+    conn->socket_fd = socket_fd;
+    conn->connected =
+        getpeername(socket_fd, (struct sockaddr *)&addr, &addr_len) == 0;
+    conn->has_peer = false;
+    memset(&conn->peer, 0, sizeof(conn->peer));
+
+    conn->next_seq = 0;
+    conn->unacked.clear();
+    conn->recv_cum = 0;
+    conn->recv_sacked.clear();
+    for (int i = 0; i < MAX_RUDP_STREAM_NUM; ++i) {
+        conn->streams[i].next_send_seq = 0;
+        conn->streams[i].next_recv_seq = 0;
+        conn->streams[i].pending.clear();
+    }
+    conn->delivered.clear();
+
+    conn->srtt_us = 0;
+    conn->rttvar_us = 0;
+    conn->min_rto_us = min_rto_us;
+    conn->rto_us = INIT_RUDP_RTO_US > min_rto_us ? INIT_RUDP_RTO_US
+                                                 : min_rto_us;
+    conn->sent_num = 0;
+    conn->retransmit_num = 0;
+
+    return 1;
+}
+
+/**
+ * @brief 发送一条消息，立即发出并在收到确认前保留以便重传
+ * @param  conn             连接
+ * @param  stream           流编号，小于MAX_RUDP_STREAM_NUM
+ * @param  msg              消息，长度不超过MAX_RUDP_PAYLOAD_LEN
+ * @param  ordered          是否在流内按发送顺序交付;为false时到达即交付
+ * @return int
+ * 如果发送成功或因发送缓存已满等待重传，返回1;如果未确认的报文已达MAX_RUDP_WINDOW，返回-1并将errno设为EAGAIN;
+ * 如果参数无效、还不知道对端或发送失败，返回-1，消息不入队，可以原样重试
+ */
+int send_rudp_msg(RudpConn *conn, const uint16_t stream,
+                  const SocketMessage *msg, const bool ordered) {
+    RudpHeader header;
+
+    if (stream >= MAX_RUDP_STREAM_NUM) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (msg->len > MAX_RUDP_PAYLOAD_LEN) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+    if (conn->unacked.size() >= MAX_RUDP_WINDOW) {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    header.type = RUDP_DATA_PACKET;
+    header.flags = ordered ? RUDP_ORDERED : 0;
+    header.stream = htons(stream);
+    header.seq = htonl((uint32_t)conn->next_seq);
+    header.extra = 0;
+    if (ordered) {
+        header.extra = htonl((uint32_t)conn->streams[stream].next_send_seq++);
+    }
+
+    RudpPacket &packet = conn->unacked[conn->next_seq++];
+    packet.data.resize(RUDP_HEADER_SIZE + msg->len);
+    memcpy(packet.data.data(), &header, RUDP_HEADER_SIZE);
+    memcpy(packet.data.data() + RUDP_HEADER_SIZE, msg->buf, msg->len);
+    packet.send_us = now_us();
+    packet.send_num = 1;
+    packet.sacked_after = 0;
+    packet.fast_retransmitted = false;
+
+    // 发送缓存已满时已按丢包入队;其他错误撤销入队与序号，调用方重试时不会产生重复的序号
+    if (send_packet(conn, packet.data.data(), packet.data.size()) < 0) {
+        conn->unacked.erase(--conn->next_seq);
+        if (ordered) conn->streams[stream].next_send_seq--;
+        return -1;
+    }
+    conn->sent_num++;
+
+    return 1;
+}
+
+/**
+ * @brief 处理到达的报文并重传超时的报文，最多等待timeout_ms
+ * @param  conn             连接
+ * @param  timeout_ms       等待报文到达的最长时间，为0时不等待
+ * @return int 如果处理成功，返回1;如果接收失败，返回-1
+ */
+int poll_rudp_conn(RudpConn *conn, const int timeout_ms) {
+    struct pollfd pfd;
+    struct timespec wait;
+    uint64_t now = now_us();
+    uint64_t deadline = now + (uint64_t)(timeout_ms > 0 ? timeout_ms : 0) *
+                                  1000;
+
+    // 在下一个重传时间醒来，不必等到timeout_ms
+    uint64_t next = retransmit_expired(conn);
+    if (next != 0 && next < deadline) deadline = next;
+    now = now_us();
+    uint64_t wait_us = deadline > now ? deadline - now : 0;
+    wait.tv_sec = wait_us / 1000000;
+    wait.tv_nsec = (wait_us % 1000000) * 1000;
+
+    pfd.fd = conn->socket_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (ppoll(&pfd, 1, &wait, NULL) < 0 && errno != EINTR) return -1;
+
+    if (read_packets(conn) < 0) return -1;
+    retransmit_expired(conn);
+
+    return 1;
+}
+
+/**
+ * @brief 接收一条消息，等待期间继续处理确认与重传
+ * @param  conn             连接
+ * @param  stream           输出消息所在的流，可以为NULL
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，为SOCKET_WAIT_FOREVER(-1)时一直等待
+ * @return int
+ * 如果接收成功，返回消息的字节数;如果超时，返回-1并将errno设为ETIMEDOUT;如果缓存不足，返回-1并将errno设为EMSGSIZE，消息被丢弃
+ */
+int recv_rudp_msg(RudpConn *conn, uint16_t *stream, const SocketMessage *msg,
+                  const int timeout_ms) {
+    uint64_t deadline = now_us() + (uint64_t)timeout_ms * 1000;
+
+    while (conn->delivered.empty()) {
+        int wait_ms = 100;
+        if (timeout_ms >= 0) {
+            uint64_t now = now_us();
+            if (now >= deadline) {
+                errno = ETIMEDOUT;
+                return -1;
+            }
+            wait_ms = (int)((deadline - now + 999) / 1000);
+        }
+        if (poll_rudp_conn(conn, wait_ms) < 0) return -1;
+    }
+
+    RudpDelivery &delivery = conn->delivered.front();
+    size_t len = delivery.data.size();
+    if (stream != NULL) *stream = delivery.stream;
+    if (len > msg->len) {
+        conn->delivered.pop_front();
+        errno = EMSGSIZE;
+        return -1;
+    }
+    memcpy(msg->buf, delivery.data.data(), len);
+    conn->delivered.pop_front();
+
+    return len;
+}
+
+/**
+ * @brief 等待所有已发送的消息被确认
+ * @param  conn             连接
+ * @param  timeout_ms       超时时间，为SOCKET_WAIT_FOREVER(-1)时一直等待
+ * @return int 如果全部被确认，返回1;如果超时，返回-1并将errno设为ETIMEDOUT
+ */
+int flush_rudp_conn(RudpConn *conn, const int timeout_ms) {
+    uint64_t deadline = now_us() + (uint64_t)timeout_ms * 1000;
+
+    while (!conn->unacked.empty()) {
+        int wait_ms = 100;
+        if (timeout_ms >= 0) {
+            uint64_t now = now_us();
+            if (now >= deadline) {
+                errno = ETIMEDOUT;
+                return -1;
+            }
+            wait_ms = (int)((deadline - now + 999) / 1000);
+        }
+        if (poll_rudp_conn(conn, wait_ms) < 0) return -1;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 释放连接的状态，不关闭套接字，未确认的消息被丢弃
+ * @param  conn             连接
+ * @return int 如果释放时没有未确认的消息，返回1;否则返回-1
+ */
+int close_rudp_conn(RudpConn *conn) {
+    int ret = conn->unacked.empty() ? 1 : -1;
+
+    if (ret < 0) {
+        SOCKET_LOG_WARN("Reliable udp conn drops %zu unacked packets",
+                        conn->unacked.size());
+    }
+    conn->unacked.clear();
+    conn->recv_sacked.clear();
+    for (int i = 0; i < MAX_RUDP_STREAM_NUM; ++i) {
+        conn->streams[i].pending.clear();
+    }
+    conn->delivered.clear();
+
+    return ret;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file reliable_udp.hpp
+ * @brief 声名了udp之上的轻量可靠传输:序号、选择确认、按RTT估计的重传，以及按流的有序或无序交付
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef RELIABLE_UDP_HPP_
+#define RELIABLE_UDP_HPP_
+
+#include <netinet/in.h>
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "../socket_message.hpp"
+
+#define RUDP_HEADER_SIZE 12
+#define MAX_RUDP_PAYLOAD_LEN 1400   // 保证报文不被ip分片
+#define MAX_RUDP_STREAM_NUM 16
+#define MAX_RUDP_WINDOW 1024        // 未确认报文的最大数量
+#define RUDP_SACK_BITS 32           // 一个确认报文携带的选择确认位数
+#define RUDP_FAST_RETRANSMIT_NUM 3  // 之后的报文被确认这么多次时立即重传
+
+#define DEFAULT_RUDP_MIN_RTO_US 5000  // 局域网控制流量的重传下限，远低于tcp的200ms
+#define INIT_RUDP_RTO_US 20000        // 还没有RTT样本时的重传超时
+#define MAX_RUDP_RTO_US 1000000
+
+// 报文类型
+#define RUDP_DATA_PACKET 1
+#define RUDP_ACK_PACKET 2
+
+// 报文头，所有字段均为网络字节序
+typedef struct RudpHeader {
+    uint8_t type;
+    uint8_t flags;    // 数据报文:RUDP_ORDERED表示按流有序交付
+    uint16_t stream;  // 数据报文:流编号
+    uint32_t seq;     // 数据报文:连接内的序号;确认报文:之前的报文都已收到的序号
+    uint32_t extra;   // 数据报文:流内的序号;确认报文:seq之后32个序号的接收位图
+} RudpHeader;
+
+#define RUDP_ORDERED 0x01
+
+// 等待确认的数据报文
+typedef struct RudpPacket {
+    std::vector<char> data;  // 含报文头
+    uint64_t send_us;        // 最近一次发出的时间
+    uint32_t send_num;
+    uint32_t sacked_after;    // 之后的报文被确认的次数
+    bool fast_retransmitted;  // 本轮是否已快速重传，超时重传时清除
+} RudpPacket;
+
+typedef struct RudpStream {
+    uint64_t next_send_seq;
+    uint64_t next_recv_seq;
+    std::map<uint64_t, std::vector<char> > pending;  // 等待前序报文的有序消息
+} RudpStream;
+
+typedef struct RudpDelivery {
+    uint16_t stream;
+    std::vector<char> data;
+} RudpDelivery;
+
+/**
+ * 一个可靠udp连接，不是线程安全的。发送与接收都不启动后台线程，
+ * 确认与重传在recv_rudp_msg、poll_rudp_conn与flush_rudp_conn中进行，只发送的一端也需要定期调用。
+ * 序号在报文中为32位，收到后按当前位置还原为64位，因此不受回绕影响。
+ */
+typedef struct RudpConn {
+    int socket_fd;
+    bool connected;
+    bool has_peer;
+    struct sockaddr_in peer;  // 未连接的套接字回复最近一个对端
+
+    uint64_t next_seq;
+    std::map<uint64_t, RudpPacket> unacked;
+    uint64_t recv_cum;  // 小于该序号的报文都已收到
+    std::set<uint64_t> recv_sacked;
+    RudpStream streams[MAX_RUDP_STREAM_NUM];
+    std::deque<RudpDelivery> delivered;
+
+    uint64_t srtt_us;
+    uint64_t rttvar_us;
+    uint64_t rto_us;
+    uint64_t min_rto_us;
+    uint64_t sent_num;
+    uint64_t retransmit_num;
+} RudpConn;
+
+int init_rudp_conn(RudpConn *conn, const int socket_fd,
+                   const uint64_t min_rto_us = DEFAULT_RUDP_MIN_RTO_US);
+int send_rudp_msg(RudpConn *conn, const uint16_t stream,
+                  const SocketMessage *msg, const bool ordered = true);
+int recv_rudp_msg(RudpConn *conn, uint16_t *stream, const SocketMessage *msg,
+                  const int timeout_ms);
+int poll_rudp_conn(RudpConn *conn, const int timeout_ms);
+int flush_rudp_conn(RudpConn *conn, const int timeout_ms);
+int close_rudp_conn(RudpConn *conn);
+
+#endif  // RELIABLE_UDP_HPP_
@@ -0,0 +1,115 @@
+/**
+ * @file sharded_server.cpp
+ * @brief
+ * 实现了多线程分片的tcp服务端。每个工作线程拥有独立的SO_REUSEPORT监听套接字与事件循环，
+ * 由内核将新连接分散到各个监听套接字上，线程之间不共享accept队列。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "sharded_server.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../socket_log/socket_log.hpp"
+
+/**
+ * @brief 工作线程的入口，绑定核心后运行事件循环直到被停止
+ * @param  loop             该线程独占的事件循环
+ * @param  core             需要绑定的核心编号
+ * @param  buffer_len       该线程接收缓存的容量
+ */
+static void run_worker(SocketEventLoop *loop, const int core,
+                       const size_t buffer_len) {
+    SocketMessage msg;
+    cpu_set_t cpu_set;
+
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) !=
+        0) {
+        SOCKET_LOG_WARN("Bind worker to core %d...failed!", core);
+    }
+
+    if (acquire_socket_message(&msg, buffer_len) < 0) return;
+    run_socket_event_loop(loop, &msg);
+    release_socket_message(&msg);
+}
+
+/**
+ * @brief
+ * 初始化并启动一个分片tcp服务端，所有监听套接字在启动工作线程前创建完毕，出错时立即返回
+ * @param  server           需要初始化的分片服务端
+ * @param  port             监听端口
+ * @param  worker_num       工作线程数量;小于等于0时使用全部核心
+ * @param  backlog          每个监听套接字的全连接队列长度
+ * @param  on_read
+ * 连接可读时的回调函数，会在多个工作线程中并发调用，需要自行保证线程安全
+ * @param  user_data        传给回调函数的用户指针
+ * @param  buffer_len       每个工作线程接收缓存的容量
+ * @return int 如果启动成功，返回工作线程数量;如果启动失败，返回-1
+ */
+int init_tcp_ip_sharded_server(ShardedServer *server, const uint port,
+                               const int worker_num, const int backlog,
+                               SocketReadCallback on_read, void *user_data,
+                               const size_t buffer_len) {
+    int core_num = std::thread::hardware_concurrency();
+    int num = worker_num > 0 ? worker_num : core_num;
+    if (core_num <= 0) core_num = 1;
+    if (num <= 0) num = 1;
+
+    for (int i = 0; i < num; ++i) {
+        int listen_fd = init_tcp_ip_server_reuseport(port, backlog);
+        if (listen_fd < 0) {
+            close_tcp_ip_sharded_server(server);
+            return -1;
+        }
+        server->listen_fds.push_back(listen_fd);
+
+        SocketEventLoop *loop = new SocketEventLoop;
+        server->loops.push_back(loop);
+        if (init_socket_event_loop(loop, listen_fd, on_read, user_data) < 0) {
+            close_tcp_ip_sharded_server(server);
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < num; ++i) {
+        server->workers.push_back(std::thread(run_worker, server->loops[i],
+                                              i % core_num, buffer_len));
+    }
+
+    return num;
+}
+
+/**
+ * @brief 停止所有工作线程，并关闭所有连接与监听套接字
+ * @param  server           分片服务端
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_tcp_ip_sharded_server(ShardedServer *server) {
+    int ret = 1;
+    size_t i = 0;
+
+    for (i = 0; i < server->workers.size(); ++i) {
+        stop_socket_event_loop(server->loops[i]);
+    }
+    for (i = 0; i < server->workers.size(); ++i) server->workers[i].join();
+    server->workers.clear();
+
+    for (i = 0; i < server->loops.size(); ++i) {
+        if (close_socket_event_loop(server->loops[i]) < 0) ret = -1;
+        delete server->loops[i];
+    }
+    server->loops.clear();
+
+    for (i = 0; i < server->listen_fds.size(); ++i) {
+        if (close_tcp_ip_server(server->listen_fds[i]) < 0) ret = -1;
+    }
+    server->listen_fds.clear();
+
+    return ret;
+}
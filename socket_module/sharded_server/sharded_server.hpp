@@ -0,0 +1,30 @@
+/**
+ * @file sharded_server.hpp
+ * @brief 声名了基于SO_REUSEPORT的多线程tcp服务端，每个工作线程绑定一个核心
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SHARDED_SERVER_HPP_
+#define SHARDED_SERVER_HPP_
+
+#include <thread>
+#include <vector>
+
+#include "../event_loop/event_loop.hpp"
+#include "../ip_socket/ip_socket.hpp"
+
+typedef struct ShardedServer {
+    std::vector<int> listen_fds;
+    std::vector<SocketEventLoop *> loops;
+    std::vector<std::thread> workers;
+} ShardedServer;
+
+int init_tcp_ip_sharded_server(ShardedServer *server, const uint port,
+                               const int worker_num, const int backlog,
+                               SocketReadCallback on_read, void *user_data,
+                               const size_t buffer_len);
+int close_tcp_ip_sharded_server(ShardedServer *server);
+
+#endif  // SHARDED_SERVER_HPP_
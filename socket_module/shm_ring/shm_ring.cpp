@@ -0,0 +1,628 @@
+/**
+ * @file shm_ring.cpp
+ * @brief
+ * 实现了基于共享内存的无锁环形队列。每个槽位带有序号，生产者与消费者只通过原子操作交接槽位，
+ * 消费者空闲时才进入futex等待，生产者只在对方等待时才发起系统调用。等待前先以CPU的pause指令自旋，
+ * 收发可以设置截止时间，生产者等待期间定期检查消费者是否已关闭队列或已退出，避免对端消失后永远阻塞。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "shm_ring.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include "../socket_log/socket_log.hpp"
+
+#define SHM_RING_MAGIC 0x53524e47  // "SRNG"
+#define SHM_RING_CACHE_LINE 64
+#define SHM_RING_EMPTY -1         // try_dequeue:队列为空
+#define SHM_RING_TRUNCATED -2     // try_dequeue:消息超过缓存容量
+#define SHM_RING_LIVENESS_MS 100  // 生产者等待期间检查消费者是否存活的间隔
+
+// 槽位头部，数据紧随其后
+typedef struct ShmRingSlot {
+    std::atomic<uint64_t> seq;
+    uint64_t len;
+} ShmRingSlot;
+
+// 共享内存头部，生产者与消费者使用的下标各占一个缓存行，避免伪共享
+typedef struct ShmRingHeader {
+    std::atomic<uint32_t> magic;  // 队列初始化完毕后以release写入
+    int32_t mode;
+    uint64_t slot_num;
+    uint64_t slot_size;
+    int32_t consumer_pid;
+    std::atomic<uint32_t> consumer_closed;  // 服务端关闭后置1，生产者不再等待
+    alignas(SHM_RING_CACHE_LINE) std::atomic<uint64_t> head;  // 生产者写入位置
+    alignas(SHM_RING_CACHE_LINE) std::atomic<uint64_t> tail;  // 消费者读取位置
+    alignas(SHM_RING_CACHE_LINE) std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint32_t> consumer_futex;
+    alignas(SHM_RING_CACHE_LINE) std::atomic<uint32_t> producer_waiting;
+    std::atomic<uint32_t> producer_futex;
+} ShmRingHeader;
+
+// 本进程中一个打开的队列。收发期间持有引用，关闭时由最后一个使用者解除映射
+typedef struct ShmRing {
+    ShmRingHeader *header;
+    size_t map_len;
+    std::string name;
+    int users;                 // 正在进行的收发调用数，由列表的锁保护
+    std::atomic<bool> closed;  // 已从列表移除，等待中的收发调用返回EBADF
+} ShmRing;
+
+// 跨进程共享的原子变量必须是无锁的
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shm ring requires lock-free atomics");
+
+// 同一进程的多个生产者线程会并发地打开与关闭队列，两个列表都由锁保护
+std::map<int, ShmRing *> shm_ring_server_list;
+std::map<int, ShmRing *> shm_ring_client_list;
+static std::mutex shm_ring_list_lock;
+
+/**
+ * @brief 由域套接字地址生成共享内存对象的名称，路径中的'/'替换为'_'
+ * @param  socket_addr      域套接字地址
+ * @return std::string 共享内存对象名称
+ */
+static std::string make_shm_name(const char *const socket_addr) {
+    std::string name = "/shm_ring.";
+    for (const char *p = socket_addr; *p != '\0'; ++p) {
+        name.push_back(*p == '/' ? '_' : *p);
+    }
+    return name;
+}
+
+/**
+ * @brief 在列表中查找队列并增加引用，收发期间队列不会被解除映射
+ * @param  list             shm_ring_server_list或shm_ring_client_list
+ * @param  ring_fd          队列的ring_fd
+ * @return ShmRing* 队列;如果队列不存在，返回NULL并置errno为EBADF
+ */
+static ShmRing *acquire_ring(std::map<int, ShmRing *> &list,
+                             const int ring_fd) {
+    std::lock_guard<std::mutex> guard(shm_ring_list_lock);
+    std::map<int, ShmRing *>::iterator it = list.find(ring_fd);
+    if (it == list.end()) {
+        errno = EBADF;
+        return NULL;
+    }
+    it->second->users++;
+    return it->second;
+}
+
+/**
+ * @brief 释放收发期间持有的引用，队列已关闭且没有其他使用者时解除映射
+ * @param  ring             acquire_ring返回的队列
+ */
+static void release_ring(ShmRing *ring) {
+    {
+        std::lock_guard<std::mutex> guard(shm_ring_list_lock);
+        if (--ring->users > 0 || !ring->closed.load()) return;
+    }
+    munmap(ring->header, ring->map_len);
+    delete ring;
+}
+
+/**
+ * @brief 从列表中移除队列，没有正在进行的收发调用时立即解除映射
+ * @param  list             shm_ring_server_list或shm_ring_client_list
+ * @param  ring_fd          队列的ring_fd
+ * @param  unlink           是否移除共享内存对象
+ * @return int 如果移除成功，返回1;如果队列不存在，返回-1
+ */
+static int erase_ring(std::map<int, ShmRing *> &list, const int ring_fd,
+                      const bool unlink) {
+    ShmRing *ring = NULL;
+    bool idle = false;
+    {
+        std::lock_guard<std::mutex> guard(shm_ring_list_lock);
+        std::map<int, ShmRing *>::iterator it = list.find(ring_fd);
+        if (it == list.end()) return -1;
+        ring = it->second;
+        list.erase(it);
+        ring->closed.store(true);
+        idle = ring->users == 0;
+    }
+
+    if (unlink) shm_unlink(ring->name.c_str());
+    if (idle) {
+        munmap(ring->header, ring->map_len);
+        delete ring;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 获取第idx个槽位
+ * @param  header           共享内存头部
+ * @param  idx              槽位下标
+ * @return ShmRingSlot* 槽位指针
+ */
+static ShmRingSlot *get_slot(ShmRingHeader *header, const uint64_t idx) {
+    char *base = (char *)header + sizeof(ShmRingHeader);
+    return (ShmRingSlot *)(base + idx * header->slot_size);
+}
+
+/**
+ * @brief 获取单调时钟的当前时间
+ * @return int64_t 毫秒数
+ */
+static int64_t now_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * @brief 自旋等待时提示CPU当前处于忙等，不产生系统调用
+ */
+static inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @brief 当futex的值仍为val时进入等待，futex位于共享内存中，不能使用FUTEX_PRIVATE_FLAG
+ * @param  addr             futex地址
+ * @param  val              期望值
+ * @param  wait_ms          最长等待时间，小于0时一直等待
+ */
+static void futex_wait(std::atomic<uint32_t> *addr, const uint32_t val,
+                       const int wait_ms) {
+    struct timespec wait;
+    wait.tv_sec = wait_ms / 1000;
+    wait.tv_nsec = (long)(wait_ms % 1000) * 1000000;
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT, val,
+            wait_ms < 0 ? NULL : &wait, NULL, 0);
+}
+
+/**
+ * @brief 唤醒等待在futex上的线程
+ * @param  addr             futex地址
+ * @param  num              唤醒的数量
+ */
+static void futex_wake(std::atomic<uint32_t> *addr, const int num) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE, num, NULL, NULL, 0);
+}
+
+/**
+ * @brief 在对方处于等待状态时唤醒对方，对方未等待时不产生系统调用
+ * @param  waiting          对方的等待标志
+ * @param  futex            对方等待的futex
+ * @param  num              唤醒的数量
+ */
+static void wake_peer(std::atomic<uint32_t> *waiting,
+                      std::atomic<uint32_t> *futex, const int num) {
+    // 与等待方"置标志-再检查队列"的顺序配对，保证唤醒不会丢失
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting->load(std::memory_order_relaxed) == 0) return;
+    futex->fetch_add(1, std::memory_order_seq_cst);
+    futex_wake(futex, num);
+}
+
+/**
+ * @brief 计算本次等待的时长
+ * @param  deadline         单调时钟上的截止时间，小于0表示没有截止时间
+ * @param  max_ms           单次等待的上限，小于0表示不设上限
+ * @return int 等待的毫秒数，小于0表示一直等待;如果已经超时，返回0
+ */
+static int wait_slice(const int64_t deadline, const int max_ms) {
+    if (deadline < 0) return max_ms;
+    int64_t remain = deadline - now_ms();
+    if (remain <= 0) return 0;
+    return max_ms >= 0 && remain > max_ms ? max_ms : (int)remain;
+}
+
+/**
+ * @brief 生产者等待前检查消费者，消费者已关闭队列或进程已退出时不再等待;
+ * 已退出但尚未被父进程回收的消费者仍视为存活，此时由截止时间兜底
+ * @param  header           共享内存头部
+ * @return bool 如果消费者仍可能取走消息，返回true
+ */
+static bool consumer_alive(ShmRingHeader *header) {
+    if (header->consumer_closed.load(std::memory_order_acquire) != 0) {
+        return false;
+    }
+    return kill(header->consumer_pid, 0) == 0 || errno != ESRCH;
+}
+
+/**
+ * @brief 尝试写入一条消息
+ * @param  header           共享内存头部
+ * @param  msg              需要写入的数据
+ * @return int 如果写入成功，返回1;如果队列已满，返回0
+ */
+static int try_enqueue(ShmRingHeader *header, const SocketMessage *msg) {
+    uint64_t mask = header->slot_num - 1;
+    uint64_t pos = header->head.load(std::memory_order_relaxed);
+    ShmRingSlot *slot = NULL;
+
+    while (1) {
+        slot = get_slot(header, pos & mask);
+        uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff < 0) return 0;
+        if (diff > 0) {
+            pos = header->head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (header->mode == SHM_RING_SPSC) {
+            header->head.store(pos + 1, std::memory_order_relaxed);
+            break;
+        }
+        if (header->head.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    memcpy((char *)slot + sizeof(ShmRingSlot), msg->buf, msg->len);
+    slot->len = msg->len;
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    return 1;
+}
+
+/**
+ * @brief 尝试读出一条消息;与seqpacket套接字一致，超过缓存容量的消息被截断后丢弃
+ * @param  header           共享内存头部
+ * @param  msg              数据缓存的指针
+ * @return int
+ * 如果读出成功，返回读出的字节数;如果队列为空，返回SHM_RING_EMPTY;如果消息超过缓存容量，返回SHM_RING_TRUNCATED
+ */
+static int try_dequeue(ShmRingHeader *header, const SocketMessage *msg) {
+    uint64_t pos = header->tail.load(std::memory_order_relaxed);
+    ShmRingSlot *slot = get_slot(header, pos & (header->slot_num - 1));
+    size_t len = 0;
+
+    if (slot->seq.load(std::memory_order_acquire) != pos + 1) {
+        return SHM_RING_EMPTY;
+    }
+
+    len = slot->len < msg->len ? slot->len : msg->len;
+    memcpy(msg->buf, (char *)slot + sizeof(ShmRingSlot), len);
+    if (len < msg->len) msg->buf[len] = '\0';
+    bool truncated = slot->len > msg->len;
+
+    slot->seq.store(pos + header->slot_num, std::memory_order_release);
+    header->tail.store(pos + 1, std::memory_order_relaxed);
+
+    return truncated ? SHM_RING_TRUNCATED : (int)len;
+}
+
+/**
+ * @brief 映射共享内存对象
+ * @param  shm_fd           共享内存对象的文件描述符
+ * @param  len              映射长度
+ * @return ShmRingHeader* 共享内存头部;如果映射失败，返回NULL
+ */
+static ShmRingHeader *map_ring(const int shm_fd, const size_t len) {
+    void *addr =
+        mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    if (addr == MAP_FAILED) return NULL;
+    return (ShmRingHeader *)addr;
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 初始化一个共享内存环形队列的服务端(消费者)，已存在的同名队列会被移除
+ * @param  socket_addr      与init_tcp_domain_server相同的域套接字地址
+ * @param  mode             SHM_RING_SPSC或SHM_RING_MPSC
+ * @param  slot_num         槽位数量，向上取整为2的幂
+ * @param  slot_size        每个槽位的容量(含16字节槽位头)，向上取整为缓存行的整数倍
+ * @return int 如果初始化成功，返回队列的ring_fd;如果初始化失败，返回-1
+ */
+int init_shm_ring_server(const char *const socket_addr, const int mode,
+                         const size_t slot_num, const size_t slot_size) {
+    ShmRing *ring = NULL;
+    ShmRingHeader *header = NULL;
+    std::string name = make_shm_name(socket_addr);
+    size_t map_len = 0;
+    size_t num = 1;
+    size_t size = 0;
+    int shm_fd = 0;
+
+    if (mode != SHM_RING_SPSC && mode != SHM_RING_MPSC) return -1;
+    if (slot_size <= sizeof(ShmRingSlot)) return -1;
+    while (num < slot_num) num <<= 1;
+    size = (slot_size + SHM_RING_CACHE_LINE - 1) &
+           ~(size_t)(SHM_RING_CACHE_LINE - 1);
+
+    map_len = sizeof(ShmRingHeader) + num * size;
+
+    // 1. 创建共享内存对象
+    shm_unlink(name.c_str());
+    shm_fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                      0600);
+    if (shm_fd < 0 || ftruncate(shm_fd, map_len) < 0) {
+        SOCKET_LOG_ERROR("Shared memory create...failed!");
+        if (shm_fd >= 0) close(shm_fd);
+        shm_unlink(name.c_str());
+        return -1;
+    } else {
+        SOCKET_LOG_DEBUG("Shared memory create...success!");
+    }
+
+    // 2. 映射并初始化队列
+    header = map_ring(shm_fd, map_len);
+    if (header == NULL) {
+        SOCKET_LOG_ERROR("Shared memory map...failed!");
+        close(shm_fd);
+        shm_unlink(name.c_str());
+        return -1;
+    } else {
+        SOCKET_LOG_DEBUG("Shared memory map...success!");
+    }
+
+    header = new (header) ShmRingHeader;
+    header->mode = mode;
+    header->slot_num = num;
+    header->slot_size = size;
+    header->consumer_pid = getpid();
+    header->consumer_closed.store(0);
+    header->head.store(0);
+    header->tail.store(0);
+    header->consumer_waiting.store(0);
+    header->consumer_futex.store(0);
+    header->producer_waiting.store(0);
+    header->producer_futex.store(0);
+    for (size_t i = 0; i < num; ++i) {
+        ShmRingSlot *slot = new (get_slot(header, i)) ShmRingSlot;
+        slot->seq.store(i);
+        slot->len = 0;
+    }
+    // 客户端以magic判断队列是否初始化完毕
+    header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+
+    ring = new ShmRing;
+    ring->header = header;
+    ring->map_len = map_len;
+    ring->name = name;
+    ring->users = 0;
+    ring->closed.store(false);
+
+    std::lock_guard<std::mutex> guard(shm_ring_list_lock);
+    shm_ring_server_list[shm_fd] = ring;
+
+    return shm_fd;
+}
+
+/**
+ * @brief 初始化一个共享内存环形队列的客户端(生产者)
+ * @param  socket_addr      服务端使用的域套接字地址
+ * @return int 如果初始化成功，返回队列的ring_fd;如果初始化失败，返回-1
+ */
+int init_shm_ring_client(const char *const socket_addr) {
+    ShmRing *ring = NULL;
+    ShmRingHeader *header = NULL;
+    std::string name = make_shm_name(socket_addr);
+    size_t map_len = 0;
+    struct stat st;
+    int shm_fd = 0;
+
+    // 1. 打开共享内存对象
+    shm_fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (shm_fd < 0 || fstat(shm_fd, &st) < 0 ||
+        (size_t)st.st_size < sizeof(ShmRingHeader)) {
+        SOCKET_LOG_ERROR("Shared memory open...failed!");
+        if (shm_fd >= 0) close(shm_fd);
+        return -1;
+    } else {
+        SOCKET_LOG_DEBUG("Shared memory open...success!");
+    }
+
+    // 2. 映射并校验队列
+    map_len = st.st_size;
+    header = map_ring(shm_fd, map_len);
+    if (header == NULL ||
+        header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC ||
+        map_len < sizeof(ShmRingHeader) +
+                      header->slot_num * header->slot_size) {
+        SOCKET_LOG_ERROR("Shared memory map...failed!");
+        if (header != NULL) munmap(header, map_len);
+        close(shm_fd);
+        return -1;
+    } else {
+        SOCKET_LOG_DEBUG("Shared memory map...success!");
+    }
+
+    ring = new ShmRing;
+    ring->header = header;
+    ring->map_len = map_len;
+    ring->name = name;
+    ring->users = 0;
+    ring->closed.store(false);
+
+    std::lock_guard<std::mutex> guard(shm_ring_list_lock);
+    shm_ring_client_list[shm_fd] = ring;
+
+    return shm_fd;
+}
+
+/**
+ * @brief 共享内存环形队列服务端接收数据，队列为空时先自旋，仍为空才进入futex等待
+ * @param  ring_fd          共享内存环形队列服务端的ring_fd
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果接收成功，返回接收的字节数;如果消息超过缓存容量，返回-1并置errno为EMSGSIZE;如果超时，返回-1并置errno为ETIMEDOUT;如果队列不存在或已关闭，返回-1并置errno为EBADF
+ */
+int recv_shm_ring_msg(const int ring_fd, const SocketMessage *msg,
+                      const int timeout_ms) {
+    ShmRing *ring = acquire_ring(shm_ring_server_list, ring_fd);
+    if (ring == NULL) return -1;
+    ShmRingHeader *header = ring->header;
+    int64_t deadline = timeout_ms < 0 ? -1 : now_ms() + timeout_ms;
+    int ret = SHM_RING_EMPTY;
+
+    while (ret == SHM_RING_EMPTY) {
+        for (int i = 0; i < SHM_RING_SPIN_NUM; ++i) {
+            ret = try_dequeue(header, msg);
+            if (ret != SHM_RING_EMPTY) break;
+            cpu_relax();
+        }
+        if (ret != SHM_RING_EMPTY) break;
+
+        if (ring->closed.load()) {
+            errno = EBADF;
+            break;
+        }
+        int wait_ms = wait_slice(deadline, -1);
+        if (wait_ms == 0) {
+            errno = ETIMEDOUT;
+            break;
+        }
+
+        // 先置等待标志再检查一次队列，与生产者的wake_peer配对
+        header->consumer_waiting.store(1, std::memory_order_seq_cst);
+        uint32_t val = header->consumer_futex.load();
+        ret = try_dequeue(header, msg);
+        if (ret == SHM_RING_EMPTY) {
+            futex_wait(&header->consumer_futex, val, wait_ms);
+        }
+        header->consumer_waiting.store(0, std::memory_order_relaxed);
+    }
+
+    if (ret != SHM_RING_EMPTY) {
+        wake_peer(&header->producer_waiting, &header->producer_futex,
+                  INT32_MAX);
+    }
+    release_ring(ring);
+
+    if (ret == SHM_RING_TRUNCATED) {
+        SOCKET_LOG_ERROR("Shared memory ring message truncated!");
+        errno = EMSGSIZE;
+        return -1;
+    }
+    return ret < 0 ? -1 : ret;
+}
+
+/**
+ * @brief
+ * 共享内存环形队列客户端发送数据，队列已满时先自旋，仍已满才等待消费者腾出槽位;等待期间定期检查消费者是否存活
+ * @param  ring_fd          共享内存环形队列客户端的ring_fd
+ * @param  msg              数据缓存的指针
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果发送成功，返回发送的字节数;如果消息超过槽位容量，返回-1并置errno为EMSGSIZE;如果超时，返回-1并置errno为ETIMEDOUT;如果消费者已关闭队列或已退出，返回-1并置errno为EPIPE;如果队列不存在或已关闭，返回-1并置errno为EBADF
+ */
+int send_shm_ring_msg(const int ring_fd, const SocketMessage *msg,
+                      const int timeout_ms) {
+    ShmRing *ring = acquire_ring(shm_ring_client_list, ring_fd);
+    if (ring == NULL) return -1;
+    ShmRingHeader *header = ring->header;
+    int64_t deadline = timeout_ms < 0 ? -1 : now_ms() + timeout_ms;
+    int ret = 0;
+
+    if (msg->len > header->slot_size - sizeof(ShmRingSlot)) {
+        release_ring(ring);
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    while (ret == 0) {
+        for (int i = 0; i < SHM_RING_SPIN_NUM; ++i) {
+            ret = try_enqueue(header, msg);
+            if (ret > 0) break;
+            cpu_relax();
+        }
+        if (ret > 0) break;
+
+        if (ring->closed.load()) {
+            errno = EBADF;
+            ret = -1;
+            break;
+        }
+        if (!consumer_alive(header)) {
+            errno = EPIPE;
+            ret = -1;
+            break;
+        }
+        int wait_ms = wait_slice(deadline, SHM_RING_LIVENESS_MS);
+        if (wait_ms == 0) {
+            errno = ETIMEDOUT;
+            ret = -1;
+            break;
+        }
+
+        header->producer_waiting.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t val = header->producer_futex.load();
+        ret = try_enqueue(header, msg);
+        if (ret == 0) futex_wait(&header->producer_futex, val, wait_ms);
+        header->producer_waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (ret > 0) {
+        wake_peer(&header->consumer_waiting, &header->consumer_futex, 1);
+    }
+    release_ring(ring);
+
+    return ret > 0 ? (int)msg->len : -1;
+}
+
+/**
+ * @brief 关闭共享内存环形队列服务端，并移除共享内存对象
+ * @param  ring_fd          共享内存环形队列服务端的ring_fd
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_shm_ring_server(const int ring_fd) {
+    ShmRing *ring = acquire_ring(shm_ring_server_list, ring_fd);
+    if (ring == NULL) return -1;
+
+    // 通知所有进程中等待的生产者，并唤醒本进程中等待的接收调用
+    ShmRingHeader *header = ring->header;
+    header->consumer_closed.store(1, std::memory_order_release);
+    erase_ring(shm_ring_server_list, ring_fd, true);
+    header->producer_futex.fetch_add(1);
+    futex_wake(&header->producer_futex, INT32_MAX);
+    header->consumer_futex.fetch_add(1);
+    futex_wake(&header->consumer_futex, INT32_MAX);
+    release_ring(ring);
+
+    return close(ring_fd) == 0 ? 1 : -1;
+}
+
+/**
+ * @brief 关闭共享内存环形队列客户端
+ * @param  ring_fd          共享内存环形队列客户端的ring_fd
+ * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+ */
+int close_shm_ring_client(const int ring_fd) {
+    ShmRing *ring = acquire_ring(shm_ring_client_list, ring_fd);
+    if (ring == NULL) return -1;
+
+    // 唤醒本进程中等待的发送调用，其他进程的生产者被唤醒后重新等待
+    ShmRingHeader *header = ring->header;
+    erase_ring(shm_ring_client_list, ring_fd, false);
+    header->producer_futex.fetch_add(1);
+    futex_wake(&header->producer_futex, INT32_MAX);
+    release_ring(ring);
+
+    return close(ring_fd) == 0 ? 1 : -1;
+}
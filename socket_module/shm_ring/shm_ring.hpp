@@ -0,0 +1,34 @@
+/**
+ * @file shm_ring.hpp
+ * @brief 声名了基于共享内存无锁环形队列的同机传输，接口与udp域套接字保持一致
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SHM_RING_HPP_
+#define SHM_RING_HPP_
+
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_message.hpp"
+
+#define SHM_RING_SPSC 0  // 单生产者单消费者
+#define SHM_RING_MPSC 1  // 多生产者单消费者
+
+#define DEFAULT_SHM_RING_SLOT_NUM 1024
+#define DEFAULT_SHM_RING_SLOT_SIZE 4096  // 每个槽位的容量，含16字节槽位头
+#define SHM_RING_SPIN_NUM 1024           // 进入futex等待前以pause指令自旋的次数
+
+int init_shm_ring_server(const char *const socket_addr,
+                         const int mode = SHM_RING_MPSC,
+                         const size_t slot_num = DEFAULT_SHM_RING_SLOT_NUM,
+                         const size_t slot_size = DEFAULT_SHM_RING_SLOT_SIZE);
+int init_shm_ring_client(const char *const socket_addr);
+int recv_shm_ring_msg(const int ring_fd, const SocketMessage *msg,
+                      const int timeout_ms = SOCKET_WAIT_FOREVER);
+int send_shm_ring_msg(const int ring_fd, const SocketMessage *msg,
+                      const int timeout_ms = SOCKET_WAIT_FOREVER);
+int close_shm_ring_server(const int ring_fd);
+int close_shm_ring_client(const int ring_fd);
+
+#endif  // SHM_RING_HPP_
@@ -0,0 +1,305 @@
+/**
+ * @file socket_batch.cpp
+ * @brief
+ * 实现了合并小消息的批量发送器。消息先拷贝到每个连接的缓存中，缓存达到flush_len、
+ * 等待超过delay_us或调用者显式写出时，整个缓存通过一次sendmsg发出，每次写出最多等待timeout_ms。
+ * timer_fd只在没有设置时才重新设置，连续发送时每个截止周期最多多一次系统调用。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_batch.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../buffer_pool/buffer_pool.hpp"
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_frame/socket_frame.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+
+#define SOCKET_BATCH_MAX_SEG_NUM 2  // 一条消息最多由帧头与负载两段组成
+
+/**
+ * @brief 获取单调时钟的当前时间
+ * @return uint64_t 纳秒数
+ */
+static uint64_t now_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * @brief 设置timer_fd在expire_ns时到期
+ * @param  sender           发送器
+ * @param  expire_ns        单调时钟上的到期时间
+ * @return int 如果设置成功，返回1;如果设置失败，返回-1
+ */
+static int arm_timer(SocketBatchSender *sender, const uint64_t expire_ns) {
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = expire_ns / 1000000000;
+    spec.it_value.tv_nsec = expire_ns % 1000000000;
+
+    if (timerfd_settime(sender->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) < 0) {
+        return -1;
+    }
+    sender->timer_ns = expire_ns;
+
+    return 1;
+}
+
+/**
+ * @brief 在发送器的超时之前以sendmsg聚集发出若干段数据，处理部分写入;对端关闭时不产生SIGPIPE
+ * @param  sender           发送器
+ * @param  segs             数据的各段
+ * @param  num              段数，不超过SOCKET_BATCH_MAX_SEG_NUM
+ * @return int
+ * 如果全部发出，返回发送的总字节数;如果超时，返回-1并置errno为ETIMEDOUT，此时可能已发出部分数据，连接应当关闭;
+ * 如果发送失败，返回-1
+ */
+static int send_segments(SocketBatchSender *sender, const SocketMessage *segs,
+                         const int num) {
+    struct iovec iovs[SOCKET_BATCH_MAX_SEG_NUM];
+    struct msghdr hdr;
+    uint64_t start_ns = start_socket_metrics_clock();
+    uint64_t deadline =
+        sender->timeout_ms < 0
+            ? 0
+            : now_ns() + (uint64_t)sender->timeout_ms * 1000000;
+    size_t total = 0;
+    size_t sent = 0;
+
+    memset(&hdr, 0, sizeof(hdr));
+    for (int i = 0; i < num; ++i) {
+        iovs[i].iov_base = segs[i].buf;
+        iovs[i].iov_len = segs[i].len;
+        total += segs[i].len;
+    }
+    hdr.msg_iov = iovs;
+    hdr.msg_iovlen = num;
+
+    while (sent < total) {
+        ssize_t ret = sendmsg(sender->socket_fd, &hdr,
+                              MSG_DONTWAIT | MSG_NOSIGNAL);
+        record_socket_syscall(sender->socket_fd, SOCKET_METRICS_SEND, ret,
+                              total - sent);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return -1;
+
+            int timeout = SOCKET_WAIT_FOREVER;
+            if (sender->timeout_ms >= 0) {
+                uint64_t now = now_ns();
+                timeout = now < deadline ? (deadline - now + 999999) / 1000000
+                                         : 0;
+            }
+            if (wait_socket_ready(sender->socket_fd, POLLOUT, timeout) < 0) {
+                return -1;
+            }
+            continue;
+        }
+        sent += ret;
+
+        // 跳过已经完整写出的段，并调整部分写出的段
+        while (hdr.msg_iovlen > 0 && (size_t)ret >= hdr.msg_iov->iov_len) {
+            ret -= hdr.msg_iov->iov_len;
+            ++hdr.msg_iov;
+            --hdr.msg_iovlen;
+        }
+        if (hdr.msg_iovlen > 0) {
+            hdr.msg_iov->iov_base = (char *)hdr.msg_iov->iov_base + ret;
+            hdr.msg_iov->iov_len -= ret;
+        }
+    }
+    record_socket_msg(sender->socket_fd, SOCKET_METRICS_SEND, 1, start_ns);
+
+    return sent;
+}
+
+/**
+ * @brief 将若干段数据作为一条消息放入缓存，必要时写出
+ * @param  sender           发送器
+ * @param  segs             消息的各段
+ * @param  num              段数
+ * @return int 如果放入或发出成功，返回1;如果发送失败，返回-1
+ */
+static int push_segments(SocketBatchSender *sender, const SocketMessage *segs,
+                         const int num) {
+    uint64_t now = now_ns();
+    size_t total = 0;
+
+    for (int i = 0; i < num; ++i) total += segs[i].len;
+
+    if (sender->len + total > sender->flush_len &&
+        flush_socket_batch_sender(sender) < 0) {
+        return -1;
+    }
+
+    // 放不进缓存的大消息不再拷贝，帧头与负载一次聚集发出
+    if (total >= sender->flush_len) {
+        if (send_segments(sender, segs, num) < 0) return -1;
+        sender->last_flush_ns = now;
+        return 1;
+    }
+
+    bool empty = sender->len == 0;
+    if (empty) sender->first_ns = now;
+    for (int i = 0; i < num; ++i) {
+        memcpy(sender->buffer.buf + sender->len, segs[i].buf, segs[i].len);
+        sender->len += segs[i].len;
+    }
+
+    // 连接空闲时不必等待后续消息;缓存中最早的消息到期时顺带写出
+    uint64_t since = empty ? sender->last_flush_ns : sender->first_ns;
+    if (sender->len >= sender->flush_len ||
+        now - since >= sender->delay_ns) {
+        return flush_socket_batch_sender(sender) < 0 ? -1 : 1;
+    }
+
+    if (empty && sender->timer_ns == 0) {
+        arm_timer(sender, now + sender->delay_ns);
+    }
+
+    return 1;
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 初始化一个批量发送器
+ * @param  sender           需要初始化的发送器
+ * @param  socket_fd        已连接的流式套接字，发送器不负责关闭
+ * @param  flush_len        缓存达到该字节数时立即写出
+ * @param  delay_us         消息在缓存中的最长等待时间(微秒)
+ * @param  timeout_ms       单次写出等待发送缓存的超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果初始化成功，返回1;如果初始化失败，返回-1
+ */
+int init_socket_batch_sender(SocketBatchSender *sender, const int socket_fd,
+                             const size_t flush_len, const uint64_t delay_us,
+                             const int timeout_ms) {
+    if (socket_fd < 0 || flush_len == 0) return -1;
+
+    sender->timer_fd = timerfd_create(CLOCK_MONOTONIC,
+                                      TFD_NONBLOCK | TFD_CLOEXEC);
+    if (sender->timer_fd < 0) return -1;
+    if (acquire_socket_message(&sender->buffer, flush_len) < 0) {
+        close(sender->timer_fd);
+        return -1;
+    }
+
+    sender->socket_fd = socket_fd;
+    sender->len = 0;
+    sender->flush_len = flush_len;
+    sender->delay_ns = delay_us * 1000;
+    sender->timeout_ms = timeout_ms;
+    sender->first_ns = 0;
+    sender->last_flush_ns = 0;
+    sender->timer_ns = 0;
+
+    return 1;
+}
+
+/**
+ * @brief 放入一条消息，消息按原样拼接，接收方需要自行分帧
+ * @param  sender           发送器
+ * @param  msg              需要发送的消息，返回后即可重用
+ * @return int 如果放入或发出成功，返回1;如果发送失败，返回-1
+ */
+int push_socket_batch_msg(SocketBatchSender *sender, const SocketMessage *msg) {
+    return push_segments(sender, msg, 1);
+}
+
+/**
+ * @brief 放入一帧，接收方可以用recv_socket_frame逐帧接收
+ * @param  sender           发送器
+ * @param  type             消息类型
+ * @param  msg              负载数据，返回后即可重用
+ * @return int 如果放入或发出成功，返回1;如果负载过长或发送失败，返回-1
+ */
+int push_socket_batch_frame(SocketBatchSender *sender, const uint16_t type,
+                            const SocketMessage *msg) {
+    SocketFrameHeader header;
+    SocketMessage segs[2];
+
+    if (msg->len > MAX_FRAME_PAYLOAD_LEN) return -1;
+
+    header.len = htonl(msg->len);
+    header.type = htons(type);
+    header.flags = 0;
+    segs[0].buf = (char *)&header;
+    segs[0].len = SOCKET_FRAME_HEADER_SIZE;
+    segs[1] = *msg;
+
+    return push_segments(sender, segs, 2);
+}
+
+/**
+ * @brief 立即写出缓存中的全部消息，用于紧急消息之后
+ * @param  sender           发送器
+ * @return int
+ * 如果写出成功，返回写出的字节数;如果缓存为空，返回0;如果超时或发送失败，返回-1，缓存中的消息被丢弃，
+ * 超时时可能已发出部分数据，连接应当关闭
+ */
+int flush_socket_batch_sender(SocketBatchSender *sender) {
+    if (sender->len == 0) return 0;
+
+    SocketMessage msg = {sender->buffer.buf, sender->len};
+    int ret = send_segments(sender, &msg, 1);
+    sender->len = 0;
+    sender->last_flush_ns = now_ns();
+
+    return ret;
+}
+
+/**
+ * @brief 写出等待超过delay_us的消息，在timer_fd可读时调用，或在发送循环中轮询
+ * @param  sender           发送器
+ * @return int
+ * 如果写出成功，返回写出的字节数;如果没有到期的消息，返回0;如果发送失败，返回-1
+ */
+int check_socket_batch_deadline(SocketBatchSender *sender) {
+    uint64_t now = now_ns();
+    int ret = 0;
+
+    if (sender->len > 0 && now - sender->first_ns >= sender->delay_ns) {
+        ret = flush_socket_batch_sender(sender);
+    }
+
+    // 计时器到期后清除可读状态，仍有消息等待时按其截止时间重新设置
+    if (sender->timer_ns != 0 && now >= sender->timer_ns) {
+        uint64_t count;
+        while (read(sender->timer_fd, &count, sizeof(count)) > 0) {
+        }
+        sender->timer_ns = 0;
+    }
+    if (sender->len > 0 && sender->timer_ns == 0) {
+        arm_timer(sender, sender->first_ns + sender->delay_ns);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief 写出剩余的消息并释放发送器，不关闭套接字
+ * @param  sender           发送器
+ * @return int 如果关闭成功，返回1;如果写出剩余消息失败，返回-1
+ */
+int close_socket_batch_sender(SocketBatchSender *sender) {
+    int ret = flush_socket_batch_sender(sender);
+
+    release_socket_message(&sender->buffer);
+    close(sender->timer_fd);
+    sender->timer_fd = -1;
+
+    return ret < 0 ? -1 : 1;
+}
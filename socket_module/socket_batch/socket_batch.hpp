@@ -0,0 +1,51 @@
+/**
+ * @file socket_batch.hpp
+ * @brief 声名了合并小消息的批量发送器，缓存达到阈值或等待超过截止时间时一次写出
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_BATCH_HPP_
+#define SOCKET_BATCH_HPP_
+
+#include <stdint.h>
+
+#include "../socket_message.hpp"
+
+#define DEFAULT_SOCKET_BATCH_LEN (16 * 1024)  // 缓存达到该字节数时立即写出
+#define DEFAULT_SOCKET_BATCH_DELAY_US 200     // 消息在缓存中的最长等待时间
+#define DEFAULT_SOCKET_BATCH_TIMEOUT_MS 1000  // 单次写出等待发送缓存的最长时间
+
+/**
+ * 每个连接一个发送器，不是线程安全的。
+ * 空闲一段时间后的第一条消息直接发出，随后的消息进入缓存，因此稀疏的消息不会增加延迟;
+ * 连续的消息被合并，最多等待delay_us。timer_fd在有消息等待时被设置，
+ * 可以加入epoll，可读时调用check_socket_batch_deadline;也可以在发送循环中轮询该函数。
+ */
+typedef struct SocketBatchSender {
+    int socket_fd;
+    int timer_fd;
+    SocketMessage buffer;
+    size_t len;        // 缓存中等待发出的字节数
+    size_t flush_len;  // 写出阈值
+    uint64_t delay_ns;
+    int timeout_ms;     // 单次写出的超时时间，小于0时一直等待
+    uint64_t first_ns;  // 缓存中第一条消息的时间
+    uint64_t last_flush_ns;
+    uint64_t timer_ns;  // timer_fd的到期时间，为0时未设置
+} SocketBatchSender;
+
+int init_socket_batch_sender(
+    SocketBatchSender *sender, const int socket_fd,
+    const size_t flush_len = DEFAULT_SOCKET_BATCH_LEN,
+    const uint64_t delay_us = DEFAULT_SOCKET_BATCH_DELAY_US,
+    const int timeout_ms = DEFAULT_SOCKET_BATCH_TIMEOUT_MS);
+int push_socket_batch_msg(SocketBatchSender *sender, const SocketMessage *msg);
+int push_socket_batch_frame(SocketBatchSender *sender, const uint16_t type,
+                            const SocketMessage *msg);
+int flush_socket_batch_sender(SocketBatchSender *sender);
+int check_socket_batch_deadline(SocketBatchSender *sender);
+int close_socket_batch_sender(SocketBatchSender *sender);
+
+#endif  // SOCKET_BATCH_HPP_
@@ -0,0 +1,222 @@
+/**
+ * @file socket_deadline.cpp
+ * @brief
+ * 实现了带截止时间的收发。每次收发都以MSG_DONTWAIT发起，遇到EAGAIN时用poll等待到截止时间为止，
+ * 因此无论套接字本身是否为非阻塞模式，单次调用的耗时都不会超过timeout_ms。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_deadline.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include "../socket_metrics/socket_metrics.hpp"
+
+/**
+ * @brief 获取单调时钟的当前时间
+ * @return int64_t 毫秒数
+ */
+static int64_t now_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * @brief 将相对超时换算为绝对截止时间
+ * @param  timeout_ms       超时时间，小于0时表示不设截止时间
+ * @return int64_t 截止时间;如果不设截止时间，返回-1
+ */
+static int64_t make_deadline(const int timeout_ms) {
+    return timeout_ms < 0 ? -1 : now_ms() + timeout_ms;
+}
+
+/**
+ * @brief 在截止时间之前等待套接字就绪，被信号打断时继续等待剩余的时间
+ * @param  socket_fd        套接字的socket_fd
+ * @param  events           POLLIN或POLLOUT
+ * @param  deadline         make_deadline的返回值
+ * @return int 如果就绪(含出错或对端关闭)，返回1;如果超时，返回-1并置errno为ETIMEDOUT
+ */
+static int wait_until(const int socket_fd, const short events,
+                      const int64_t deadline) {
+    struct pollfd pfd;
+    pfd.fd = socket_fd;
+    pfd.events = events;
+
+    while (1) {
+        int timeout = -1;
+        if (deadline >= 0) {
+            int64_t remain = deadline - now_ms();
+            timeout = remain > 0 ? (int)remain : 0;
+        }
+
+        int ret = poll(&pfd, 1, timeout);
+        if (ret > 0) return 1;
+        if (ret == 0) {
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        if (errno != EINTR) return -1;
+    }
+}
+
+/**
+ * @brief 判断收发失败是否只是暂时没有数据或缓存空间
+ * @return bool 如果应当等待后重试，返回true
+ */
+static bool should_wait() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 设置套接字的非阻塞模式
+ * @param  socket_fd        套接字的socket_fd
+ * @param  nonblocking      是否为非阻塞模式
+ * @return int 如果设置成功，返回1;如果设置失败，返回-1
+ */
+int set_socket_nonblocking(const int socket_fd, const bool nonblocking) {
+    int flags = fcntl(socket_fd, F_GETFL, 0);
+    if (flags < 0) return -1;
+
+    flags = nonblocking ? flags | O_NONBLOCK : flags & ~O_NONBLOCK;
+    return fcntl(socket_fd, F_SETFL, flags) < 0 ? -1 : 1;
+}
+
+/**
+ * @brief 等待套接字可读或可写
+ * @param  socket_fd        套接字的socket_fd
+ * @param  events           POLLIN或POLLOUT
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果就绪，返回1;如果超时，返回-1并置errno为ETIMEDOUT;如果等待失败，返回-1
+ */
+int wait_socket_ready(const int socket_fd, const short events,
+                      const int timeout_ms) {
+    return wait_until(socket_fd, events, make_deadline(timeout_ms));
+}
+
+/**
+ * @brief 流式套接字在截止时间之前发出全部数据，处理部分写入;对端关闭时不产生SIGPIPE
+ * @param  socket_fd        流式套接字的socket_fd
+ * @param  msg              需要发送的数据
+ * @param  timeout_ms       整个调用的超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果全部发出，返回msg->len;如果超时，返回-1并置errno为ETIMEDOUT，此时可能已发出部分数据，连接应当关闭;如果发送失败，返回-1
+ */
+int send_socket_all(const int socket_fd, const SocketMessage *msg,
+                    const int timeout_ms) {
+    int64_t deadline = make_deadline(timeout_ms);
+    uint64_t start_ns = start_socket_metrics_clock();
+    size_t sent = 0;
+
+    while (sent < msg->len) {
+        ssize_t ret = send(socket_fd, msg->buf + sent, msg->len - sent,
+                           MSG_DONTWAIT | MSG_NOSIGNAL);
+        record_socket_syscall(socket_fd, SOCKET_METRICS_SEND, ret,
+                              msg->len - sent);
+        if (ret >= 0) {
+            sent += ret;
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (!should_wait()) return -1;
+        if (wait_until(socket_fd, POLLOUT, deadline) < 0) return -1;
+    }
+    record_socket_msg(socket_fd, SOCKET_METRICS_SEND, 1, start_ns);
+
+    return sent;
+}
+
+/**
+ * @brief 流式套接字在截止时间之前恰好接收msg->len字节
+ * @param  socket_fd        流式套接字的socket_fd
+ * @param  msg              接收缓存，接收的字节数等于缓存长度
+ * @param  timeout_ms       整个调用的超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int
+ * 如果接收完整，返回msg->len;如果对端在收到任何数据前关闭，返回0;如果超时，返回-1并置errno为ETIMEDOUT;
+ * 如果对端在数据不完整时关闭，返回-1并置errno为ECONNRESET;如果接收失败，返回-1
+ */
+int recv_socket_exact(const int socket_fd, const SocketMessage *msg,
+                      const int timeout_ms) {
+    int64_t deadline = make_deadline(timeout_ms);
+    uint64_t start_ns = start_socket_metrics_clock();
+    size_t received = 0;
+
+    while (received < msg->len) {
+        ssize_t ret = recv(socket_fd, msg->buf + received,
+                           msg->len - received, MSG_DONTWAIT);
+        record_socket_syscall(socket_fd, SOCKET_METRICS_RECV, ret,
+                              msg->len - received);
+        if (ret > 0) {
+            received += ret;
+            continue;
+        }
+        if (ret == 0) {
+            if (received == 0) return 0;
+            errno = ECONNRESET;
+            return -1;
+        }
+        if (errno == EINTR) continue;
+        if (!should_wait()) return -1;
+        if (wait_until(socket_fd, POLLIN, deadline) < 0) return -1;
+    }
+    record_socket_msg(socket_fd, SOCKET_METRICS_RECV, 1, start_ns);
+
+    return received;
+}
+
+/**
+ * @brief 已连接的数据报套接字在截止时间之前发出一个报文
+ * @param  socket_fd        数据报套接字的socket_fd
+ * @param  msg              需要发送的数据
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果发送成功，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+ */
+int send_socket_dgram(const int socket_fd, const SocketMessage *msg,
+                      const int timeout_ms) {
+    int64_t deadline = make_deadline(timeout_ms);
+    uint64_t start_ns = start_socket_metrics_clock();
+
+    while (1) {
+        ssize_t ret = send(socket_fd, msg->buf, msg->len, MSG_DONTWAIT);
+        record_socket_syscall(socket_fd, SOCKET_METRICS_SEND, ret, msg->len);
+        if (ret >= 0) {
+            record_socket_msg(socket_fd, SOCKET_METRICS_SEND, 1, start_ns);
+            return ret;
+        }
+        if (errno == EINTR) continue;
+        if (!should_wait()) return -1;
+        if (wait_until(socket_fd, POLLOUT, deadline) < 0) return -1;
+    }
+}
+
+/**
+ * @brief 数据报套接字在截止时间之前接收一个报文
+ * @param  socket_fd        数据报套接字的socket_fd
+ * @param  msg              接收缓存
+ * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果接收成功，返回报文的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果接收失败，返回-1
+ */
+int recv_socket_dgram(const int socket_fd, const SocketMessage *msg,
+                      const int timeout_ms) {
+    int64_t deadline = make_deadline(timeout_ms);
+    uint64_t start_ns = start_socket_metrics_clock();
+
+    while (1) {
+        ssize_t ret = recv(socket_fd, msg->buf, msg->len, MSG_DONTWAIT);
+        record_socket_syscall(socket_fd, SOCKET_METRICS_RECV, ret, msg->len);
+        if (ret >= 0) {
+            record_socket_msg(socket_fd, SOCKET_METRICS_RECV, 1, start_ns);
+            return ret;
+        }
+        if (errno == EINTR) continue;
+        if (!should_wait()) return -1;
+        if (wait_until(socket_fd, POLLIN, deadline) < 0) return -1;
+    }
+}
@@ -0,0 +1,30 @@
+/**
+ * @file socket_deadline.hpp
+ * @brief 声名了带截止时间的非阻塞收发函数，超时后返回而不是无限期阻塞
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_DEADLINE_HPP_
+#define SOCKET_DEADLINE_HPP_
+
+#include <stdint.h>
+
+#include "../socket_message.hpp"
+
+#define SOCKET_WAIT_FOREVER -1  // timeout_ms取该值时不设截止时间
+
+int set_socket_nonblocking(const int socket_fd, const bool nonblocking);
+int wait_socket_ready(const int socket_fd, const short events,
+                      const int timeout_ms);
+int send_socket_all(const int socket_fd, const SocketMessage *msg,
+                    const int timeout_ms);
+int recv_socket_exact(const int socket_fd, const SocketMessage *msg,
+                      const int timeout_ms);
+int send_socket_dgram(const int socket_fd, const SocketMessage *msg,
+                      const int timeout_ms);
+int recv_socket_dgram(const int socket_fd, const SocketMessage *msg,
+                      const int timeout_ms);
+
+#endif  // SOCKET_DEADLINE_HPP_
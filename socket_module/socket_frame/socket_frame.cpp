@@ -0,0 +1,218 @@
+/**
+ * @file socket_frame.cpp
+ * @brief
+ * 实现了长度前缀分帧协议。发送端一次writev发出帧头与负载，接收端在同一块缓存中原地解出多帧，
+ * 不再依赖一次send对应一次recv。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_frame.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstring>
+
+#include "../socket_metrics/socket_metrics.hpp"
+
+/**
+ * @brief 将未解出的数据移动到缓存头部，只在尾部空间不足时调用
+ * @param  decoder          解帧器
+ */
+static void compact_decoder(SocketFrameDecoder *decoder) {
+    if (decoder->begin == 0) return;
+    memmove(decoder->buf, decoder->buf + decoder->begin,
+            decoder->end - decoder->begin);
+    decoder->end -= decoder->begin;
+    decoder->begin = 0;
+}
+
+/**
+ * @brief 为接收新数据腾出缓存尾部的空间
+ * @param  decoder          解帧器
+ */
+static void reserve_decoder(SocketFrameDecoder *decoder) {
+    if (decoder->begin == decoder->end) {
+        decoder->begin = decoder->end = 0;
+    } else if (decoder->cap - decoder->end < decoder->cap / 2) {
+        // 此时缓存头部只剩一个不完整的帧，移动的字节数不超过一帧
+        compact_decoder(decoder);
+    }
+}
+
+/**
+ * @brief 初始化解帧器
+ * @param  decoder          需要初始化的解帧器
+ * @param  buffer           解帧器使用的接收缓存，容量需要大于最大帧长
+ * @return int 如果初始化成功，返回1;如果缓存容量不足一个帧头，返回-1
+ */
+int init_socket_frame_decoder(SocketFrameDecoder *decoder,
+                              const SocketMessage *buffer) {
+    if (buffer->len < SOCKET_FRAME_HEADER_SIZE) return -1;
+
+    decoder->buf = buffer->buf;
+    decoder->cap = buffer->len;
+    decoder->begin = 0;
+    decoder->end = 0;
+
+    return 1;
+}
+
+/**
+ * @brief 从套接字接收数据直接写入解帧器的缓存
+ * @param  decoder          解帧器
+ * @param  socket_fd        流式套接字
+ * @return int
+ * 如果接收成功，返回接收的字节数;如果对端关闭，返回0;如果接收失败或缓存已满，返回-1
+ */
+int fill_socket_frame_decoder(SocketFrameDecoder *decoder,
+                              const int socket_fd) {
+    ssize_t ret = 0;
+
+    reserve_decoder(decoder);
+    if (decoder->end == decoder->cap) compact_decoder(decoder);
+    if (decoder->end == decoder->cap) return -1;
+
+    do {
+        ret = recv(socket_fd, decoder->buf + decoder->end,
+                   decoder->cap - decoder->end, 0);
+        record_socket_syscall(socket_fd, SOCKET_METRICS_RECV, ret,
+                              decoder->cap - decoder->end);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret > 0) decoder->end += ret;
+    return ret;
+}
+
+/**
+ * @brief 将已经接收到的数据追加到解帧器中，用于配合事件循环等自行接收数据的场景
+ * @param  decoder          解帧器
+ * @param  data             数据指针
+ * @param  len              数据长度
+ * @return int 如果追加成功，返回1;如果缓存空间不足，返回-1
+ */
+int feed_socket_frame_decoder(SocketFrameDecoder *decoder, const char *data,
+                              const size_t len) {
+    reserve_decoder(decoder);
+    if (decoder->cap - decoder->end < len) compact_decoder(decoder);
+    if (decoder->cap - decoder->end < len) return -1;
+
+    memcpy(decoder->buf + decoder->end, data, len);
+    decoder->end += len;
+
+    return 1;
+}
+
+/**
+ * @brief 从解帧器中解出下一帧，帧的负载指向解帧器缓存，在下一次接收前有效
+ * @param  decoder          解帧器
+ * @param  frame            解出的帧
+ * @return int
+ * 如果解出一帧，返回1;如果数据不足一帧，返回0;如果帧长超过缓存容量，返回-1
+ */
+int next_socket_frame(SocketFrameDecoder *decoder, SocketFrame *frame) {
+    SocketFrameHeader header;
+    size_t avail = decoder->end - decoder->begin;
+    size_t len = 0;
+
+    if (avail < SOCKET_FRAME_HEADER_SIZE) return 0;
+
+    memcpy(&header, decoder->buf + decoder->begin, SOCKET_FRAME_HEADER_SIZE);
+    len = ntohl(header.len);
+    if (len > MAX_FRAME_PAYLOAD_LEN ||
+        len > decoder->cap - SOCKET_FRAME_HEADER_SIZE) {
+        return -1;
+    }
+    if (avail < SOCKET_FRAME_HEADER_SIZE + len) return 0;
+
+    frame->type = ntohs(header.type);
+    frame->flags = ntohs(header.flags);
+    frame->payload.buf =
+        decoder->buf + decoder->begin + SOCKET_FRAME_HEADER_SIZE;
+    frame->payload.len = len;
+    decoder->begin += SOCKET_FRAME_HEADER_SIZE + len;
+
+    return 1;
+}
+
+/**
+ * @brief 阻塞接收一帧，缓存中已有完整帧时不会再调用recv
+ * @param  socket_fd        流式套接字
+ * @param  decoder          解帧器
+ * @param  frame            解出的帧
+ * @return int 如果接收成功，返回1;如果对端关闭，返回0;如果接收失败，返回-1
+ */
+int recv_socket_frame(const int socket_fd, SocketFrameDecoder *decoder,
+                      SocketFrame *frame) {
+    uint64_t start_ns = start_socket_metrics_clock();
+    int ret = 0;
+    while (1) {
+        ret = next_socket_frame(decoder, frame);
+        if (ret > 0) {
+            record_socket_msg(socket_fd, SOCKET_METRICS_RECV, 1, start_ns);
+        }
+        if (ret != 0) return ret;
+
+        ret = fill_socket_frame_decoder(decoder, socket_fd);
+        if (ret <= 0) return ret;
+    }
+}
+
+/**
+ * @brief 发送一帧，帧头与负载通过一次writev发出，并处理部分写入
+ * @param  socket_fd        流式套接字
+ * @param  type             消息类型
+ * @param  msg              负载数据
+ * @param  flags            帧头中的标志字段
+ * @return int 如果发送成功，返回发送的总字节数(含帧头);如果发送失败，返回-1
+ */
+int send_socket_frame(const int socket_fd, const uint16_t type,
+                      const SocketMessage *msg, const uint16_t flags) {
+    SocketFrameHeader header;
+    struct iovec iov[2];
+    int iov_cnt = 2;
+    struct iovec *cur = iov;
+    size_t total = SOCKET_FRAME_HEADER_SIZE + msg->len;
+    size_t sent = 0;
+
+    if (msg->len > MAX_FRAME_PAYLOAD_LEN) return -1;
+
+    header.len = htonl(msg->len);
+    header.type = htons(type);
+    header.flags = htons(flags);
+
+    iov[0].iov_base = &header;
+    iov[0].iov_len = SOCKET_FRAME_HEADER_SIZE;
+    iov[1].iov_base = msg->buf;
+    iov[1].iov_len = msg->len;
+
+    uint64_t start_ns = start_socket_metrics_clock();
+    while (sent < total) {
+        ssize_t ret = writev(socket_fd, cur, iov_cnt);
+        record_socket_syscall(socket_fd, SOCKET_METRICS_SEND, ret,
+                              total - sent);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        sent += ret;
+
+        // 跳过已经完整写出的段，并调整部分写出的段
+        while (iov_cnt > 0 && (size_t)ret >= cur->iov_len) {
+            ret -= cur->iov_len;
+            ++cur;
+            --iov_cnt;
+        }
+        if (iov_cnt > 0) {
+            cur->iov_base = (char *)cur->iov_base + ret;
+            cur->iov_len -= ret;
+        }
+    }
+    record_socket_msg(socket_fd, SOCKET_METRICS_SEND, 1, start_ns);
+
+    return total;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file socket_frame.hpp
+ * @brief 声名了流式套接字上的长度前缀分帧协议与增量解帧器
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_FRAME_HPP_
+#define SOCKET_FRAME_HPP_
+
+#include <stdint.h>
+
+#include "../socket_message.hpp"
+
+#define SOCKET_FRAME_HEADER_SIZE 8
+#define MAX_FRAME_PAYLOAD_LEN (16 * 1024 * 1024)
+
+// 帧头，所有字段均为网络字节序
+typedef struct SocketFrameHeader {
+    uint32_t len;    // 负载长度，不含帧头
+    uint16_t type;   // 用户自定义的消息类型
+    uint16_t flags;  // 保留字段
+} SocketFrameHeader;
+
+// 解出的一帧，payload直接指向解帧器的接收缓存，不发生拷贝
+typedef struct SocketFrame {
+    uint16_t type;
+    uint16_t flags;
+    SocketMessage payload;
+} SocketFrame;
+
+// 增量解帧器，[begin, end)为已接收但尚未解出的数据
+typedef struct SocketFrameDecoder {
+    char *buf;
+    size_t cap;
+    size_t begin;
+    size_t end;
+} SocketFrameDecoder;
+
+int init_socket_frame_decoder(SocketFrameDecoder *decoder,
+                              const SocketMessage *buffer);
+int fill_socket_frame_decoder(SocketFrameDecoder *decoder, const int socket_fd);
+int feed_socket_frame_decoder(SocketFrameDecoder *decoder, const char *data,
+                              const size_t len);
+int next_socket_frame(SocketFrameDecoder *decoder, SocketFrame *frame);
+int recv_socket_frame(const int socket_fd, SocketFrameDecoder *decoder,
+                      SocketFrame *frame);
+int send_socket_frame(const int socket_fd, const uint16_t type,
+                      const SocketMessage *msg, const uint16_t flags = 0);
+
+#endif  // SOCKET_FRAME_HPP_
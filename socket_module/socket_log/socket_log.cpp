@@ -0,0 +1,340 @@
+/**
+ * @file socket_log.cpp
+ * @brief
+ * 实现了异步日志。调用线程只把格式化后的日志写入无锁的多生产者环形队列，由后台线程批量写出，
+ * 队列已满时直接丢弃并计数，不会阻塞套接字的收发路径。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_log.hpp"
+
+#include <linux/futex.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define SOCKET_LOG_WRITE_BUFFER_SIZE 65536
+#define SOCKET_LOG_IDLE_WAIT_MS 100  // 后台线程空闲时的最长等待时间
+
+typedef struct SocketLogSlot {
+    std::atomic<uint64_t> seq;
+    int level;
+    int len;
+    struct timespec time;
+    char line[SOCKET_LOG_LINE_SIZE];
+} SocketLogSlot;
+
+static SocketLogSlot log_ring[SOCKET_LOG_RING_SIZE];
+alignas(64) static std::atomic<uint64_t> log_head(0);     // 生产者写入位置
+alignas(64) static std::atomic<uint64_t> log_flushed(0);  // 已写出的位置
+alignas(64) static std::atomic<uint32_t> writer_waiting(0);
+static std::atomic<uint32_t> writer_futex(0);
+
+static std::atomic<int> log_level(SOCKET_LOG_MIN_LEVEL);
+static std::atomic<int> log_fd(STDOUT_FILENO);
+static std::atomic<uint64_t> log_dropped_num(0);
+static std::atomic<bool> writer_running(false);
+static std::atomic<uint32_t> log_producers(0);  // 正在写入日志的调用线程数
+static std::once_flag writer_once;
+static std::thread writer;
+
+static std::mutex flush_lock;
+static std::condition_variable flush_cond;  // 有日志写出或后台线程退出时通知
+static std::atomic<uint32_t> flush_waiters(0);
+
+static const char log_level_tag[] = {'D', 'I', 'W', 'E'};
+
+/**
+ * @brief 将缓存中的数据全部写出，处理部分写入
+ * @param  buf              数据缓存
+ * @param  len              数据长度
+ */
+static void write_all(const char *buf, size_t len) {
+    int fd = log_fd.load(std::memory_order_relaxed);
+    while (len > 0) {
+        ssize_t ret = write(fd, buf, len);
+        if (ret <= 0) return;
+        buf += ret;
+        len -= ret;
+    }
+}
+
+/**
+ * @brief 为一条日志加上时间与级别，追加到输出缓存
+ * @param  out              输出缓存
+ * @param  out_cap          输出缓存的容量
+ * @param  out_len          输出缓存中已有的字节数
+ * @param  level            日志级别
+ * @param  time             日志产生的时间
+ * @param  line             日志内容
+ * @param  len              日志内容的长度
+ * @return size_t 追加后输出缓存中的字节数
+ */
+static size_t format_line(char *out, const size_t out_cap, size_t out_len,
+                          const int level, const struct timespec *time,
+                          const char *line, const int len) {
+    struct tm tm_time;
+    int ret = 0;
+
+    localtime_r(&time->tv_sec, &tm_time);
+    out_len += strftime(out + out_len, out_cap - out_len, "%Y-%m-%d %H:%M:%S",
+                        &tm_time);
+    ret = snprintf(out + out_len, out_cap - out_len, ".%06ld [%c] %.*s\n",
+                   time->tv_nsec / 1000, log_level_tag[level], len, line);
+    if (ret > 0) out_len += (size_t)ret < out_cap - out_len ? ret : 0;
+    return out_len;
+}
+
+/**
+ * @brief 取出队列中所有已提交的日志并写出
+ * @param  tail             后台线程的读取位置
+ * @return size_t 写出的日志条数
+ */
+static size_t drain_log_ring(uint64_t *tail) {
+    static char out[SOCKET_LOG_WRITE_BUFFER_SIZE];
+    size_t out_len = 0;
+    size_t num = 0;
+
+    while (1) {
+        SocketLogSlot *slot = &log_ring[*tail & (SOCKET_LOG_RING_SIZE - 1)];
+        if (slot->seq.load(std::memory_order_acquire) != *tail + 1) break;
+
+        // 一条日志格式化后不超过行长加上时间与级别
+        if (sizeof(out) - out_len < SOCKET_LOG_LINE_SIZE + 64) {
+            write_all(out, out_len);
+            out_len = 0;
+        }
+        out_len = format_line(out, sizeof(out), out_len, slot->level,
+                              &slot->time, slot->line, slot->len);
+
+        slot->seq.store(*tail + SOCKET_LOG_RING_SIZE,
+                        std::memory_order_release);
+        ++*tail;
+        ++num;
+    }
+
+    if (out_len > 0) write_all(out, out_len);
+    log_flushed.store(*tail, std::memory_order_seq_cst);
+
+    // 先发布写出位置再检查等待者，与flush_socket_log的计数配对
+    if (flush_waiters.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> guard(flush_lock);
+        flush_cond.notify_all();
+    }
+
+    return num;
+}
+
+/**
+ * @brief 后台线程的入口，队列为空时在futex上等待，由生产者按需唤醒。
+ * 关闭后还要等正在写入的调用线程提交，它们占用的槽位全部写出后才退出
+ */
+static void run_log_writer() {
+    uint64_t tail = 0;
+    struct timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = SOCKET_LOG_IDLE_WAIT_MS * 1000000L;
+
+    while (1) {
+        if (drain_log_ring(&tail) > 0) continue;
+        if (!writer_running.load() && log_producers.load() == 0 &&
+            log_head.load() == tail) {
+            break;
+        }
+
+        // 先置等待标志再检查一次队列，与生产者的唤醒配对
+        writer_waiting.store(1, std::memory_order_seq_cst);
+        uint32_t val = writer_futex.load();
+        if (log_head.load() == tail &&
+            (writer_running.load() || log_producers.load() > 0)) {
+            syscall(SYS_futex, &writer_futex, FUTEX_WAIT_PRIVATE, val,
+                    &timeout, NULL, 0);
+        }
+        writer_waiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 唤醒处于等待状态的后台线程，后台线程忙碌时不产生系统调用
+ * @param  force            是否无论后台线程是否等待都发起唤醒
+ */
+static void wake_log_writer(const bool force) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!force && writer_waiting.load(std::memory_order_relaxed) == 0) return;
+    writer_futex.fetch_add(1);
+    syscall(SYS_futex, &writer_futex, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+/**
+ * @brief 初始化队列并启动后台线程，只在第一次写日志时执行一次
+ */
+static void start_log_writer() {
+    for (uint64_t i = 0; i < SOCKET_LOG_RING_SIZE; ++i) {
+        log_ring[i].seq.store(i, std::memory_order_relaxed);
+    }
+    writer_running.store(true);
+    writer = std::thread(run_log_writer);
+}
+
+// 进程退出时写出剩余的日志
+static struct SocketLogCloser {
+    ~SocketLogCloser() { close_socket_log(); }
+} socket_log_closer;
+
+// 调用线程在计数内判断后台线程是否运行并写入队列，关闭后的后台线程据此等待它们提交
+struct SocketLogProducer {
+    SocketLogProducer() { log_producers.fetch_add(1); }
+    ~SocketLogProducer() {
+        log_producers.fetch_sub(1);
+        if (!writer_running.load()) wake_log_writer(false);
+    }
+};
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 写一条日志，只做格式化与入队，写出由后台线程完成
+ * @param  level            日志级别
+ * @param  format           printf风格的格式串
+ * @return int
+ * 如果写入成功，返回1;如果低于运行期级别，返回0;如果队列已满被丢弃，返回-1
+ */
+int write_socket_log(const int level, const char *const format, ...) {
+    va_list args;
+    int len = 0;
+
+    if (level < log_level.load(std::memory_order_relaxed) ||
+        level >= SOCKET_LOG_LEVEL_OFF) {
+        return 0;
+    }
+
+    std::call_once(writer_once, start_log_writer);
+    SocketLogProducer producer;
+
+    // 后台线程已关闭时直接写出，保证进程退出阶段的日志不丢失
+    if (!writer_running.load()) {
+        char out[SOCKET_LOG_LINE_SIZE + 64];
+        char line[SOCKET_LOG_LINE_SIZE];
+        struct timespec time;
+        clock_gettime(CLOCK_REALTIME, &time);
+        va_start(args, format);
+        len = vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        if (len < 0) return -1;
+        if (len >= SOCKET_LOG_LINE_SIZE) len = SOCKET_LOG_LINE_SIZE - 1;
+        write_all(out,
+                  format_line(out, sizeof(out), 0, level, &time, line, len));
+        return 1;
+    }
+
+    uint64_t pos = log_head.load(std::memory_order_relaxed);
+    SocketLogSlot *slot = NULL;
+    while (1) {
+        slot = &log_ring[pos & (SOCKET_LOG_RING_SIZE - 1)];
+        uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff < 0) {
+            log_dropped_num.fetch_add(1, std::memory_order_relaxed);
+            wake_log_writer(false);
+            return -1;
+        }
+        if (diff > 0) {
+            pos = log_head.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (log_head.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    clock_gettime(CLOCK_REALTIME, &slot->time);
+    va_start(args, format);
+    len = vsnprintf(slot->line, SOCKET_LOG_LINE_SIZE, format, args);
+    va_end(args);
+    if (len < 0) len = 0;
+    if (len >= SOCKET_LOG_LINE_SIZE) len = SOCKET_LOG_LINE_SIZE - 1;
+    slot->level = level;
+    slot->len = len;
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    wake_log_writer(false);
+
+    return 1;
+}
+
+/**
+ * @brief 设置运行期的日志级别，只能在编译期级别的基础上进一步提高
+ * @param  level            日志级别
+ * @return int 如果设置成功，返回1;如果级别无效，返回-1
+ */
+int set_socket_log_level(const int level) {
+    if (level < SOCKET_LOG_LEVEL_DEBUG || level > SOCKET_LOG_LEVEL_OFF) {
+        return -1;
+    }
+    log_level.store(level);
+    return 1;
+}
+
+/**
+ * @brief 设置日志写出的文件描述符，默认为标准输出
+ * @param  fd               文件描述符
+ * @return int 如果设置成功，返回1;如果fd无效，返回-1
+ */
+int set_socket_log_fd(const int fd) {
+    if (fd < 0) return -1;
+    log_fd.store(fd);
+    return 1;
+}
+
+/**
+ * @brief 获取因队列已满而被丢弃的日志条数
+ * @return uint64_t 被丢弃的日志条数
+ */
+uint64_t get_socket_log_dropped_num() {
+    return log_dropped_num.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 等待调用前提交的日志全部写出
+ * @return int 写出完成，返回1
+ */
+int flush_socket_log() {
+    uint64_t pos = log_head.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> guard(flush_lock);
+
+    flush_waiters.fetch_add(1, std::memory_order_seq_cst);
+    wake_log_writer(true);
+    while (writer_running.load() && log_flushed.load() < pos) {
+        flush_cond.wait(guard);
+    }
+    flush_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+    return 1;
+}
+
+/**
+ * @brief 写出剩余的日志并停止后台线程，之后的日志由调用线程直接写出，
+ * 关闭前已进入队列的日志都会写出
+ * @return int 关闭成功，返回1
+ */
+int close_socket_log() {
+    if (!writer_running.exchange(false)) return 1;
+
+    wake_log_writer(true);
+    if (writer.joinable()) writer.join();
+
+    std::lock_guard<std::mutex> guard(flush_lock);
+    flush_cond.notify_all();
+
+    return 1;
+}
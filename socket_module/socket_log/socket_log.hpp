@@ -0,0 +1,48 @@
+/**
+ * @file socket_log.hpp
+ * @brief 声名了分级的异步日志，低于编译期级别的日志连同参数求值一起被移除
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_LOG_HPP_
+#define SOCKET_LOG_HPP_
+
+#include <stdint.h>
+
+#define SOCKET_LOG_LEVEL_DEBUG 0
+#define SOCKET_LOG_LEVEL_INFO 1
+#define SOCKET_LOG_LEVEL_WARN 2
+#define SOCKET_LOG_LEVEL_ERROR 3
+#define SOCKET_LOG_LEVEL_OFF 4
+
+// 由CMake的SOCKET_LOG_MIN_LEVEL选项统一指定
+#ifndef SOCKET_LOG_MIN_LEVEL
+#define SOCKET_LOG_MIN_LEVEL SOCKET_LOG_LEVEL_INFO
+#endif
+
+#define SOCKET_LOG_RING_SIZE 1024  // 日志队列的槽位数量，必须是2的幂
+#define SOCKET_LOG_LINE_SIZE 256   // 单条日志的最大长度，超出部分被截断
+
+#define SOCKET_LOG(level, ...)                      \
+    do {                                            \
+        if ((level) >= SOCKET_LOG_MIN_LEVEL) {      \
+            write_socket_log((level), __VA_ARGS__); \
+        }                                           \
+    } while (0)
+
+#define SOCKET_LOG_DEBUG(...) SOCKET_LOG(SOCKET_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define SOCKET_LOG_INFO(...) SOCKET_LOG(SOCKET_LOG_LEVEL_INFO, __VA_ARGS__)
+#define SOCKET_LOG_WARN(...) SOCKET_LOG(SOCKET_LOG_LEVEL_WARN, __VA_ARGS__)
+#define SOCKET_LOG_ERROR(...) SOCKET_LOG(SOCKET_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+int write_socket_log(const int level, const char *const format, ...)
+    __attribute__((format(printf, 2, 3)));
+int set_socket_log_level(const int level);
+int set_socket_log_fd(const int fd);
+uint64_t get_socket_log_dropped_num();
+int flush_socket_log();
+int close_socket_log();
+
+#endif  // SOCKET_LOG_HPP_
@@ -6,9 +6,14 @@
  * @date 2021-05-15
  */
 
+#ifndef SOCKET_MESSAGE_HPP_
+#define SOCKET_MESSAGE_HPP_
+
 #include <stdlib.h>
 
 typedef struct SocketMessage {
     char *buf;
     size_t len;
-} SocketMessage;
\ No newline at end of file
+} SocketMessage;
+
+#endif  // SOCKET_MESSAGE_HPP_
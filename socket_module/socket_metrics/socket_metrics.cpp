@@ -0,0 +1,594 @@
+/**
+ * @file socket_metrics.cpp
+ * @brief
+ * 实现了套接字收发的运行期统计。每个套接字的统计在第一次收发时按socket_fd分配，之后只做relaxed原子累加;
+ * 全局统计按线程分散到多个缓存行，避免多线程收发时争用同一计数器。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_metrics.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+#include "../socket_log/socket_log.hpp"
+#include "../socket_transport/socket_address.hpp"
+
+#define SOCKET_METRICS_LINE_SIZE 1024
+#define SOCKET_METRICS_POLL_MS 100  // 查询端点检查退出标志的间隔
+
+typedef struct AtomicCounters {
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> msgs;
+    std::atomic<uint64_t> syscalls;
+    std::atomic<uint64_t> eagain;
+    std::atomic<uint64_t> partial;
+    std::atomic<uint64_t> errors;
+} AtomicCounters;
+
+typedef struct AtomicHistogram {
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum_ns;
+    std::atomic<uint64_t> max_ns;
+    std::atomic<uint64_t> buckets[SOCKET_HISTOGRAM_BUCKET_NUM];
+} AtomicHistogram;
+
+typedef struct alignas(64) SocketMetrics {
+    AtomicCounters counters[2];
+    AtomicHistogram latency[2];
+} SocketMetrics;
+
+// 分配后不再释放，socket_fd被复用时原地清零，收发路径上无需加锁
+static std::atomic<SocketMetrics *> socket_metrics_table[SOCKET_METRICS_MAX_FD];
+static SocketMetrics global_metrics[SOCKET_METRICS_THREAD_SLOT_NUM];
+static std::atomic<int> next_thread_slot(0);
+static std::atomic<bool> metrics_enabled(true);
+
+static std::atomic<bool> server_running(false);
+static std::thread server_thread;
+static int server_fd = -1;
+static char server_addr[sizeof(((struct sockaddr_un *)0)->sun_path)];
+
+/**
+ * @brief 将一组原子统计清零
+ * @param  metrics          需要清零的统计
+ */
+static void clear_metrics(SocketMetrics *metrics) {
+    for (int dir = 0; dir < 2; ++dir) {
+        AtomicCounters *c = &metrics->counters[dir];
+        AtomicHistogram *h = &metrics->latency[dir];
+        c->bytes.store(0, std::memory_order_relaxed);
+        c->msgs.store(0, std::memory_order_relaxed);
+        c->syscalls.store(0, std::memory_order_relaxed);
+        c->eagain.store(0, std::memory_order_relaxed);
+        c->partial.store(0, std::memory_order_relaxed);
+        c->errors.store(0, std::memory_order_relaxed);
+        h->count.store(0, std::memory_order_relaxed);
+        h->sum_ns.store(0, std::memory_order_relaxed);
+        h->max_ns.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < SOCKET_HISTOGRAM_BUCKET_NUM; ++i) {
+            h->buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief 查找socket_fd对应的统计
+ * @param  socket_fd        套接字的socket_fd
+ * @param  create           不存在时是否分配
+ * @return SocketMetrics* 对应的统计;如果socket_fd超出范围或尚未分配，返回NULL
+ */
+static SocketMetrics *find_metrics(const int socket_fd, const bool create) {
+    if (socket_fd < 0 || socket_fd >= SOCKET_METRICS_MAX_FD) return NULL;
+
+    std::atomic<SocketMetrics *> &entry = socket_metrics_table[socket_fd];
+    SocketMetrics *metrics = entry.load(std::memory_order_acquire);
+    if (metrics != NULL || !create) return metrics;
+
+    // C++11的new不保证超过16字节的对齐，按缓存行分配后原地构造;
+    // 多个线程同时分配时只保留先完成的一份
+    void *mem = NULL;
+    if (posix_memalign(&mem, alignof(SocketMetrics), sizeof(SocketMetrics)) !=
+        0) {
+        return NULL;
+    }
+    SocketMetrics *fresh = new (mem) SocketMetrics();
+    clear_metrics(fresh);
+    if (entry.compare_exchange_strong(metrics, fresh,
+                                      std::memory_order_acq_rel)) {
+        return fresh;
+    }
+    fresh->~SocketMetrics();
+    free(mem);
+    return metrics;
+}
+
+/**
+ * @brief 获取调用线程的全局统计槽，线程第一次使用时轮流分配
+ * @return SocketMetrics* 调用线程的全局统计槽
+ */
+static SocketMetrics *thread_global_metrics() {
+    static thread_local int slot =
+        next_thread_slot.fetch_add(1, std::memory_order_relaxed) %
+        SOCKET_METRICS_THREAD_SLOT_NUM;
+    return &global_metrics[slot];
+}
+
+/**
+ * @brief 计算时延所在的桶，小于2^SOCKET_HISTOGRAM_SUB_BITS的值各占一个桶
+ * @param  ns               时延，单位为纳秒
+ * @return int 桶的下标
+ */
+static int histogram_bucket(const uint64_t ns) {
+    const uint64_t sub_num = 1ULL << SOCKET_HISTOGRAM_SUB_BITS;
+    if (ns < sub_num) return (int)ns;
+
+    int msb = 63 - __builtin_clzll(ns);
+    if (msb >= SOCKET_HISTOGRAM_MAX_BITS) {
+        return SOCKET_HISTOGRAM_BUCKET_NUM - 1;
+    }
+
+    int shift = msb - SOCKET_HISTOGRAM_SUB_BITS;
+    return ((shift + 1) << SOCKET_HISTOGRAM_SUB_BITS) +
+           (int)((ns >> shift) - sub_num);
+}
+
+/**
+ * @brief 计算桶内可能出现的最大时延
+ * @param  bucket           桶的下标
+ * @return uint64_t 桶的上界，单位为纳秒
+ */
+static uint64_t histogram_bucket_upper(const int bucket) {
+    const uint64_t sub_num = 1ULL << SOCKET_HISTOGRAM_SUB_BITS;
+    if ((uint64_t)bucket < sub_num) return bucket;
+
+    int shift = (bucket >> SOCKET_HISTOGRAM_SUB_BITS) - 1;
+    uint64_t mantissa = (bucket & (sub_num - 1)) + sub_num;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+/**
+ * @brief 按系统调用的返回值累加计数器
+ * @param  metrics          原子统计
+ * @param  dir              SOCKET_METRICS_SEND或SOCKET_METRICS_RECV
+ * @param  ret              系统调用的返回值
+ * @param  len              本次希望收发的字节数
+ * @param  err              系统调用返回后的errno
+ */
+static void add_syscall(SocketMetrics *metrics, const int dir,
+                        const ssize_t ret, const size_t len, const int err) {
+    AtomicCounters *c = &metrics->counters[dir];
+
+    c->syscalls.fetch_add(1, std::memory_order_relaxed);
+    if (ret < 0) {
+        if (err == EAGAIN || err == EWOULDBLOCK) {
+            c->eagain.fetch_add(1, std::memory_order_relaxed);
+        } else if (err != EINTR) {
+            c->errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    c->bytes.fetch_add(ret, std::memory_order_relaxed);
+    if (dir == SOCKET_METRICS_SEND && (size_t)ret < len) {
+        c->partial.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 累加消息数并把本次调用的时延计入直方图
+ * @param  metrics          原子统计
+ * @param  dir              SOCKET_METRICS_SEND或SOCKET_METRICS_RECV
+ * @param  msg_num          本次调用收发的消息数
+ * @param  ns               本次调用的时延，单位为纳秒
+ */
+static void add_msg(SocketMetrics *metrics, const int dir, const int msg_num,
+                    const uint64_t ns) {
+    AtomicHistogram *h = &metrics->latency[dir];
+
+    metrics->counters[dir].msgs.fetch_add(msg_num, std::memory_order_relaxed);
+    h->count.fetch_add(1, std::memory_order_relaxed);
+    h->sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    h->buckets[histogram_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max_ns = h->max_ns.load(std::memory_order_relaxed);
+    while (ns > max_ns && !h->max_ns.compare_exchange_weak(
+                              max_ns, ns, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief 将原子统计读出到快照中，累加到快照已有的值上
+ * @param  metrics          原子统计
+ * @param  snapshot         快照
+ */
+static void merge_snapshot(SocketMetrics *metrics,
+                           SocketMetricsSnapshot *snapshot) {
+    for (int dir = 0; dir < 2; ++dir) {
+        AtomicCounters *c = &metrics->counters[dir];
+        AtomicHistogram *h = &metrics->latency[dir];
+        SocketCounters *sc = &snapshot->counters[dir];
+        SocketHistogram *sh = &snapshot->latency[dir];
+        sc->bytes += c->bytes.load(std::memory_order_relaxed);
+        sc->msgs += c->msgs.load(std::memory_order_relaxed);
+        sc->syscalls += c->syscalls.load(std::memory_order_relaxed);
+        sc->eagain += c->eagain.load(std::memory_order_relaxed);
+        sc->partial += c->partial.load(std::memory_order_relaxed);
+        sc->errors += c->errors.load(std::memory_order_relaxed);
+        sh->count += h->count.load(std::memory_order_relaxed);
+        sh->sum_ns += h->sum_ns.load(std::memory_order_relaxed);
+        uint64_t max_ns = h->max_ns.load(std::memory_order_relaxed);
+        if (max_ns > sh->max_ns) sh->max_ns = max_ns;
+        for (int i = 0; i < SOCKET_HISTOGRAM_BUCKET_NUM; ++i) {
+            sh->buckets[i] += h->buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+
+#if SOCKET_METRICS_ENABLE
+/**
+ * @brief 在收发调用之前取得起始时间
+ * @return uint64_t 单调时钟的纳秒数;如果统计已关闭，返回0
+ */
+uint64_t start_socket_metrics_clock() {
+    struct timespec now;
+    if (!metrics_enabled.load(std::memory_order_relaxed)) return 0;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * @brief 记录一次收发系统调用的结果，不改变errno
+ * @param  socket_fd        套接字的socket_fd
+ * @param  dir              SOCKET_METRICS_SEND或SOCKET_METRICS_RECV
+ * @param  ret              系统调用的返回值
+ * @param  len              本次希望收发的字节数
+ */
+void record_socket_syscall(const int socket_fd, const int dir,
+                           const ssize_t ret, const size_t len) {
+    if (!metrics_enabled.load(std::memory_order_relaxed)) return;
+
+    int err = errno;
+    add_syscall(thread_global_metrics(), dir, ret, len, err);
+    SocketMetrics *metrics = find_metrics(socket_fd, true);
+    if (metrics != NULL) add_syscall(metrics, dir, ret, len, err);
+    errno = err;
+}
+
+/**
+ * @brief 记录成功收发的消息与本次调用的时延，不改变errno
+ * @param  socket_fd        套接字的socket_fd
+ * @param  dir              SOCKET_METRICS_SEND或SOCKET_METRICS_RECV
+ * @param  msg_num          本次调用收发的消息数
+ * @param  start_ns         start_socket_metrics_clock的返回值
+ */
+void record_socket_msg(const int socket_fd, const int dir, const int msg_num,
+                       const uint64_t start_ns) {
+    // 调用开始时统计处于关闭状态，没有可用的起始时间
+    if (start_ns == 0) return;
+
+    int err = errno;
+    uint64_t end_ns = start_socket_metrics_clock();
+    uint64_t ns = end_ns > start_ns ? end_ns - start_ns : 0;
+    add_msg(thread_global_metrics(), dir, msg_num, ns);
+    SocketMetrics *metrics = find_metrics(socket_fd, true);
+    if (metrics != NULL) add_msg(metrics, dir, msg_num, ns);
+    errno = err;
+}
+
+/**
+ * @brief 记录一次收发一条消息的系统调用，ret大于0时同时计入消息数与时延
+ * @param  socket_fd        套接字的socket_fd
+ * @param  dir              SOCKET_METRICS_SEND或SOCKET_METRICS_RECV
+ * @param  ret              系统调用的返回值
+ * @param  len              本次希望收发的字节数
+ * @param  start_ns         start_socket_metrics_clock的返回值
+ */
+void record_socket_io(const int socket_fd, const int dir, const ssize_t ret,
+                      const size_t len, const uint64_t start_ns) {
+    record_socket_syscall(socket_fd, dir, ret, len);
+    if (ret > 0) record_socket_msg(socket_fd, dir, 1, start_ns);
+}
+#endif
+
+/**
+ * @brief 运行期开启或关闭统计，关闭后埋点只剩一次原子读
+ * @param  enabled          是否开启
+ * @return int 设置成功，返回1
+ */
+int set_socket_metrics_enabled(const bool enabled) {
+    metrics_enabled.store(enabled, std::memory_order_relaxed);
+    return 1;
+}
+
+/**
+ * @brief 清零一个套接字的统计，全局统计不受影响
+ * @param  socket_fd        套接字的socket_fd
+ * @return int 如果清零成功，返回1;如果socket_fd超出范围，返回-1
+ */
+int reset_socket_metrics(const int socket_fd) {
+    if (socket_fd < 0 || socket_fd >= SOCKET_METRICS_MAX_FD) return -1;
+
+    SocketMetrics *metrics = find_metrics(socket_fd, false);
+    if (metrics != NULL) clear_metrics(metrics);
+
+    return 1;
+}
+
+/**
+ * @brief 获取一个套接字的统计快照
+ * @param  socket_fd        套接字的socket_fd
+ * @param  snapshot         输出的快照
+ * @return int 如果获取成功，返回1;如果该套接字没有统计，返回-1
+ */
+int get_socket_metrics(const int socket_fd, SocketMetricsSnapshot *snapshot) {
+    SocketMetrics *metrics = find_metrics(socket_fd, false);
+    if (metrics == NULL) return -1;
+
+    memset(snapshot, 0, sizeof(SocketMetricsSnapshot));
+    snapshot->socket_fd = socket_fd;
+    merge_snapshot(metrics, snapshot);
+
+    return 1;
+}
+
+/**
+ * @brief 获取全局统计快照，包含所有套接字(含超出范围的socket_fd)的收发
+ * @param  snapshot         输出的快照，socket_fd为-1
+ * @return int 获取成功，返回1
+ */
+int get_global_socket_metrics(SocketMetricsSnapshot *snapshot) {
+    memset(snapshot, 0, sizeof(SocketMetricsSnapshot));
+    snapshot->socket_fd = -1;
+    for (int i = 0; i < SOCKET_METRICS_THREAD_SLOT_NUM; ++i) {
+        merge_snapshot(&global_metrics[i], snapshot);
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 获取所有有过收发的套接字的统计快照
+ * @param  snapshots        输出的快照数组
+ * @param  num              快照数组的长度
+ * @return int 写入的快照个数
+ */
+int get_all_socket_metrics(SocketMetricsSnapshot *snapshots, const int num) {
+    int cnt = 0;
+
+    for (int fd = 0; fd < SOCKET_METRICS_MAX_FD && cnt < num; ++fd) {
+        if (get_socket_metrics(fd, &snapshots[cnt]) < 0) continue;
+        SocketCounters *c = snapshots[cnt].counters;
+        if (c[SOCKET_METRICS_SEND].syscalls + c[SOCKET_METRICS_RECV].syscalls >
+            0) {
+            ++cnt;
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * @brief 从直方图中估算分位数，结果为所在桶的上界，不超过记录到的最大值
+ * @param  histogram        时延直方图
+ * @param  percentile       分位数，取值范围[0, 100]
+ * @return uint64_t 时延，单位为纳秒;如果直方图为空，返回0
+ */
+uint64_t get_socket_histogram_percentile(const SocketHistogram *histogram,
+                                         const double percentile) {
+    uint64_t total = 0;
+    for (int i = 0; i < SOCKET_HISTOGRAM_BUCKET_NUM; ++i) {
+        total += histogram->buckets[i];
+    }
+    if (total == 0) return 0;
+
+    uint64_t rank = (uint64_t)(percentile / 100.0 * total + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < SOCKET_HISTOGRAM_BUCKET_NUM; ++i) {
+        seen += histogram->buckets[i];
+        if (seen < rank) continue;
+        uint64_t upper = histogram_bucket_upper(i);
+        return upper < histogram->max_ns ? upper : histogram->max_ns;
+    }
+
+    return histogram->max_ns;
+}
+
+/**
+ * @brief 将某一方向的计数器与时延分位数格式化为JSON字段
+ * @return int snprintf的返回值
+ */
+static int format_direction(const char *name, const SocketCounters *c,
+                            const SocketHistogram *h, char *buf,
+                            const size_t len) {
+    return snprintf(
+        buf, len,
+        "\"%s\":{\"bytes\":%llu,\"msgs\":%llu,\"syscalls\":%llu,"
+        "\"eagain\":%llu,\"partial\":%llu,\"errors\":%llu,"
+        "\"mean_ns\":%llu,\"p50_ns\":%llu,\"p99_ns\":%llu,"
+        "\"p999_ns\":%llu,\"max_ns\":%llu}",
+        name, (unsigned long long)c->bytes, (unsigned long long)c->msgs,
+        (unsigned long long)c->syscalls, (unsigned long long)c->eagain,
+        (unsigned long long)c->partial, (unsigned long long)c->errors,
+        (unsigned long long)(h->count > 0 ? h->sum_ns / h->count : 0),
+        (unsigned long long)get_socket_histogram_percentile(h, 50),
+        (unsigned long long)get_socket_histogram_percentile(h, 99),
+        (unsigned long long)get_socket_histogram_percentile(h, 99.9),
+        (unsigned long long)h->max_ns);
+}
+
+/**
+ * @brief 将快照格式化为一行JSON，以换行结尾
+ * @param  snapshot         统计快照
+ * @param  buf              输出缓存
+ * @param  len              输出缓存的长度
+ * @return int 如果格式化成功，返回写入的字节数;如果缓存不足，返回-1
+ */
+int format_socket_metrics(const SocketMetricsSnapshot *snapshot, char *buf,
+                          const size_t len) {
+    size_t pos = 0;
+    int ret = 0;
+
+    ret = snprintf(buf, len, "{\"socket_fd\":%d,", snapshot->socket_fd);
+    if (ret < 0 || (size_t)ret >= len) return -1;
+    pos += ret;
+
+    ret = format_direction("send", &snapshot->counters[SOCKET_METRICS_SEND],
+                           &snapshot->latency[SOCKET_METRICS_SEND], buf + pos,
+                           len - pos);
+    if (ret < 0 || (size_t)ret >= len - pos) return -1;
+    pos += ret;
+
+    ret = snprintf(buf + pos, len - pos, ",");
+    if (ret < 0 || (size_t)ret >= len - pos) return -1;
+    pos += ret;
+
+    ret = format_direction("recv", &snapshot->counters[SOCKET_METRICS_RECV],
+                           &snapshot->latency[SOCKET_METRICS_RECV], buf + pos,
+                           len - pos);
+    if (ret < 0 || (size_t)ret >= len - pos) return -1;
+    pos += ret;
+
+    ret = snprintf(buf + pos, len - pos, "}\n");
+    if (ret < 0 || (size_t)ret >= len - pos) return -1;
+
+    return pos + ret;
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 将缓存中的数据全部写出，对端关闭时不产生SIGPIPE
+ * @return int 如果写出成功，返回1;如果写出失败，返回-1
+ */
+static int write_all(const int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t ret = send(fd, buf, len, MSG_NOSIGNAL);
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret <= 0) return -1;
+        buf += ret;
+        len -= ret;
+    }
+    return 1;
+}
+
+/**
+ * @brief 向连接写出全局统计与每个套接字的统计，每行一个JSON对象
+ * @param  conn_fd          查询端点上接受的连接
+ */
+static void dump_socket_metrics(const int conn_fd) {
+    static SocketMetricsSnapshot snapshot;
+    char line[SOCKET_METRICS_LINE_SIZE];
+    int len = 0;
+
+    get_global_socket_metrics(&snapshot);
+    len = format_socket_metrics(&snapshot, line, sizeof(line));
+    if (len < 0 || write_all(conn_fd, line, len) < 0) return;
+
+    for (int fd = 0; fd < SOCKET_METRICS_MAX_FD; ++fd) {
+        if (fd == conn_fd || fd == server_fd) continue;
+        if (get_socket_metrics(fd, &snapshot) < 0) continue;
+        if (snapshot.counters[SOCKET_METRICS_SEND].syscalls +
+                snapshot.counters[SOCKET_METRICS_RECV].syscalls ==
+            0) {
+            continue;
+        }
+        len = format_socket_metrics(&snapshot, line, sizeof(line));
+        if (len < 0 || write_all(conn_fd, line, len) < 0) return;
+    }
+}
+
+/**
+ * @brief 查询端点的线程入口，每个连接写出一次统计后关闭
+ */
+static void run_metrics_server() {
+    struct pollfd pfd;
+    pfd.fd = server_fd;
+    pfd.events = POLLIN;
+
+    while (server_running.load(std::memory_order_acquire)) {
+        if (poll(&pfd, 1, SOCKET_METRICS_POLL_MS) <= 0) continue;
+
+        int conn_fd = accept(server_fd, NULL, NULL);
+        if (conn_fd < 0) continue;
+        dump_socket_metrics(conn_fd);
+        close(conn_fd);
+    }
+}
+
+// 进程退出时停止查询端点，避免析构仍可join的server_thread
+static struct SocketMetricsServerCloser {
+    ~SocketMetricsServerCloser() { stop_socket_metrics_server(); }
+} socket_metrics_server_closer;
+
+/**
+ * @brief 在本地域套接字上启动查询端点，连接后即可读到当前的全部统计，
+ * 例如 socat - UNIX-CONNECT:<socket_addr>
+ * @param  socket_addr      域套接字地址，以'@'开头时使用抽象命名空间
+ * @return int 如果启动成功，返回1;如果已在运行或启动失败，返回-1
+ */
+int start_socket_metrics_server(const char *const socket_addr) {
+    struct sockaddr_un addr;
+    socklen_t addr_len =
+        SocketAddressTraits<AF_UNIX>::fill(&addr, socket_addr, 0);
+
+    if (addr_len == 0) return -1;
+    if (server_running.exchange(true)) return -1;
+
+    server_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (server_fd < 0) {
+        SOCKET_LOG_ERROR("Metrics socket create...failed!");
+        server_running.store(false);
+        return -1;
+    }
+
+    SocketAddressTraits<AF_UNIX>::release(socket_addr);
+
+    if (bind(server_fd, (struct sockaddr *)&addr, addr_len) < 0 ||
+        listen(server_fd, 4) < 0) {
+        SOCKET_LOG_ERROR("Metrics socket %s bind...failed!", socket_addr);
+        close(server_fd);
+        server_fd = -1;
+        server_running.store(false);
+        return -1;
+    }
+
+    strcpy(server_addr, socket_addr);
+    server_thread = std::thread(run_metrics_server);
+    SOCKET_LOG_INFO("Metrics server listening on %s", socket_addr);
+
+    return 1;
+}
+
+/**
+ * @brief 停止查询端点并删除域套接字文件，抽象地址随套接字关闭而释放
+ * @return int 如果停止成功，返回1;如果未在运行，返回-1
+ */
+int stop_socket_metrics_server() {
+    if (!server_running.exchange(false)) return -1;
+
+    if (server_thread.joinable()) server_thread.join();
+    close(server_fd);
+    server_fd = -1;
+    SocketAddressTraits<AF_UNIX>::release(server_addr);
+
+    return 1;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file socket_metrics.hpp
+ * @brief 声名了套接字收发的运行期统计，包括计数器、时延直方图、快照接口与本地查询端点
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_METRICS_HPP_
+#define SOCKET_METRICS_HPP_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifndef SOCKET_METRICS_ENABLE
+#define SOCKET_METRICS_ENABLE 1
+#endif
+
+#define SOCKET_METRICS_SEND 0
+#define SOCKET_METRICS_RECV 1
+
+#define SOCKET_METRICS_MAX_FD 65536  // 大于该值的socket_fd只计入全局统计
+#define SOCKET_METRICS_THREAD_SLOT_NUM 16  // 全局统计按线程分散的槽数
+
+// 直方图按2的幂分段，每段再等分为2^SOCKET_HISTOGRAM_SUB_BITS个桶，相对误差不超过1/8
+#define SOCKET_HISTOGRAM_SUB_BITS 3
+#define SOCKET_HISTOGRAM_MAX_BITS 40  // 超过2^40纳秒(约18分钟)的时延计入最后一个桶
+#define SOCKET_HISTOGRAM_BUCKET_NUM                               \
+    ((SOCKET_HISTOGRAM_MAX_BITS - SOCKET_HISTOGRAM_SUB_BITS + 1) \
+     << SOCKET_HISTOGRAM_SUB_BITS)
+
+// 某一方向上的计数器
+typedef struct SocketCounters {
+    uint64_t bytes;     // 成功收发的字节数
+    uint64_t msgs;      // 成功收发的消息数，一帧或一个报文计为一条
+    uint64_t syscalls;  // 发起的系统调用次数
+    uint64_t eagain;    // 返回EAGAIN/EWOULDBLOCK的次数
+    uint64_t partial;   // 发送时只写出部分数据的次数
+    uint64_t errors;    // 其余失败的次数
+} SocketCounters;
+
+// 时延直方图，单位为纳秒，每次收发调用记录一个样本
+typedef struct SocketHistogram {
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t max_ns;
+    uint64_t buckets[SOCKET_HISTOGRAM_BUCKET_NUM];
+} SocketHistogram;
+
+// 一个套接字或全局的统计快照，socket_fd为-1时表示全局
+typedef struct SocketMetricsSnapshot {
+    int socket_fd;
+    SocketCounters counters[2];  // 以SOCKET_METRICS_SEND/RECV为下标
+    SocketHistogram latency[2];
+} SocketMetricsSnapshot;
+
+#if SOCKET_METRICS_ENABLE
+uint64_t start_socket_metrics_clock();
+void record_socket_syscall(const int socket_fd, const int dir,
+                           const ssize_t ret, const size_t len);
+void record_socket_msg(const int socket_fd, const int dir, const int msg_num,
+                       const uint64_t start_ns);
+void record_socket_io(const int socket_fd, const int dir, const ssize_t ret,
+                      const size_t len, const uint64_t start_ns);
+#else
+// 关闭统计时埋点为空函数，由编译器完全消除
+inline uint64_t start_socket_metrics_clock() { return 0; }
+inline void record_socket_syscall(const int, const int, const ssize_t,
+                                  const size_t) {}
+inline void record_socket_msg(const int, const int, const int,
+                              const uint64_t) {}
+inline void record_socket_io(const int, const int, const ssize_t,
+                             const size_t, const uint64_t) {}
+#endif
+
+int set_socket_metrics_enabled(const bool enabled);
+int reset_socket_metrics(const int socket_fd);
+int get_socket_metrics(const int socket_fd, SocketMetricsSnapshot* snapshot);
+int get_global_socket_metrics(SocketMetricsSnapshot* snapshot);
+int get_all_socket_metrics(SocketMetricsSnapshot* snapshots, const int num);
+uint64_t get_socket_histogram_percentile(const SocketHistogram* histogram,
+                                         const double percentile);
+int format_socket_metrics(const SocketMetricsSnapshot* snapshot, char* buf,
+                          const size_t len);
+
+int start_socket_metrics_server(const char* const socket_addr);
+int stop_socket_metrics_server();
+
+#endif  // SOCKET_METRICS_HPP_
@@ -0,0 +1,159 @@
+/**
+ * @file socket_registry.cpp
+ * @brief
+ * 实现了套接字登记表。登记表按socket_fd分为若干片，每片由独立的互斥锁保护，
+ * 登记与关闭单个套接字的开销与套接字总数无关。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_registry.hpp"
+
+#include <unistd.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../socket_metrics/socket_metrics.hpp"
+
+// 每片独占缓存行，避免相邻分片的锁互相干扰
+typedef struct alignas(64) SocketRegistryShard {
+    std::mutex lock;
+    std::unordered_map<int, SocketKind> socket_list;
+} SocketRegistryShard;
+
+static SocketRegistryShard socket_registry[SOCKET_REGISTRY_SHARD_NUM];
+
+/**
+ * @brief 查找socket_fd所在的分片
+ * @param  socket_fd        套接字的socket_fd
+ * @return SocketRegistryShard& 所在分片
+ */
+static SocketRegistryShard &find_shard(const int socket_fd) {
+    return socket_registry[(unsigned)socket_fd % SOCKET_REGISTRY_SHARD_NUM];
+}
+
+/**
+ * @brief 登记一个套接字
+ * @param  socket_fd        套接字的socket_fd
+ * @param  kind             套接字的类别
+ * @return int 如果登记成功，返回1;如果socket_fd无效或已被登记，返回-1
+ */
+int register_socket(const int socket_fd, const SocketKind kind) {
+    if (socket_fd < 0) return -1;
+
+    SocketRegistryShard &shard = find_shard(socket_fd);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    if (!shard.socket_list.insert(std::make_pair(socket_fd, kind)).second) {
+        return -1;
+    }
+    // 新套接字可能复用了已关闭套接字的socket_fd，统计从零开始
+    reset_socket_metrics(socket_fd);
+    return 1;
+}
+
+/**
+ * @brief 注销并关闭一个套接字，先注销后关闭，避免内核复用该socket_fd后被误注销
+ * @param  socket_fd        套接字的socket_fd
+ * @param  kind             套接字的类别，需要与登记时一致
+ * @return int 如果关闭成功，返回1;如果该套接字未以kind登记或关闭失败，返回-1
+ */
+int close_registered_socket(const int socket_fd, const SocketKind kind) {
+    if (socket_fd < 0) return -1;
+
+    SocketRegistryShard &shard = find_shard(socket_fd);
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        std::unordered_map<int, SocketKind>::iterator it =
+            shard.socket_list.find(socket_fd);
+        if (it == shard.socket_list.end() || it->second != kind) return -1;
+        shard.socket_list.erase(it);
+    }
+
+    reset_socket_metrics(socket_fd);
+    return close(socket_fd) == 0 ? 1 : -1;
+}
+
+/**
+ * @brief 注销并关闭某一类别的所有套接字
+ * @param  kind             套接字的类别
+ * @return int 如果全部关闭成功，返回1;如果有套接字关闭失败，返回-1
+ */
+int close_all_registered_socket(const SocketKind kind) {
+    std::vector<int> fds;
+    int ret = 1;
+
+    for (int i = 0; i < SOCKET_REGISTRY_SHARD_NUM; ++i) {
+        SocketRegistryShard &shard = socket_registry[i];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        std::unordered_map<int, SocketKind>::iterator it =
+            shard.socket_list.begin();
+        while (it != shard.socket_list.end()) {
+            if (it->second != kind) {
+                ++it;
+                continue;
+            }
+            fds.push_back(it->first);
+            it = shard.socket_list.erase(it);
+        }
+    }
+
+    for (size_t i = 0; i < fds.size(); ++i) {
+        reset_socket_metrics(fds[i]);
+        if (close(fds[i]) < 0) ret = -1;
+    }
+
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////
+
+SocketHandle::SocketHandle() : socket_fd_(-1), kind_(TCP_IP_SERVER_SOCKET) {}
+
+/**
+ * @brief 接管一个由init_*函数创建并已登记的套接字
+ * @param  socket_fd        套接字的socket_fd;小于0时得到一个空句柄
+ * @param  kind             套接字的类别
+ */
+SocketHandle::SocketHandle(const int socket_fd, const SocketKind kind)
+    : socket_fd_(socket_fd < 0 ? -1 : socket_fd), kind_(kind) {}
+
+SocketHandle::SocketHandle(SocketHandle &&other)
+    : socket_fd_(other.socket_fd_), kind_(other.kind_) {
+    other.socket_fd_ = -1;
+}
+
+SocketHandle &SocketHandle::operator=(SocketHandle &&other) {
+    if (this != &other) {
+        reset();
+        socket_fd_ = other.socket_fd_;
+        kind_ = other.kind_;
+        other.socket_fd_ = -1;
+    }
+    return *this;
+}
+
+SocketHandle::~SocketHandle() { reset(); }
+
+/**
+ * @brief 放弃对套接字的所有权，套接字保持登记且不被关闭
+ * @return int 原先持有的socket_fd;如果是空句柄，返回-1
+ */
+int SocketHandle::release() {
+    int socket_fd = socket_fd_;
+    socket_fd_ = -1;
+    return socket_fd;
+}
+
+/**
+ * @brief 注销并关闭持有的套接字，之后句柄为空
+ * @return int 如果关闭成功，返回1;如果是空句柄或关闭失败，返回-1
+ */
+int SocketHandle::reset() {
+    int socket_fd = release();
+    if (socket_fd < 0) return -1;
+    return close_registered_socket(socket_fd, kind_);
+}
@@ -0,0 +1,56 @@
+/**
+ * @file socket_registry.hpp
+ * @brief 声名了线程安全的套接字登记表，以及自动关闭套接字的SocketHandle
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_REGISTRY_HPP_
+#define SOCKET_REGISTRY_HPP_
+
+#define SOCKET_REGISTRY_SHARD_NUM 64  // 按socket_fd分片，降低锁竞争
+
+typedef enum SocketKind {
+    TCP_IP_SERVER_SOCKET = 0,
+    UDP_IP_SERVER_SOCKET,
+    TCP_IP_CLIENT_SOCKET,
+    UDP_IP_CLIENT_SOCKET,
+    TCP_DOMAIN_SERVER_SOCKET,
+    UDP_DOMAIN_SERVER_SOCKET,
+    TCP_DOMAIN_CLIENT_SOCKET,
+    UDP_DOMAIN_CLIENT_SOCKET,
+    SEQPACKET_DOMAIN_SERVER_SOCKET,
+    SEQPACKET_DOMAIN_CLIENT_SOCKET,
+} SocketKind;
+
+int register_socket(const int socket_fd, const SocketKind kind);
+int close_registered_socket(const int socket_fd, const SocketKind kind);
+int close_all_registered_socket(const SocketKind kind);
+
+/**
+ * @brief 独占一个已登记的套接字，析构时注销并关闭该套接字，只能移动不能复制
+ */
+class SocketHandle {
+   public:
+    SocketHandle();
+    SocketHandle(const int socket_fd, const SocketKind kind);
+    SocketHandle(SocketHandle &&other);
+    SocketHandle &operator=(SocketHandle &&other);
+    SocketHandle(const SocketHandle &) = delete;
+    SocketHandle &operator=(const SocketHandle &) = delete;
+    ~SocketHandle();
+
+    int get() const { return socket_fd_; }
+    SocketKind kind() const { return kind_; }
+    explicit operator bool() const { return socket_fd_ >= 0; }
+
+    int release();
+    int reset();
+
+   private:
+    int socket_fd_;
+    SocketKind kind_;
+};
+
+#endif  // SOCKET_REGISTRY_HPP_
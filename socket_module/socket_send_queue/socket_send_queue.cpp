@@ -0,0 +1,280 @@
+/**
+ * @file socket_send_queue.cpp
+ * @brief
+ * 实现了每个连接的有界发送队列。消息先尝试直接写出，写不完时拷贝到队列中，
+ * 套接字可写时通过一次sendmsg写出多条排队的消息。排队的字节数或消息数达到高水位时进入背压，
+ * 降到低水位以下时解除，两次状态改变都通过回调通知生产者，高低水位之间的间隔避免频繁切换。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "socket_send_queue.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+#include "../socket_transport/socket_transport.hpp"
+
+/**
+ * @brief 获取单调时钟的当前时间
+ * @return int64_t 毫秒数
+ */
+static int64_t now_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * @brief 改变背压状态，状态确实改变时才调用回调
+ * @param  queue            发送队列
+ * @param  blocked          新的背压状态
+ */
+static void set_blocked(SocketSendQueue *queue, const bool blocked) {
+    if (queue->blocked == blocked) return;
+    queue->blocked = blocked;
+    if (queue->config.on_backpressure != NULL) {
+        queue->config.on_backpressure(queue->socket_fd, blocked,
+                                      queue->config.user_data);
+    }
+}
+
+/**
+ * @brief 按当前排队的字节数与消息数更新背压状态
+ * @param  queue            发送队列
+ */
+static void update_blocked(SocketSendQueue *queue) {
+    const SocketSendQueueConfig &config = queue->config;
+
+    if (queue->bytes >= config.high_bytes ||
+        queue->msgs.size() >= config.high_msgs) {
+        set_blocked(queue, true);
+    } else if (queue->bytes <= config.low_bytes &&
+               queue->msgs.size() <= config.low_msgs) {
+        set_blocked(queue, false);
+    }
+}
+
+/**
+ * @brief 再放入len字节的一条消息后队列是否仍在高水位以内
+ * @param  queue            发送队列
+ * @param  len              消息长度
+ * @return bool 如果放得下，返回true
+ */
+static bool fits(const SocketSendQueue *queue, const size_t len) {
+    return queue->bytes + len <= queue->config.high_bytes &&
+           queue->msgs.size() + 1 <= queue->config.high_msgs;
+}
+
+/**
+ * @brief 丢弃最早的消息直到放得下len字节;已部分写出的队首消息必须写完，不能丢弃
+ * @param  queue            发送队列
+ * @param  len              新消息的长度
+ */
+static void drop_oldest(SocketSendQueue *queue, const size_t len) {
+    size_t keep = queue->offset > 0 ? 1 : 0;
+
+    while (queue->msgs.size() > keep && !fits(queue, len)) {
+        std::deque<std::vector<char> >::iterator it =
+            queue->msgs.begin() + keep;
+        queue->bytes -= it->size();
+        queue->msgs.erase(it);
+        queue->dropped_num++;
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 获取默认配置:4MB/1MB与65536/16384条的高低水位，达到高水位时拒绝新消息
+ * @param  config           需要填充的配置
+ */
+void get_default_socket_send_queue_config(SocketSendQueueConfig *config) {
+    config->high_bytes = DEFAULT_SEND_QUEUE_HIGH_BYTES;
+    config->low_bytes = DEFAULT_SEND_QUEUE_LOW_BYTES;
+    config->high_msgs = DEFAULT_SEND_QUEUE_HIGH_MSGS;
+    config->low_msgs = DEFAULT_SEND_QUEUE_LOW_MSGS;
+    config->mode = SEND_QUEUE_REJECT;
+    config->on_backpressure = NULL;
+    config->user_data = NULL;
+}
+
+/**
+ * @brief 初始化一个发送队列
+ * @param  queue            需要初始化的队列
+ * @param  socket_fd        已连接的流式套接字，队列不负责关闭
+ * @param  config           队列配置，为NULL时使用默认配置
+ * @return int 如果初始化成功，返回1;如果低水位高于高水位，返回-1并置errno为EINVAL
+ */
+int init_socket_send_queue(SocketSendQueue *queue, const int socket_fd,
+                           const SocketSendQueueConfig *config) {
+    if (config == NULL) {
+        get_default_socket_send_queue_config(&queue->config);
+    } else {
+        queue->config = *config;
+    }
+
+    if (socket_fd < 0 || queue->config.high_bytes == 0 ||
+        queue->config.high_msgs == 0 ||
+        queue->config.low_bytes > queue->config.high_bytes ||
+        queue->config.low_msgs > queue->config.high_msgs) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    queue->socket_fd = socket_fd;
+    queue->msgs.clear();
+    queue->offset = 0;
+    queue->bytes = 0;
+    queue->blocked = false;
+    queue->dropped_num = 0;
+    queue->rejected_num = 0;
+
+    return 1;
+}
+
+/**
+ * @brief 发送一条消息;队列为空时直接写出，写不完或队列非空时按顺序排队。
+ * 队列为空时写不完的剩余部分总是入队，不检查high_bytes:消息已有一部分在连接上，拒绝会破坏数据流，
+ * 因此一条超过high_bytes的消息可以使排队字节数超出上限，此时队列立即进入背压
+ * @param  queue            发送队列
+ * @param  msg              需要发送的消息，返回后即可重用
+ * @return int
+ * 如果已写出或已排队，返回1;如果处于背压且不丢弃旧消息，返回-1并置errno为EAGAIN;如果连接出错，返回-1
+ */
+int push_socket_send_queue(SocketSendQueue *queue, const SocketMessage *msg) {
+    size_t sent = 0;
+
+    if (msg->len == 0) return 1;
+
+    if (queue->msgs.empty()) {
+        uint64_t start_ns = start_socket_metrics_clock();
+        ssize_t ret = 0;
+        do {
+            ret = send(queue->socket_fd, msg->buf, msg->len,
+                       MSG_DONTWAIT | MSG_NOSIGNAL);
+        } while (ret < 0 && errno == EINTR);
+        record_socket_io(queue->socket_fd, SOCKET_METRICS_SEND, ret, msg->len,
+                         start_ns);
+        if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return -1;
+        if (ret == (ssize_t)msg->len) return 1;
+        sent = ret > 0 ? ret : 0;
+    } else if (queue->config.mode == SEND_QUEUE_DROP_OLDEST) {
+        drop_oldest(queue, msg->len);
+    } else if (queue->blocked || !fits(queue, msg->len)) {
+        queue->rejected_num++;
+        set_blocked(queue, true);
+        errno = EAGAIN;
+        return -1;
+    }
+
+    // 部分写出的消息整条入队，offset记录已写出的位置;剩余部分不受high_bytes限制
+    queue->msgs.push_back(std::vector<char>(msg->buf, msg->buf + msg->len));
+    if (queue->msgs.size() == 1) queue->offset = sent;
+    queue->bytes += msg->len - sent;
+    update_blocked(queue);
+
+    return 1;
+}
+
+/**
+ * @brief 在不阻塞的前提下尽可能多地写出排队的消息，套接字可写时调用
+ * @param  queue            发送队列
+ * @return int
+ * 如果队列已写空，返回1;如果发送缓存已满仍有消息排队，返回0;如果连接出错，返回-1
+ */
+int flush_socket_send_queue(SocketSendQueue *queue) {
+    struct iovec iovs[MAX_SOCKET_IOV_NUM];
+    struct msghdr hdr;
+    int ret = 1;
+
+    while (!queue->msgs.empty()) {
+        size_t num = queue->msgs.size() < MAX_SOCKET_IOV_NUM
+                         ? queue->msgs.size()
+                         : MAX_SOCKET_IOV_NUM;
+        size_t len = 0;
+        for (size_t i = 0; i < num; ++i) {
+            std::vector<char> &data = queue->msgs[i];
+            size_t skip = i == 0 ? queue->offset : 0;
+            iovs[i].iov_base = data.data() + skip;
+            iovs[i].iov_len = data.size() - skip;
+            len += iovs[i].iov_len;
+        }
+        bzero(&hdr, sizeof(hdr));
+        hdr.msg_iov = iovs;
+        hdr.msg_iovlen = num;
+
+        ssize_t sent =
+            sendmsg(queue->socket_fd, &hdr, MSG_DONTWAIT | MSG_NOSIGNAL);
+        record_socket_syscall(queue->socket_fd, SOCKET_METRICS_SEND, sent,
+                              len);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            ret = errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+            break;
+        }
+
+        // 弹出已经完整写出的消息，记录队首消息写出的位置
+        queue->bytes -= sent;
+        while (sent > 0) {
+            size_t remain = queue->msgs.front().size() - queue->offset;
+            if ((size_t)sent < remain) {
+                queue->offset += sent;
+                break;
+            }
+            sent -= remain;
+            queue->offset = 0;
+            queue->msgs.pop_front();
+        }
+    }
+
+    // 回调中可以继续放入消息，因此在队列状态更新完之后调用
+    update_blocked(queue);
+
+    return ret < 0 ? -1 : (queue->msgs.empty() ? 1 : ret);
+}
+
+/**
+ * @brief 等待套接字可写并写出全部排队的消息，用于关闭连接之前
+ * @param  queue            发送队列
+ * @param  timeout_ms       整个调用的超时时间，SOCKET_WAIT_FOREVER表示一直等待
+ * @return int 如果队列已写空，返回1;如果超时，返回-1并置errno为ETIMEDOUT;如果连接出错，返回-1
+ */
+int drain_socket_send_queue(SocketSendQueue *queue, const int timeout_ms) {
+    int64_t deadline = timeout_ms < 0 ? -1 : now_ms() + timeout_ms;
+
+    while (1) {
+        int ret = flush_socket_send_queue(queue);
+        if (ret != 0) return ret;
+
+        int wait_ms = SOCKET_WAIT_FOREVER;
+        if (deadline >= 0) {
+            int64_t remain = deadline - now_ms();
+            wait_ms = remain > 0 ? (int)remain : 0;
+        }
+        if (wait_socket_ready(queue->socket_fd, POLLOUT, wait_ms) < 0) {
+            return -1;
+        }
+    }
+}
+
+/**
+ * @brief 丢弃排队的消息并释放队列，不关闭套接字;需要发出剩余消息时先调用drain_socket_send_queue
+ * @param  queue            发送队列
+ * @return int 返回1
+ */
+int close_socket_send_queue(SocketSendQueue *queue) {
+    queue->dropped_num += queue->msgs.size();
+    std::deque<std::vector<char> >().swap(queue->msgs);
+    queue->offset = 0;
+    queue->bytes = 0;
+    queue->blocked = false;
+
+    return 1;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file socket_send_queue.hpp
+ * @brief 声名了每个连接的有界发送队列，按字节数与消息数的高低水位向生产者报告背压
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_SEND_QUEUE_HPP_
+#define SOCKET_SEND_QUEUE_HPP_
+
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "../socket_message.hpp"
+
+#define DEFAULT_SEND_QUEUE_HIGH_BYTES (4 * 1024 * 1024)
+#define DEFAULT_SEND_QUEUE_LOW_BYTES (1024 * 1024)
+#define DEFAULT_SEND_QUEUE_HIGH_MSGS 65536
+#define DEFAULT_SEND_QUEUE_LOW_MSGS 16384
+
+// 队列达到高水位后新消息的处理方式
+#define SEND_QUEUE_REJECT 0       // 拒绝新消息，直到队列降到低水位以下
+#define SEND_QUEUE_DROP_OLDEST 1  // 丢弃最早的消息，适合只关心最新值的遥测数据
+
+/**
+ * @brief 背压状态改变时的回调，在调用push或flush的线程中执行
+ * @param  socket_fd        队列所属的连接
+ * @param  blocked          达到高水位时为true，降到低水位以下时为false
+ * @param  user_data        配置中的用户指针
+ */
+typedef void (*SocketBackpressureCallback)(const int socket_fd,
+                                           const bool blocked,
+                                           void *user_data);
+
+typedef struct SocketSendQueueConfig {
+    size_t high_bytes;  // 排队字节数达到该值时进入背压，可能被一条部分写出的消息超出
+    size_t low_bytes;   // 排队字节数不超过该值时解除背压
+    size_t high_msgs;
+    size_t low_msgs;
+    int mode;  // SEND_QUEUE_REJECT或SEND_QUEUE_DROP_OLDEST
+    SocketBackpressureCallback on_backpressure;  // 可以为NULL
+    void *user_data;
+} SocketSendQueueConfig;
+
+/**
+ * 一个连接的发送队列，不是线程安全的。队列为空时消息直接写出，写不完的部分才进入队列，
+ * 套接字可写时调用flush_socket_send_queue继续写出。排队的字节数最多为high_bytes加一条消息。
+ * 所有写出都不阻塞，套接字本身可以是阻塞模式。
+ */
+typedef struct SocketSendQueue {
+    int socket_fd;
+    SocketSendQueueConfig config;
+    std::deque<std::vector<char> > msgs;
+    size_t offset;  // 队首消息已写出的字节数
+    size_t bytes;   // 队列中尚未写出的字节数
+    bool blocked;
+    uint64_t dropped_num;
+    uint64_t rejected_num;
+} SocketSendQueue;
+
+void get_default_socket_send_queue_config(SocketSendQueueConfig *config);
+int init_socket_send_queue(SocketSendQueue *queue, const int socket_fd,
+                           const SocketSendQueueConfig *config = NULL);
+int push_socket_send_queue(SocketSendQueue *queue, const SocketMessage *msg);
+int flush_socket_send_queue(SocketSendQueue *queue);
+int drain_socket_send_queue(SocketSendQueue *queue, const int timeout_ms);
+int close_socket_send_queue(SocketSendQueue *queue);
+
+#endif  // SOCKET_SEND_QUEUE_HPP_
@@ -0,0 +1,89 @@
+/**
+ * @file socket_address.hpp
+ * @brief
+ * 声名了按地址族特化的地址填充，域套接字地址以'@'开头时使用Linux抽象命名空间。
+ * 不依赖其他模块，传输模板之外需要填充地址的模块(如连接池、统计查询端点)也直接包含本头文件。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_ADDRESS_HPP_
+#define SOCKET_ADDRESS_HPP_
+
+#include <arpa/inet.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+
+/**
+ * @brief 地址族的地址格式，由特化提供
+ * @tparam Family AF_INET或AF_UNIX
+ */
+template <int Family>
+struct SocketAddressTraits;
+
+template <>
+struct SocketAddressTraits<AF_INET> {
+    typedef struct sockaddr_in Address;
+
+    /**
+     * @brief 填充ip地址
+     * @param  addr             需要填充的地址
+     * @param  host             ip地址，为NULL时表示INADDR_ANY
+     * @param  port             端口
+     * @return socklen_t 地址长度
+     */
+    static socklen_t fill(Address *addr, const char *const host,
+                          const uint port) {
+        bzero(addr, sizeof(Address));
+        addr->sin_family = AF_INET;
+        addr->sin_port = htons(port);
+        addr->sin_addr.s_addr = host == NULL ? INADDR_ANY : inet_addr(host);
+        return sizeof(Address);
+    }
+
+    static void release(const char *const) {}
+};
+
+template <>
+struct SocketAddressTraits<AF_UNIX> {
+    typedef struct sockaddr_un Address;
+
+    /**
+     * @brief 填充域套接字地址，以'@'开头的地址使用Linux抽象命名空间
+     * @param  addr             需要填充的地址
+     * @param  path             域套接字地址
+     * @param  port             不使用
+     * @return socklen_t 如果填充成功，返回地址的实际长度;如果地址为空或过长，返回0
+     */
+    static socklen_t fill(Address *addr, const char *const path, const uint) {
+        size_t len = strlen(path);
+
+        bzero(addr, sizeof(Address));
+        addr->sun_family = AF_UNIX;
+        if (len == 0 || len >= sizeof(addr->sun_path)) return 0;
+
+        memcpy(addr->sun_path, path, len);
+        if (path[0] == '@') {
+            // 抽象地址以'\0'开头，名字不以'\0'结尾，长度必须精确到名字末尾
+            addr->sun_path[0] = '\0';
+            return offsetof(Address, sun_path) + len;
+        }
+        return offsetof(Address, sun_path) + len + 1;
+    }
+
+    /**
+     * @brief 绑定前移除文件系统路径上已有的套接字文件，抽象地址随最后一个套接字关闭而释放
+     * @param  path             域套接字地址
+     */
+    static void release(const char *const path) {
+        if (path[0] != '@') remove(path);
+    }
+};
+
+#endif  // SOCKET_ADDRESS_HPP_
@@ -0,0 +1,587 @@
+/**
+ * @file socket_transport.hpp
+ * @brief
+ * 声名了按地址族与套接字类型在编译期特化的传输模板。ip套接字与域套接字的建立、收发与关闭只实现一次，
+ * 没有虚函数，包含本头文件的调用方可以将收发路径内联。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_TRANSPORT_HPP_
+#define SOCKET_TRANSPORT_HPP_
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../socket_deadline/socket_deadline.hpp"
+#include "../socket_frame/socket_frame.hpp"
+#include "../socket_log/socket_log.hpp"
+#include "../socket_message.hpp"
+#include "../socket_metrics/socket_metrics.hpp"
+#include "../socket_registry/socket_registry.hpp"
+#include "socket_address.hpp"
+
+#define MAX_LISTEN_NUM 10
+#define MAX_UDP_BATCH_NUM 64   // 单次recvmmsg/sendmmsg处理的最大报文数
+#define MAX_SOCKET_IOV_NUM 64  // 分散/聚集收发时的最大数据段数
+
+/**
+ * @brief 一种传输登记到套接字登记表时使用的类型，由特化提供，未特化的组合无法实例化
+ * @tparam Family AF_INET或AF_UNIX
+ * @tparam Type SOCK_STREAM、SOCK_DGRAM或SOCK_SEQPACKET
+ */
+template <int Family, int Type>
+struct SocketKindTraits;
+
+#define DEFINE_SOCKET_KIND_TRAITS(FAMILY, TYPE, SERVER, CLIENT) \
+    template <>                                                 \
+    struct SocketKindTraits<FAMILY, TYPE> {                     \
+        static SocketKind server() { return SERVER; }           \
+        static SocketKind client() { return CLIENT; }           \
+    }
+
+DEFINE_SOCKET_KIND_TRAITS(AF_INET, SOCK_STREAM, TCP_IP_SERVER_SOCKET,
+                          TCP_IP_CLIENT_SOCKET);
+DEFINE_SOCKET_KIND_TRAITS(AF_INET, SOCK_DGRAM, UDP_IP_SERVER_SOCKET,
+                          UDP_IP_CLIENT_SOCKET);
+DEFINE_SOCKET_KIND_TRAITS(AF_UNIX, SOCK_STREAM, TCP_DOMAIN_SERVER_SOCKET,
+                          TCP_DOMAIN_CLIENT_SOCKET);
+DEFINE_SOCKET_KIND_TRAITS(AF_UNIX, SOCK_DGRAM, UDP_DOMAIN_SERVER_SOCKET,
+                          UDP_DOMAIN_CLIENT_SOCKET);
+DEFINE_SOCKET_KIND_TRAITS(AF_UNIX, SOCK_SEQPACKET,
+                          SEQPACKET_DOMAIN_SERVER_SOCKET,
+                          SEQPACKET_DOMAIN_CLIENT_SOCKET);
+
+#undef DEFINE_SOCKET_KIND_TRAITS
+
+///////////////////////////////////////////////////////////////////
+
+namespace transport_detail {
+
+/**
+ * @brief 只在接收数据的末尾补'\0'，代替接收前对整块缓存清零，开销与数据长度而非缓存容量相关
+ * @param  msg              数据缓存的指针
+ * @param  len              recv的返回值
+ * @return int 原样返回len
+ */
+inline int terminate_msg(const SocketMessage *msg, const int len) {
+    if (len >= 0 && (size_t)len < msg->len) msg->buf[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief 将数据段数组转换为分散/聚集收发使用的iovec数组
+ * @param  hdr              需要填充的msghdr，msg_iov指向iovs
+ * @param  iovs             iovec数组，长度不小于num
+ * @param  msgs             数据段数组
+ * @param  num              数据段的个数
+ * @return ssize_t 如果转换成功，返回所有数据段的总字节数;如果段数为0或超过MAX_SOCKET_IOV_NUM，返回-1
+ */
+inline ssize_t fill_msghdr(struct msghdr *hdr, struct iovec *iovs,
+                           const SocketMessage *msgs, const uint num) {
+    size_t total = 0;
+
+    if (num == 0 || num > MAX_SOCKET_IOV_NUM) return -1;
+
+    bzero(hdr, sizeof(struct msghdr));
+    for (uint i = 0; i < num; ++i) {
+        iovs[i].iov_base = msgs[i].buf;
+        iovs[i].iov_len = msgs[i].len;
+        total += msgs[i].len;
+    }
+    hdr->msg_iov = iovs;
+    hdr->msg_iovlen = num;
+
+    return total;
+}
+
+}  // namespace transport_detail
+
+/**
+ * 按地址族与套接字类型特化的传输，所有成员都是静态内联函数，不保存状态。
+ * 只适用于流式或只适用于报文的函数在实例化时做编译期检查。
+ * @tparam Family AF_INET或AF_UNIX
+ * @tparam Type SOCK_STREAM、SOCK_DGRAM或SOCK_SEQPACKET
+ */
+template <int Family, int Type>
+struct SocketTransport {
+    typedef SocketAddressTraits<Family> AddressTraits;
+    typedef typename AddressTraits::Address Address;
+    typedef SocketKindTraits<Family, Type> KindTraits;
+
+    static const bool is_stream = Type == SOCK_STREAM;
+    static const bool is_connection = Type != SOCK_DGRAM;
+
+    /**
+     * @brief 创建、绑定并监听一个面向连接的套接字，登记为服务端
+     * @param  addr             ip传输为NULL(监听所有地址)，域传输为域套接字地址
+     * @param  port             监听端口，域传输不使用
+     * @param  backlog          全连接队列长度
+     * @param  reuse_port       是否开启SO_REUSEPORT，允许多个套接字监听同一端口
+     * @return int 如果初始化成功，返回服务端的socket_fd;如果初始化失败，返回-1
+     */
+    static int listen_socket(const char *const addr, const uint port,
+                             const int backlog,
+                             const bool reuse_port = false) {
+        static_assert(is_connection, "listen needs a connection socket");
+        int socket_fd = bind_socket(addr, port, reuse_port ? SO_REUSEPORT : 0);
+        if (socket_fd < 0) return -1;
+
+        if (listen(socket_fd, backlog) < 0) {
+            SOCKET_LOG_ERROR("Listen socket...failed!");
+            close(socket_fd);
+            return -1;
+        } else {
+            SOCKET_LOG_DEBUG("Listen socket...success!");
+        }
+
+        register_socket(socket_fd, KindTraits::server());
+
+        return socket_fd;
+    }
+
+    /**
+     * @brief 创建并绑定一个报文套接字，登记为服务端
+     * @param  addr             ip传输为NULL(接收所有地址)或组播地址，域传输为域套接字地址
+     * @param  port             绑定端口，域传输不使用
+     * @param  reuse_addr       是否开启SO_REUSEADDR，允许同一主机上的多个组播接收端绑定同一端口
+     * @return int 如果初始化成功，返回服务端的socket_fd;如果初始化失败，返回-1
+     */
+    static int bind_server(const char *const addr, const uint port,
+                           const bool reuse_addr = false) {
+        static_assert(!is_connection, "use listen_socket for connections");
+        int socket_fd = bind_socket(addr, port, reuse_addr ? SO_REUSEADDR : 0);
+        if (socket_fd < 0) return -1;
+
+        register_socket(socket_fd, KindTraits::server());
+
+        return socket_fd;
+    }
+
+    /**
+     * @brief 创建一个套接字并连接到服务端，登记为客户端;报文套接字连接后只与该地址收发
+     * @param  addr             服务端的ip地址或域套接字地址
+     * @param  port             服务端端口，域传输不使用
+     * @return int 如果初始化成功，返回客户端的socket_fd;如果初始化失败，返回-1
+     */
+    static int connect_socket(const char *const addr, const uint port) {
+        Address server_addr;
+        socklen_t len = AddressTraits::fill(&server_addr, addr, port);
+        int socket_fd = open_socket();
+        if (socket_fd < 0) return -1;
+
+        if (len == 0) errno = EINVAL;
+        if (len == 0 ||
+            connect(socket_fd, (struct sockaddr *)&server_addr, len) < 0) {
+            SOCKET_LOG_ERROR("Connect socket...failed!");
+            close(socket_fd);
+            return -1;
+        } else {
+            SOCKET_LOG_DEBUG("Connect socket...success!");
+        }
+
+        register_socket(socket_fd, KindTraits::client());
+
+        return socket_fd;
+    }
+
+    /**
+     * @brief 发送一段数据;流式套接字可能部分写出，报文与seqpacket套接字整条发出或失败
+     * @param  socket_fd        已连接的套接字
+     * @param  msg              需要发送数据的指针
+     * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
+     */
+    static int send_msg(const int socket_fd, const SocketMessage *msg) {
+        uint64_t start_ns = start_socket_metrics_clock();
+        int ret = send(socket_fd, msg->buf, msg->len, send_flags());
+        record_socket_io(socket_fd, SOCKET_METRICS_SEND, ret, msg->len,
+                         start_ns);
+        return ret;
+    }
+
+    /**
+     * @brief 接收数据，统计计入metrics_fd;报文超过缓存时被截断，seqpacket记录被截断时报错
+     * @param  socket_fd        已连接的套接字或报文服务端
+     * @param  msg              数据缓存的指针
+     * @param  metrics_fd       计入统计的套接字，服务端在accept_fd上接收时为服务端的socket_fd
+     * @return int
+     * 如果接收成功，返回接收的字节数;如果对端关闭，返回0;如果seqpacket记录超过缓存，返回-1并置errno为EMSGSIZE;如果接收失败，返回-1
+     */
+    static int recv_msg(const int socket_fd, const SocketMessage *msg,
+                        const int metrics_fd) {
+        uint64_t start_ns = start_socket_metrics_clock();
+        int ret = 0;
+
+        if (Type == SOCK_SEQPACKET) {
+            struct msghdr hdr;
+            struct iovec iov;
+            transport_detail::fill_msghdr(&hdr, &iov, msg, 1);
+            ret = recvmsg(socket_fd, &hdr, 0);
+            if (ret >= 0 && (hdr.msg_flags & MSG_TRUNC)) {
+                SOCKET_LOG_ERROR("Seqpacket record truncated!");
+                transport_detail::terminate_msg(msg, ret);
+                record_socket_io(metrics_fd, SOCKET_METRICS_RECV, -1,
+                                 msg->len, start_ns);
+                errno = EMSGSIZE;
+                return -1;
+            }
+        } else {
+            ret = recv(socket_fd, msg->buf, msg->len, 0);
+        }
+        record_socket_io(metrics_fd, SOCKET_METRICS_RECV, ret, msg->len,
+                         start_ns);
+
+        return transport_detail::terminate_msg(msg, ret);
+    }
+
+    static int recv_msg(const int socket_fd, const SocketMessage *msg) {
+        return recv_msg(socket_fd, msg, socket_fd);
+    }
+
+    /**
+     * @brief 分散接收;报文与seqpacket套接字一次接收一条，超过各段容量之和时报错
+     * @param  socket_fd        已连接的套接字或报文服务端
+     * @param  msgs             数据段数组
+     * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+     * @return int
+     * 如果接收成功，返回接收的总字节数;如果对端关闭，返回0;如果报文被截断，返回-1并置errno为EMSGSIZE;如果接收失败，返回-1
+     */
+    static int recv_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num) {
+        struct msghdr hdr;
+        struct iovec iovs[MAX_SOCKET_IOV_NUM];
+        ssize_t total = transport_detail::fill_msghdr(&hdr, iovs, msgs, num);
+        if (total < 0) return -1;
+
+        uint64_t start_ns = start_socket_metrics_clock();
+        int ret = recvmsg(socket_fd, &hdr, 0);
+        if (!is_stream && ret >= 0 && (hdr.msg_flags & MSG_TRUNC)) {
+            errno = EMSGSIZE;
+            ret = -1;
+        }
+        record_socket_io(socket_fd, SOCKET_METRICS_RECV, ret, total,
+                         start_ns);
+
+        return ret;
+    }
+
+    /**
+     * @brief 聚集发送;流式套接字处理部分写入直到全部发出，报文与seqpacket套接字所有段作为一条发出
+     * @param  socket_fd        已连接的套接字
+     * @param  msgs             数据段数组，按顺序发出
+     * @param  num              数据段的个数，不超过MAX_SOCKET_IOV_NUM
+     * @return int
+     * 如果发送成功，返回发送的总字节数;如果流式套接字已写出一部分后出错，返回已写出的字节数，errno保留;
+     * 如果一个字节都未发出就失败，返回-1
+     */
+    static int send_msgv(const int socket_fd, const SocketMessage *msgs,
+                         const uint num) {
+        struct msghdr hdr;
+        struct iovec iovs[MAX_SOCKET_IOV_NUM];
+        ssize_t total = transport_detail::fill_msghdr(&hdr, iovs, msgs, num);
+        size_t sent = 0;
+        if (total < 0) return -1;
+
+        uint64_t start_ns = start_socket_metrics_clock();
+        if (!is_stream) {
+            int ret = sendmsg(socket_fd, &hdr, send_flags());
+            record_socket_io(socket_fd, SOCKET_METRICS_SEND, ret, total,
+                             start_ns);
+            return ret;
+        }
+
+        // 对端在发送中途重置连接时返回EPIPE而不是发出SIGPIPE
+        while (sent < (size_t)total) {
+            ssize_t ret = sendmsg(socket_fd, &hdr, MSG_NOSIGNAL);
+            record_socket_syscall(socket_fd, SOCKET_METRICS_SEND, ret,
+                                  total - sent);
+            if (ret < 0) {
+                if (errno == EINTR) continue;
+                return sent > 0 ? (int)sent : -1;
+            }
+            sent += ret;
+
+            // 跳过已经完整写出的段，并调整部分写出的段
+            while (hdr.msg_iovlen > 0 && (size_t)ret >= hdr.msg_iov->iov_len) {
+                ret -= hdr.msg_iov->iov_len;
+                ++hdr.msg_iov;
+                --hdr.msg_iovlen;
+            }
+            if (hdr.msg_iovlen > 0) {
+                hdr.msg_iov->iov_base = (char *)hdr.msg_iov->iov_base + ret;
+                hdr.msg_iov->iov_len -= ret;
+            }
+        }
+        record_socket_msg(socket_fd, SOCKET_METRICS_SEND, 1, start_ns);
+
+        return total;
+    }
+
+    /**
+     * @brief 流式套接字在超时之前发出全部数据
+     * @param  socket_fd        已连接的套接字
+     * @param  msg              需要发送数据的指针
+     * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+     * @return int
+     * 如果全部发出，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+     */
+    static int send_msg_all(const int socket_fd, const SocketMessage *msg,
+                            const int timeout_ms) {
+        static_assert(is_stream, "send_msg_all needs a stream socket");
+        return send_socket_all(socket_fd, msg, timeout_ms);
+    }
+
+    /**
+     * @brief 流式套接字在超时之前恰好接收msg->len字节
+     * @param  socket_fd        已连接的套接字
+     * @param  msg              数据缓存的指针，缓存长度即需要接收的字节数
+     * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+     * @return int
+     * 如果接收完整，返回接收的字节数;如果对端在收到任何数据前关闭，返回0;如果超时或数据不完整，返回-1
+     */
+    static int recv_msg_exact(const int socket_fd, const SocketMessage *msg,
+                              const int timeout_ms) {
+        static_assert(is_stream, "recv_msg_exact needs a stream socket");
+        return recv_socket_exact(socket_fd, msg, timeout_ms);
+    }
+
+    /**
+     * @brief 流式套接字按帧接收数据
+     * @param  socket_fd        已连接的套接字
+     * @param  decoder          该连接的解帧器
+     * @param  frame            解出的帧，负载指向解帧器的缓存
+     * @return int 如果接收成功，返回1;如果对端关闭，返回0;如果接收失败，返回-1
+     */
+    static int recv_frame(const int socket_fd, SocketFrameDecoder *decoder,
+                          SocketFrame *frame) {
+        static_assert(is_stream, "frames need a stream socket");
+        return recv_socket_frame(socket_fd, decoder, frame);
+    }
+
+    /**
+     * @brief 流式套接字按帧发送数据，保证整帧写出
+     * @param  socket_fd        已连接的套接字
+     * @param  type             消息类型
+     * @param  msg              需要发送数据的指针
+     * @return int 如果发送成功，返回发送的总字节数(含帧头);如果发送失败，返回-1
+     */
+    static int send_frame(const int socket_fd, const uint16_t type,
+                          const SocketMessage *msg) {
+        static_assert(is_stream, "frames need a stream socket");
+        return send_socket_frame(socket_fd, type, msg);
+    }
+
+    /**
+     * @brief 报文套接字在超时之前接收一个报文
+     * @param  socket_fd        报文服务端的socket_fd
+     * @param  msg              数据缓存的指针
+     * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+     * @return int 如果接收成功，返回接收的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果接收失败，返回-1
+     */
+    static int recv_msg_timeout(const int socket_fd, const SocketMessage *msg,
+                                const int timeout_ms) {
+        static_assert(!is_stream, "use recv_msg_exact for streams");
+        return transport_detail::terminate_msg(
+            msg, recv_socket_dgram(socket_fd, msg, timeout_ms));
+    }
+
+    /**
+     * @brief 报文套接字在超时之前发出一个报文，发送缓存已满时等待而不是阻塞
+     * @param  socket_fd        已连接的报文套接字
+     * @param  msg              数据缓存的指针
+     * @param  timeout_ms       超时时间，SOCKET_WAIT_FOREVER表示一直等待
+     * @return int 如果发送成功，返回发送的字节数;如果超时，返回-1并置errno为ETIMEDOUT;如果发送失败，返回-1
+     */
+    static int send_msg_timeout(const int socket_fd, const SocketMessage *msg,
+                                const int timeout_ms) {
+        static_assert(!is_stream, "use send_msg_all for streams");
+        return send_socket_dgram(socket_fd, msg, timeout_ms);
+    }
+
+    /**
+     * @brief 报文套接字批量接收数据，一次recvmmsg最多接收MAX_UDP_BATCH_NUM个报文
+     * @param  socket_fd        报文服务端的socket_fd
+     * @param  msgs             数据缓存数组，每个元素接收一个报文
+     * @param  lens             输出每个报文的实际长度
+     * @param  src_addrs        输出每个报文的来源地址，可以为NULL
+     * @param  num              数据缓存数组的长度
+     * @return int
+     * 如果接收成功，返回接收的报文数(至少为1，阻塞直到第一个报文到达);如果接收失败，返回-1
+     */
+    static int recv_msg_batch(const int socket_fd, const SocketMessage *msgs,
+                              int *lens, Address *src_addrs,
+                              const uint num) {
+        static_assert(Type == SOCK_DGRAM, "batches need a datagram socket");
+        struct mmsghdr hdrs[MAX_UDP_BATCH_NUM];
+        struct iovec iovs[MAX_UDP_BATCH_NUM];
+        uint batch = num < MAX_UDP_BATCH_NUM ? num : MAX_UDP_BATCH_NUM;
+        int ret = 0;
+
+        bzero(hdrs, sizeof(struct mmsghdr) * batch);
+        for (uint i = 0; i < batch; ++i) {
+            iovs[i].iov_base = msgs[i].buf;
+            iovs[i].iov_len = msgs[i].len;
+            hdrs[i].msg_hdr.msg_iov = &iovs[i];
+            hdrs[i].msg_hdr.msg_iovlen = 1;
+            if (src_addrs != NULL) {
+                hdrs[i].msg_hdr.msg_name = &src_addrs[i];
+                hdrs[i].msg_hdr.msg_namelen = sizeof(Address);
+            }
+        }
+
+        // 阻塞等待第一个报文，之后只取走已经到达的报文
+        uint64_t start_ns = start_socket_metrics_clock();
+        ret = recvmmsg(socket_fd, hdrs, batch, MSG_WAITFORONE, NULL);
+        size_t bytes = 0;
+        for (int i = 0; i < ret; ++i) {
+            lens[i] = hdrs[i].msg_len;
+            bytes += hdrs[i].msg_len;
+        }
+        record_socket_syscall(socket_fd, SOCKET_METRICS_RECV,
+                              ret < 0 ? -1 : (ssize_t)bytes, bytes);
+        if (ret > 0) {
+            record_socket_msg(socket_fd, SOCKET_METRICS_RECV, ret, start_ns);
+        }
+
+        return ret;
+    }
+
+    /**
+     * @brief 报文套接字批量发送数据，每MAX_UDP_BATCH_NUM个报文一次sendmmsg
+     * @param  socket_fd        已连接的报文套接字
+     * @param  msgs             需要发送的数据数组，每个元素作为一个报文
+     * @param  num              数据数组的长度
+     * @return int 如果发送成功，返回发送的报文数;如果一个也没有发出，返回-1
+     */
+    static int send_msg_batch(const int socket_fd, const SocketMessage *msgs,
+                              const uint num) {
+        static_assert(Type == SOCK_DGRAM, "batches need a datagram socket");
+        struct mmsghdr hdrs[MAX_UDP_BATCH_NUM];
+        struct iovec iovs[MAX_UDP_BATCH_NUM];
+        uint sent = 0;
+
+        while (sent < num) {
+            uint batch = num - sent < MAX_UDP_BATCH_NUM ? num - sent
+                                                        : MAX_UDP_BATCH_NUM;
+            size_t len = 0;
+            bzero(hdrs, sizeof(struct mmsghdr) * batch);
+            for (uint i = 0; i < batch; ++i) {
+                iovs[i].iov_base = msgs[sent + i].buf;
+                iovs[i].iov_len = msgs[sent + i].len;
+                hdrs[i].msg_hdr.msg_iov = &iovs[i];
+                hdrs[i].msg_hdr.msg_iovlen = 1;
+                len += msgs[sent + i].len;
+            }
+
+            uint64_t start_ns = start_socket_metrics_clock();
+            int ret = sendmmsg(socket_fd, hdrs, batch, 0);
+            size_t bytes = 0;
+            for (int i = 0; i < ret; ++i) bytes += hdrs[i].msg_len;
+            record_socket_syscall(socket_fd, SOCKET_METRICS_SEND,
+                                  ret < 0 ? -1 : (ssize_t)bytes, len);
+            if (ret <= 0) return sent > 0 ? (int)sent : -1;
+            record_socket_msg(socket_fd, SOCKET_METRICS_SEND, ret, start_ns);
+            sent += ret;
+        }
+
+        return sent;
+    }
+
+    /**
+     * @brief 关闭一个本传输的服务端
+     * @param  socket_fd        被关闭服务端的socket_fd
+     * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+     */
+    static int close_server(const int socket_fd) {
+        return close_registered_socket(socket_fd, KindTraits::server());
+    }
+
+    /**
+     * @brief 关闭一个本传输的客户端
+     * @param  socket_fd        被关闭客户端的socket_fd
+     * @return int 如果关闭成功，返回1;如果关闭失败，返回-1
+     */
+    static int close_client(const int socket_fd) {
+        return close_registered_socket(socket_fd, KindTraits::client());
+    }
+
+    static int close_all_server() {
+        return close_all_registered_socket(KindTraits::server());
+    }
+
+    static int close_all_client() {
+        return close_all_registered_socket(KindTraits::client());
+    }
+
+   private:
+    // seqpacket对端关闭后的写入返回EPIPE而不是发出SIGPIPE
+    static int send_flags() {
+        return Type == SOCK_SEQPACKET ? MSG_NOSIGNAL : 0;
+    }
+
+    static int open_socket() {
+        int socket_fd = socket(Family, Type, 0);
+
+        if (socket_fd < 0) {
+            SOCKET_LOG_ERROR("Socket create...failed!");
+            return -1;
+        } else {
+            SOCKET_LOG_DEBUG("Socket create...success!");
+        }
+
+        return socket_fd;
+    }
+
+    // reuse_opt为SO_REUSEPORT或SO_REUSEADDR时在绑定前开启，为0时不设置
+    static int bind_socket(const char *const addr, const uint port,
+                           const int reuse_opt) {
+        Address server_addr;
+        socklen_t len = AddressTraits::fill(&server_addr, addr, port);
+        int socket_fd = open_socket();
+        if (socket_fd < 0) return -1;
+
+        if (reuse_opt != 0) {
+            int on = 1;
+            const char *name =
+                reuse_opt == SO_REUSEPORT ? "SO_REUSEPORT" : "SO_REUSEADDR";
+            if (setsockopt(socket_fd, SOL_SOCKET, reuse_opt, &on,
+                           sizeof(on)) < 0) {
+                SOCKET_LOG_ERROR("Set %s...failed!", name);
+                close(socket_fd);
+                return -1;
+            } else {
+                SOCKET_LOG_DEBUG("Set %s...success!", name);
+            }
+        }
+
+        if (len > 0) AddressTraits::release(addr);
+        if (len == 0) errno = EINVAL;
+        if (len == 0 ||
+            bind(socket_fd, (struct sockaddr *)&server_addr, len) < 0) {
+            SOCKET_LOG_ERROR("Binding socket...failed!");
+            close(socket_fd);
+            return -1;
+        } else {
+            SOCKET_LOG_DEBUG("Binding socket...success!");
+        }
+
+        return socket_fd;
+    }
+};
+
+typedef SocketTransport<AF_INET, SOCK_STREAM> TcpIpTransport;
+typedef SocketTransport<AF_INET, SOCK_DGRAM> UdpIpTransport;
+typedef SocketTransport<AF_UNIX, SOCK_STREAM> TcpDomainTransport;
+typedef SocketTransport<AF_UNIX, SOCK_DGRAM> UdpDomainTransport;
+typedef SocketTransport<AF_UNIX, SOCK_SEQPACKET> SeqpacketDomainTransport;
+
+#endif  // SOCKET_TRANSPORT_HPP_
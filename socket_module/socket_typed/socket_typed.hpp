@@ -0,0 +1,213 @@
+/**
+ * @file socket_typed.hpp
+ * @brief
+ * 声名了定长类型消息的定义方式与收发模板。消息结构体按内存布局原样作为帧负载发出，
+ * 类型、版本与字节序记录在帧头中，布局在编译期检查，按类型分发通过编译期生成的常量表完成。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef SOCKET_TYPED_HPP_
+#define SOCKET_TYPED_HPP_
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+
+#include "../socket_frame/socket_frame.hpp"
+#include "../socket_message.hpp"
+
+// 帧头flags字段的低15位为版本号，最高位标记发送方的字节序
+#define SOCKET_TYPED_VERSION_MASK 0x7FFF
+#define SOCKET_TYPED_BIG_ENDIAN 0x8000
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SOCKET_TYPED_HOST_ENDIAN SOCKET_TYPED_BIG_ENDIAN
+#else
+#define SOCKET_TYPED_HOST_ENDIAN 0
+#endif
+
+/**
+ * @brief 消息的描述，由DEFINE_SOCKET_MESSAGE特化，未定义描述的类型无法收发
+ * @tparam T 消息结构体
+ */
+template <typename T>
+struct SocketMessageSchema;
+
+/**
+ * @brief 定义一种类型消息，需在全局命名空间中使用
+ * @param  T                消息结构体，必须可平凡复制且为标准布局
+ * @param  TYPE             帧类型，同一分发表中不能重复
+ * @param  VERSION          版本号，结构体布局改变时递增
+ * @param  SIZE             结构体的大小，与sizeof(T)不一致时编译失败
+ */
+#define DEFINE_SOCKET_MESSAGE(T, TYPE, VERSION, SIZE)                     \
+    static_assert(std::is_trivially_copyable<T>::value,                  \
+                  #T " must be trivially copyable");                     \
+    static_assert(std::is_standard_layout<T>::value,                     \
+                  #T " must be standard layout");                        \
+    static_assert(sizeof(T) == (SIZE), "sizeof(" #T ") != " #SIZE);      \
+    static_assert((SIZE) <= MAX_FRAME_PAYLOAD_LEN, #T " is too large");  \
+    static_assert((VERSION) <= SOCKET_TYPED_VERSION_MASK,                \
+                  #T " version is out of range");                        \
+    template <>                                                          \
+    struct SocketMessageSchema<T> {                                      \
+        static constexpr uint16_t type = (TYPE);                         \
+        static constexpr uint16_t version = (VERSION);                   \
+    }
+
+/**
+ * @brief 固定消息中某个字段的偏移，编译器改变填充方式时编译失败
+ * @param  T                消息结构体
+ * @param  FIELD            字段名
+ * @param  OFFSET           字段的字节偏移
+ */
+#define CHECK_SOCKET_MESSAGE_FIELD(T, FIELD, OFFSET) \
+    static_assert(offsetof(T, FIELD) == (OFFSET),    \
+                  "offsetof(" #T ", " #FIELD ") != " #OFFSET)
+
+///////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 类型消息在帧头中的flags字段
+ * @tparam T 消息结构体
+ * @return uint16_t 版本号与本机字节序标记
+ */
+template <typename T>
+inline uint16_t get_typed_msg_flags() {
+    return SocketMessageSchema<T>::version | SOCKET_TYPED_HOST_ENDIAN;
+}
+
+/**
+ * @brief 发送一条类型消息，结构体直接作为负载写出，不经过中间缓存
+ * @param  socket_fd        流式套接字
+ * @param  msg              需要发送的消息
+ * @return int 如果发送成功，返回发送的总字节数(含帧头);如果发送失败，返回-1
+ */
+template <typename T>
+inline int send_typed_msg(const int socket_fd, const T &msg) {
+    SocketMessage payload = {(char *)&msg, sizeof(T)};
+    return send_socket_frame(socket_fd, SocketMessageSchema<T>::type,
+                             &payload, get_typed_msg_flags<T>());
+}
+
+/**
+ * @brief 从一帧中解出类型消息，只做一次memcpy;解帧器的缓存不保证对齐，因此不直接转换指针
+ * @param  frame            收到的帧
+ * @param  msg              解出的消息
+ * @return int
+ * 如果解出成功，返回1;如果类型、版本、字节序或长度不匹配，返回-1并将errno设为EPROTO
+ */
+template <typename T>
+inline int decode_typed_msg(const SocketFrame *frame, T *msg) {
+    if (frame->type != SocketMessageSchema<T>::type ||
+        frame->flags != get_typed_msg_flags<T>() ||
+        frame->payload.len != sizeof(T)) {
+        errno = EPROTO;
+        return -1;
+    }
+    memcpy(msg, frame->payload.buf, sizeof(T));
+
+    return 1;
+}
+
+/**
+ * @brief 阻塞接收一条指定类型的消息
+ * @param  socket_fd        流式套接字
+ * @param  decoder          该连接的解帧器
+ * @param  msg              收到的消息
+ * @return int
+ * 如果接收成功，返回1;如果对端关闭，返回0;如果接收失败或收到其他类型的消息，返回-1
+ */
+template <typename T>
+inline int recv_typed_msg(const int socket_fd, SocketFrameDecoder *decoder,
+                          T *msg) {
+    SocketFrame frame;
+    int ret = recv_socket_frame(socket_fd, decoder, &frame);
+    if (ret <= 0) return ret;
+    return decode_typed_msg(&frame, msg);
+}
+
+///////////////////////////////////////////////////////////////////
+
+namespace typed_detail {
+
+template <typename Handler>
+struct DispatchEntry {
+    uint16_t type;
+    int (*func)(const SocketFrame *, Handler &);
+};
+
+template <typename Handler, typename T>
+int dispatch_entry(const SocketFrame *frame, Handler &handler) {
+    T msg;
+    if (decode_typed_msg(frame, &msg) < 0) return -1;
+    handler(msg);
+    return 1;
+}
+
+// 编译期检查分发表中的帧类型没有重复
+template <uint16_t Type, typename... Msgs>
+struct ContainsType {
+    static constexpr bool value = false;
+};
+
+template <uint16_t Type, typename T, typename... Rest>
+struct ContainsType<Type, T, Rest...> {
+    static constexpr bool value = SocketMessageSchema<T>::type == Type ||
+                                  ContainsType<Type, Rest...>::value;
+};
+
+template <typename... Msgs>
+struct UniqueTypes {
+    static constexpr bool value = true;
+};
+
+template <typename T, typename... Rest>
+struct UniqueTypes<T, Rest...> {
+    static constexpr bool value =
+        !ContainsType<SocketMessageSchema<T>::type, Rest...>::value &&
+        UniqueTypes<Rest...>::value;
+};
+
+template <typename Handler, typename... Msgs>
+struct DispatchTable {
+    static_assert(sizeof...(Msgs) > 0, "dispatch table is empty");
+    static_assert(UniqueTypes<Msgs...>::value,
+                  "duplicate message type in dispatch table");
+
+    static constexpr DispatchEntry<Handler> entries[sizeof...(Msgs)] = {
+        {SocketMessageSchema<Msgs>::type, &dispatch_entry<Handler, Msgs>}...};
+};
+
+template <typename Handler, typename... Msgs>
+constexpr DispatchEntry<Handler>
+    DispatchTable<Handler, Msgs...>::entries[sizeof...(Msgs)];
+
+}  // namespace typed_detail
+
+/**
+ * @brief 按帧类型解出消息并调用handler(const T &)，分发表在编译期生成
+ * @tparam Msgs 可以分发的消息类型
+ * @param  frame            收到的帧
+ * @param  handler          为每种消息类型重载了operator()的处理器
+ * @return int
+ * 如果分发成功，返回1;如果帧类型不在表中，返回0;如果版本、字节序或长度不匹配，返回-1
+ */
+template <typename... Msgs, typename Handler>
+inline int dispatch_typed_msg(const SocketFrame *frame, Handler &handler) {
+    typedef typed_detail::DispatchTable<Handler, Msgs...> Table;
+
+    for (size_t i = 0; i < sizeof...(Msgs); ++i) {
+        if (Table::entries[i].type == frame->type) {
+            return Table::entries[i].func(frame, handler);
+        }
+    }
+    return 0;
+}
+
+#endif  // SOCKET_TYPED_HPP_
@@ -0,0 +1,653 @@
+/**
+ * @file uring_socket.cpp
+ * @brief
+ * 实现了基于io_uring的套接字I/O后端。监听套接字与连接分别只提交一次多路accept与多路recv，
+ * 之后每个新连接或每段数据只对应一个完成事件;接收数据写入注册给内核的缓存环，发送时消息位于
+ * 注册的发送缓存中则使用WRITE_FIXED。内核或头文件不支持io_uring时，所有操作退回阻塞调用。
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#include "uring_socket.hpp"
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../socket_log/socket_log.hpp"
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+// 多路recv与按fd取消是本后端依赖的最新特性，头文件缺少时视为不可用
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ASYNC_CANCEL_FD)
+#define URING_SOCKET_AVAILABLE
+#endif
+#endif
+
+#define NO_BUFFER_ID 0xffff
+#define MAX_URING_BUFFER_NUM 32768
+
+enum UringOperation {
+    URING_OP_ACCEPT = 1,
+    URING_OP_RECV,
+    URING_OP_SEND,
+    URING_OP_CLOSE,
+    URING_OP_CANCEL
+};
+
+#ifdef URING_SOCKET_AVAILABLE
+
+/**
+ * @brief 将操作类型、fd的代数与fd编码进user_data
+ */
+static uint64_t make_user_data(const int op, const uint32_t generation,
+                               const int fd) {
+    return ((uint64_t)op << 56) | ((uint64_t)(generation & 0xffffff) << 32) |
+           (uint32_t)fd;
+}
+
+static uint32_t fd_generation(UringSocket *ring, const int fd) {
+    std::map<int, uint32_t>::iterator it = ring->fd_generation.find(fd);
+    return it == ring->fd_generation.end() ? 0 : it->second;
+}
+
+static unsigned load_acquire(const unsigned *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static void store_release(unsigned *ptr, const unsigned value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 提交所有待提交的请求，并等待至少wait_num个完成事件
+ * @param  ring             io_uring后端
+ * @param  wait_num         需要等待的完成事件数量
+ * @return int 如果提交成功，返回1;如果提交失败，返回-1
+ */
+static int submit_and_wait(UringSocket *ring, const unsigned wait_num) {
+    int ret = syscall(__NR_io_uring_enter, ring->ring_fd, ring->sq_pending,
+                      wait_num, wait_num > 0 ? IORING_ENTER_GETEVENTS : 0,
+                      NULL, 0);
+    if (ret < 0) return errno == EINTR ? 1 : -1;
+
+    ring->sq_pending -= ret;
+    return 1;
+}
+
+/**
+ * @brief 取得一个空闲的提交项，提交队列已满时先提交已有请求
+ * @param  ring             io_uring后端
+ * @return struct io_uring_sqe* 清零后的提交项;如果提交失败，返回NULL
+ */
+static struct io_uring_sqe *get_sqe(UringSocket *ring) {
+    unsigned tail = *ring->sq_tail;
+    if (tail - load_acquire(ring->sq_head) >= ring->sq_entries) {
+        if (submit_and_wait(ring, 0) < 0) return NULL;
+        if (tail - load_acquire(ring->sq_head) >= ring->sq_entries) {
+            return NULL;
+        }
+    }
+
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = (struct io_uring_sqe *)ring->sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    store_release(ring->sq_tail, tail + 1);
+    ++ring->sq_pending;
+
+    return sqe;
+}
+
+/**
+ * @brief 将一块接收缓存归还内核的缓存环
+ * @param  ring             io_uring后端
+ * @param  buf_id           缓存编号
+ */
+static void recycle_buffer(UringSocket *ring, const uint16_t buf_id) {
+    struct io_uring_buf_ring *buf_ring =
+        (struct io_uring_buf_ring *)ring->buf_ring;
+    unsigned short tail = buf_ring->tail;
+    // bufs在C++中会因空结构体成员而偏移，这里按缓存环的实际布局计算
+    struct io_uring_buf *buf =
+        (struct io_uring_buf *)ring->buf_ring + (tail & (ring->buf_num - 1));
+
+    buf->addr = (uint64_t)(ring->buf_base + (size_t)buf_id * ring->buf_len);
+    buf->len = ring->buf_len;
+    buf->bid = buf_id;
+    __atomic_store_n(&buf_ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 取出所有完成事件，按操作类型与fd分发到对应的队列
+ * @param  ring             io_uring后端
+ */
+static void reap_completions(UringSocket *ring) {
+    unsigned head = *ring->cq_head;
+    unsigned tail = load_acquire(ring->cq_tail);
+
+    for (; head != tail; ++head) {
+        struct io_uring_cqe *cqe =
+            (struct io_uring_cqe *)ring->cqes + (head & *ring->cq_mask);
+        int op = cqe->user_data >> 56;
+        int fd = (int)(uint32_t)cqe->user_data;
+        bool stale = ((cqe->user_data >> 32) & 0xffffff) !=
+                     (fd_generation(ring, fd) & 0xffffff);
+        bool more = cqe->flags & IORING_CQE_F_MORE;
+        UringCompletion completion;
+        completion.res = cqe->res;
+        completion.buf_id = cqe->flags & IORING_CQE_F_BUFFER
+                                ? cqe->flags >> IORING_CQE_BUFFER_SHIFT
+                                : NO_BUFFER_ID;
+        completion.offset = 0;
+
+        if (op == URING_OP_ACCEPT) {
+            if (stale) {
+                if (cqe->res >= 0) close(cqe->res);
+            } else {
+                ring->accept_queue[fd].push_back(completion);
+                if (!more) ring->accept_armed.erase(fd);
+            }
+        } else if (op == URING_OP_RECV) {
+            if (stale) {
+                if (completion.buf_id != NO_BUFFER_ID) {
+                    recycle_buffer(ring, completion.buf_id);
+                }
+            } else {
+                ring->recv_queue[fd].push_back(completion);
+                if (!more) ring->recv_armed.erase(fd);
+            }
+        } else if (op == URING_OP_SEND || op == URING_OP_CLOSE) {
+            ring->oneshot_result[cqe->user_data] = cqe->res;
+        }
+    }
+
+    store_release(ring->cq_head, head);
+}
+
+/**
+ * @brief 提交一个单次请求并等待它完成
+ * @param  ring             io_uring后端
+ * @param  user_data        请求的user_data
+ * @return int 请求的结果，失败时设置errno并返回-1
+ */
+static int wait_oneshot(UringSocket *ring, const uint64_t user_data) {
+    std::map<uint64_t, int>::iterator it;
+    while ((it = ring->oneshot_result.find(user_data)) ==
+           ring->oneshot_result.end()) {
+        if (submit_and_wait(ring, 1) < 0) return -1;
+        reap_completions(ring);
+    }
+
+    int res = it->second;
+    ring->oneshot_result.erase(it);
+    if (res < 0) {
+        errno = -res;
+        return -1;
+    }
+    return res;
+}
+
+/**
+ * @brief 释放io_uring相关的映射与缓存
+ * @param  ring             io_uring后端
+ */
+static void release_ring(UringSocket *ring) {
+    if (ring->sqes != NULL) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ptr != NULL && ring->cq_ptr != ring->sq_ptr) {
+        munmap(ring->cq_ptr, ring->cq_size);
+    }
+    if (ring->sq_ptr != NULL) munmap(ring->sq_ptr, ring->sq_size);
+    if (ring->ring_fd >= 0) close(ring->ring_fd);
+    free(ring->buf_ring);
+    free(ring->buf_base);
+
+    ring->sqes = ring->sq_ptr = ring->cq_ptr = NULL;
+    ring->buf_ring = NULL;
+    ring->buf_base = NULL;
+    ring->ring_fd = -1;
+    ring->enabled = false;
+}
+
+/**
+ * @brief 创建io_uring实例并映射提交队列与完成队列
+ * @param  ring             io_uring后端
+ * @param  entries          提交队列长度
+ * @return int 如果创建成功，返回1;如果创建失败，返回-1
+ */
+static int setup_ring(UringSocket *ring, const unsigned entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    ring->ring_fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->ring_fd < 0) return -1;
+
+    ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_size > ring->sq_size) ring->sq_size = ring->cq_size;
+        ring->cq_size = ring->sq_size;
+    }
+
+    void *ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                     IORING_OFF_SQ_RING);
+    if (ptr == MAP_FAILED) return -1;
+    ring->sq_ptr = ptr;
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ptr = ring->sq_ptr;
+    } else {
+        ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                   IORING_OFF_CQ_RING);
+        if (ptr == MAP_FAILED) return -1;
+        ring->cq_ptr = ptr;
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ptr = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQES);
+    if (ptr == MAP_FAILED) return -1;
+    ring->sqes = ptr;
+
+    char *sq = (char *)ring->sq_ptr;
+    char *cq = (char *)ring->cq_ptr;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sq_entries = params.sq_entries;
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = cq + params.cq_off.cqes;
+
+    return 1;
+}
+
+/**
+ * @brief 检查内核是否支持本后端用到的所有操作
+ * @param  ring             io_uring后端
+ * @return int 如果全部支持，返回1;否则返回-1
+ */
+static int probe_ops(UringSocket *ring) {
+    const int ops[] = {IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND,
+                       IORING_OP_CLOSE, IORING_OP_ASYNC_CANCEL,
+                       IORING_OP_WRITE_FIXED};
+    size_t size = sizeof(struct io_uring_probe) +
+                  256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = (struct io_uring_probe *)calloc(1, size);
+    int ret = 1;
+
+    if (probe == NULL) return -1;
+    if (syscall(__NR_io_uring_register, ring->ring_fd, IORING_REGISTER_PROBE,
+                probe, 256) < 0) {
+        ret = -1;
+    }
+    for (size_t i = 0; ret > 0 && i < sizeof(ops) / sizeof(ops[0]); ++i) {
+        if (ops[i] > probe->last_op ||
+            !(probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED)) {
+            ret = -1;
+        }
+    }
+
+    free(probe);
+    return ret;
+}
+
+/**
+ * @brief 申请接收缓存并以缓存环的形式注册给内核，供多路recv自动选取
+ * @param  ring             io_uring后端
+ * @param  buffer_len       每块接收缓存的容量
+ * @param  buffer_num       接收缓存的数量
+ * @return int 如果注册成功，返回1;如果注册失败，返回-1
+ */
+static int register_buffer_ring(UringSocket *ring, const size_t buffer_len,
+                                const unsigned buffer_num) {
+    struct io_uring_buf_reg reg;
+    unsigned num = 1;
+
+    // 缓存环的长度必须是2的幂
+    while (num * 2 <= buffer_num && num * 2 <= MAX_URING_BUFFER_NUM) num *= 2;
+    ring->buf_num = num;
+    ring->buf_len = buffer_len;
+
+    if (posix_memalign(&ring->buf_ring, getpagesize(),
+                       num * sizeof(struct io_uring_buf)) != 0) {
+        ring->buf_ring = NULL;
+        return -1;
+    }
+    if (posix_memalign((void **)&ring->buf_base, getpagesize(),
+                       num * buffer_len) != 0) {
+        ring->buf_base = NULL;
+        return -1;
+    }
+
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)ring->buf_ring;
+    reg.ring_entries = num;
+    reg.bgid = URING_BUFFER_GROUP_ID;
+    if (syscall(__NR_io_uring_register, ring->ring_fd,
+                IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        return -1;
+    }
+
+    ((struct io_uring_buf_ring *)ring->buf_ring)->tail = 0;
+    for (unsigned i = 0; i < num; ++i) recycle_buffer(ring, i);
+
+    return 1;
+}
+
+/**
+ * @brief 注册发送缓存，失败时不影响后端使用，只是发送不再走WRITE_FIXED
+ * @param  ring             io_uring后端
+ * @param  fixed_bufs       发送缓存数组
+ * @param  fixed_buf_num    发送缓存数量
+ */
+static void register_fixed_buffers(UringSocket *ring,
+                                   const SocketMessage *fixed_bufs,
+                                   const unsigned fixed_buf_num) {
+    struct iovec *iovs = NULL;
+
+    ring->fixed_bufs = NULL;
+    ring->fixed_buf_num = 0;
+    if (fixed_bufs == NULL || fixed_buf_num == 0) return;
+
+    iovs = (struct iovec *)calloc(fixed_buf_num, sizeof(struct iovec));
+    if (iovs == NULL) return;
+    for (unsigned i = 0; i < fixed_buf_num; ++i) {
+        iovs[i].iov_base = fixed_bufs[i].buf;
+        iovs[i].iov_len = fixed_bufs[i].len;
+    }
+
+    if (syscall(__NR_io_uring_register, ring->ring_fd,
+                IORING_REGISTER_BUFFERS, iovs, fixed_buf_num) == 0) {
+        ring->fixed_bufs = fixed_bufs;
+        ring->fixed_buf_num = fixed_buf_num;
+    }
+    free(iovs);
+}
+
+/**
+ * @brief 查找消息所在的注册发送缓存
+ * @param  ring             io_uring后端
+ * @param  msg              需要发送的消息
+ * @return int 注册发送缓存的编号;如果不在任何注册缓存中，返回-1
+ */
+static int find_fixed_buffer(UringSocket *ring, const SocketMessage *msg) {
+    for (unsigned i = 0; i < ring->fixed_buf_num; ++i) {
+        const SocketMessage &fixed = ring->fixed_bufs[i];
+        if (msg->buf >= fixed.buf &&
+            msg->buf + msg->len <= fixed.buf + fixed.len) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#endif  // URING_SOCKET_AVAILABLE
+
+/**
+ * @brief 初始化io_uring后端，io_uring不可用时退回阻塞调用
+ * @param  ring             需要初始化的后端
+ * @param  entries          提交队列长度;为0时直接使用阻塞调用
+ * @param  buffer_len       每块接收缓存的容量
+ * @param  buffer_num       接收缓存的数量，向下取整为2的幂
+ * @param  fixed_bufs
+ * 需要注册的发送缓存，消息位于其中时免去每次发送时的页面映射;可以为NULL
+ * @param  fixed_buf_num    发送缓存数量
+ * @return int 如果启用了io_uring，返回1;如果退回阻塞调用，返回0
+ */
+int init_uring_socket(UringSocket *ring, const unsigned entries,
+                      const size_t buffer_len, const unsigned buffer_num,
+                      const SocketMessage *fixed_bufs,
+                      const unsigned fixed_buf_num) {
+    ring->enabled = false;
+    ring->multishot_recv = false;
+    ring->ring_fd = -1;
+    ring->sq_ptr = ring->cq_ptr = ring->sqes = NULL;
+    ring->sq_pending = 0;
+    ring->buf_ring = NULL;
+    ring->buf_base = NULL;
+    ring->fixed_bufs = NULL;
+    ring->fixed_buf_num = 0;
+
+    if (entries == 0) return 0;
+
+#ifdef URING_SOCKET_AVAILABLE
+    if (setup_ring(ring, entries) < 0 || probe_ops(ring) < 0 ||
+        register_buffer_ring(ring, buffer_len, buffer_num) < 0) {
+        SOCKET_LOG_WARN(
+            "Io_uring setup...failed, fall back to blocking calls!");
+        release_ring(ring);
+        return 0;
+    }
+    SOCKET_LOG_DEBUG("Io_uring setup...success!");
+
+    register_fixed_buffers(ring, fixed_bufs, fixed_buf_num);
+    ring->enabled = true;
+    ring->multishot_recv = true;
+    return 1;
+#else
+    SOCKET_LOG_WARN("Io_uring unavailable, fall back to blocking calls!");
+    return 0;
+#endif
+}
+
+/**
+ * @brief 接受一个新连接，首次调用时在监听套接字上提交多路accept
+ * @param  ring             io_uring后端
+ * @param  socket_fd        服务端的socket_fd
+ * @return int 如果接受成功，返回accept_fd;如果接受失败，返回-1
+ */
+int uring_accept(UringSocket *ring, const int socket_fd) {
+#ifdef URING_SOCKET_AVAILABLE
+    if (ring->enabled) {
+        while (1) {
+            std::deque<UringCompletion> &queue = ring->accept_queue[socket_fd];
+            if (!queue.empty()) {
+                int res = queue.front().res;
+                queue.pop_front();
+                if (res < 0) {
+                    errno = -res;
+                    return -1;
+                }
+                return res;
+            }
+
+            if (ring->accept_armed.count(socket_fd) == 0) {
+                struct io_uring_sqe *sqe = get_sqe(ring);
+                if (sqe == NULL) return -1;
+                sqe->opcode = IORING_OP_ACCEPT;
+                sqe->fd = socket_fd;
+                sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+                sqe->user_data =
+                    make_user_data(URING_OP_ACCEPT,
+                                   fd_generation(ring, socket_fd), socket_fd);
+                ring->accept_armed.insert(socket_fd);
+            }
+
+            if (submit_and_wait(ring, 1) < 0) return -1;
+            reap_completions(ring);
+        }
+    }
+#endif
+    return accept(socket_fd, NULL, NULL);
+}
+
+/**
+ * @brief
+ * 接收数据，首次调用时在连接上提交多路recv;一段数据大于msg->len时剩余部分留给下次调用
+ * @param  ring             io_uring后端
+ * @param  accept_fd        已建立的连接
+ * @param  msg              数据缓存的指针
+ * @return int 如果接收成功，返回接收的字节数;如果对端关闭，返回0;如果接收失败，返回-1
+ */
+int uring_recv(UringSocket *ring, const int accept_fd,
+               const SocketMessage *msg) {
+#ifdef URING_SOCKET_AVAILABLE
+    while (ring->enabled && ring->multishot_recv) {
+        std::deque<UringCompletion> &queue = ring->recv_queue[accept_fd];
+        if (!queue.empty()) {
+            UringCompletion &front = queue.front();
+            if (front.res <= 0) {
+                int res = front.res;
+                queue.pop_front();
+                if (res == 0) return 0;
+                if (res == -ENOBUFS) continue;  // 缓存耗尽，重新提交即可
+                if (res == -EINVAL) {
+                    ring->multishot_recv = false;
+                    break;
+                }
+                errno = -res;
+                return -1;
+            }
+
+            size_t len = front.res - front.offset;
+            if (len > msg->len) len = msg->len;
+            memcpy(msg->buf,
+                   ring->buf_base + (size_t)front.buf_id * ring->buf_len +
+                       front.offset,
+                   len);
+            front.offset += len;
+            if (front.offset == (size_t)front.res) {
+                recycle_buffer(ring, front.buf_id);
+                queue.pop_front();
+            }
+            return len;
+        }
+
+        if (ring->recv_armed.count(accept_fd) == 0) {
+            struct io_uring_sqe *sqe = get_sqe(ring);
+            if (sqe == NULL) return -1;
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = accept_fd;
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = URING_BUFFER_GROUP_ID;
+            sqe->user_data = make_user_data(
+                URING_OP_RECV, fd_generation(ring, accept_fd), accept_fd);
+            ring->recv_armed.insert(accept_fd);
+        }
+
+        if (submit_and_wait(ring, 1) < 0) return -1;
+        reap_completions(ring);
+    }
+#endif
+    return recv(accept_fd, msg->buf, msg->len, 0);
+}
+
+/**
+ * @brief 发送数据，消息位于注册的发送缓存中时使用WRITE_FIXED
+ * @param  ring             io_uring后端
+ * @param  socket_fd        客户端的socket_fd或服务端的accept_fd
+ * @param  msg              需要发送数据的指针
+ * @return int 如果发送成功，返回发送的字节数;如果发送失败，返回-1
+ */
+int uring_send(UringSocket *ring, const int socket_fd,
+               const SocketMessage *msg) {
+#ifdef URING_SOCKET_AVAILABLE
+    if (ring->enabled) {
+        struct io_uring_sqe *sqe = get_sqe(ring);
+        int buf_index = find_fixed_buffer(ring, msg);
+        if (sqe == NULL) return -1;
+
+        if (buf_index >= 0) {
+            sqe->opcode = IORING_OP_WRITE_FIXED;
+            sqe->buf_index = buf_index;
+        } else {
+            sqe->opcode = IORING_OP_SEND;
+        }
+        sqe->fd = socket_fd;
+        sqe->addr = (uint64_t)msg->buf;
+        sqe->len = msg->len;
+        sqe->user_data = make_user_data(
+            URING_OP_SEND, fd_generation(ring, socket_fd), socket_fd);
+
+        return wait_oneshot(ring, sqe->user_data);
+    }
+#endif
+    return send(socket_fd, msg->buf, msg->len, 0);
+}
+
+/**
+ * @brief 关闭套接字，同时取消该套接字上的多路accept与多路recv
+ * @param  ring             io_uring后端
+ * @param  socket_fd        需要关闭的套接字
+ * @return int 如果关闭成功，返回0;如果关闭失败，返回-1
+ */
+int uring_close(UringSocket *ring, const int socket_fd) {
+#ifdef URING_SOCKET_AVAILABLE
+    if (ring->enabled) {
+        uint32_t generation = fd_generation(ring, socket_fd);
+        struct io_uring_sqe *sqe = NULL;
+
+        if (ring->accept_armed.count(socket_fd) > 0 ||
+            ring->recv_armed.count(socket_fd) > 0) {
+            sqe = get_sqe(ring);
+            if (sqe == NULL) return -1;
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = socket_fd;
+            sqe->cancel_flags =
+                IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+            sqe->flags = IOSQE_IO_HARDLINK;  // 先取消再关闭
+            sqe->user_data =
+                make_user_data(URING_OP_CANCEL, generation, socket_fd);
+        }
+
+        // 丢弃尚未取走的事件，之后到达的旧事件会因代数不同而被丢弃
+        std::deque<UringCompletion> &accepts = ring->accept_queue[socket_fd];
+        for (size_t i = 0; i < accepts.size(); ++i) {
+            if (accepts[i].res >= 0) close(accepts[i].res);
+        }
+        std::deque<UringCompletion> &recvs = ring->recv_queue[socket_fd];
+        for (size_t i = 0; i < recvs.size(); ++i) {
+            if (recvs[i].buf_id != NO_BUFFER_ID) {
+                recycle_buffer(ring, recvs[i].buf_id);
+            }
+        }
+        ring->accept_queue.erase(socket_fd);
+        ring->recv_queue.erase(socket_fd);
+        ring->accept_armed.erase(socket_fd);
+        ring->recv_armed.erase(socket_fd);
+        ring->fd_generation[socket_fd] = ++generation;
+
+        sqe = get_sqe(ring);
+        if (sqe == NULL) return -1;
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = socket_fd;
+        sqe->user_data = make_user_data(URING_OP_CLOSE, generation, socket_fd);
+
+        return wait_oneshot(ring, sqe->user_data);
+    }
+#endif
+    return close(socket_fd);
+}
+
+/**
+ * @brief 关闭io_uring后端，释放注册的缓存
+ * @param  ring             io_uring后端
+ * @return int 关闭成功，返回1
+ */
+int close_uring_socket(UringSocket *ring) {
+#ifdef URING_SOCKET_AVAILABLE
+    if (ring->ring_fd >= 0) release_ring(ring);
+#endif
+    ring->accept_armed.clear();
+    ring->recv_armed.clear();
+    ring->accept_queue.clear();
+    ring->recv_queue.clear();
+    ring->oneshot_result.clear();
+    ring->fd_generation.clear();
+
+    return 1;
+}
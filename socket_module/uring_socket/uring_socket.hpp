@@ -0,0 +1,84 @@
+/**
+ * @file uring_socket.hpp
+ * @brief 声名了基于io_uring的套接字I/O后端，不可用时自动退回阻塞调用
+ * @author Chenwei Jia (cwjia98@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+#ifndef URING_SOCKET_HPP_
+#define URING_SOCKET_HPP_
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <set>
+
+#include "../socket_message.hpp"
+
+#define URING_BUFFER_GROUP_ID 1  // 多路接收使用的缓存组编号
+
+// 一次完成事件，接收事件的数据位于注册的接收缓存中
+typedef struct UringCompletion {
+    int res;
+    uint16_t buf_id;
+    size_t offset;  // 已经拷出的字节数
+} UringCompletion;
+
+typedef struct UringSocket {
+    bool enabled;         // 为false时所有操作直接使用阻塞调用
+    bool multishot_recv;  // 内核不支持多路接收时退回阻塞recv
+    int ring_fd;
+
+    // 提交队列
+    void *sq_ptr;
+    size_t sq_size;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned sq_entries;
+    void *sqes;
+    size_t sqes_size;
+    unsigned sq_pending;
+
+    // 完成队列
+    void *cq_ptr;
+    size_t cq_size;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    void *cqes;
+
+    // 注册给内核的接收缓存环
+    void *buf_ring;
+    char *buf_base;
+    size_t buf_len;
+    unsigned buf_num;
+
+    // 注册的发送缓存，消息位于其中时使用WRITE_FIXED
+    const SocketMessage *fixed_bufs;
+    unsigned fixed_buf_num;
+
+    std::map<int, uint32_t> fd_generation;  // 防止关闭后复用的fd收到旧事件
+    std::set<int> accept_armed;
+    std::set<int> recv_armed;
+    std::map<int, std::deque<UringCompletion> > accept_queue;
+    std::map<int, std::deque<UringCompletion> > recv_queue;
+    std::map<uint64_t, int> oneshot_result;
+} UringSocket;
+
+int init_uring_socket(UringSocket *ring, const unsigned entries,
+                      const size_t buffer_len, const unsigned buffer_num,
+                      const SocketMessage *fixed_bufs,
+                      const unsigned fixed_buf_num);
+int uring_accept(UringSocket *ring, const int socket_fd);
+int uring_recv(UringSocket *ring, const int accept_fd,
+               const SocketMessage *msg);
+int uring_send(UringSocket *ring, const int socket_fd,
+               const SocketMessage *msg);
+int uring_close(UringSocket *ring, const int socket_fd);
+int close_uring_socket(UringSocket *ring);
+
+#endif  // URING_SOCKET_HPP_